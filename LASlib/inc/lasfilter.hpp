@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- filter a batch of points into a mask with vectorizable criteria
      9 June 2021 -- disallow use of '-keep_class' together with '-keep_extended_class'
      3 April 2021 -- new filter '-keep_profile p1_x p1_y p2_x p2_y width' 
      6 March 2018 -- changed '%g' to '%lf' for all sprintf() of F64 values
@@ -39,6 +40,8 @@
 #include "lasdefinitions.hpp"
 #include "laszip_decompress_selective_v3.hpp"
 
+class LASpointBatch;
+
 class LAScriterion
 {
 public:
@@ -46,6 +49,9 @@ public:
   virtual I32 get_command(CHAR* string) const = 0;
   virtual U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY; };
   virtual BOOL filter(const LASpoint* point) = 0;
+  // sets 'filtered' to 1 or 0 for every point of the batch. returns FALSE for
+  // criteria that need the entire point or that depend on the point order.
+  virtual BOOL filter(const LASpointBatch*, U8*) { return FALSE; };
   virtual void reset(){};
   virtual ~LAScriterion(){};
 };
@@ -67,6 +73,10 @@ public:
   void addKeepScanDirectionChange();
 
   BOOL filter(const LASpoint* point);
+  // evaluates all criteria for the entire batch. on success 'filtered' is 1 for
+  // points that were filtered and 0 for points that survived. returns FALSE if
+  // one of the criteria cannot filter batches. use single points instead then.
+  BOOL filter(const LASpointBatch* batch, U8* filtered);
   void reset();
 
   LASfilter();
@@ -79,6 +89,9 @@ private:
   U32 alloc_criteria;
   LAScriterion** criteria;
   I32* counters;
+  I32* batch_counters;
+  U32 alloc_mask;
+  U8* mask;
 };
 
 #endif
@@ -0,0 +1,279 @@
+/*
+===============================================================================
+
+    FILE:  lasformatter.hpp
+
+    CONTENTS:
+
+        Formats the numbers of the ASCII output of points into one large buffer
+        that is written with few big fwrite() calls. Integers and numbers with
+        a fixed number of decimal digits (the scaled coordinates and the GPS
+        time) are converted by specialized routines that produce exactly the
+        same characters as printf() with "%d" or "%.Nf" but at a fraction of
+        its cost. Everything else falls back to vsnprintf().
+
+    PROGRAMMERS:
+
+        info@rapidlasso.de  -  https://rapidlasso.de
+
+    COPYRIGHT:
+
+        (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+        This is free software; you can redistribute and/or modify it under the
+        terms of the GNU Lesser General Licence as published by the Free Software
+        Foundation. See the LICENSE.txt file for more information.
+
+        This software is distributed WITHOUT ANY WARRANTY and without even the
+        implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    CHANGE HISTORY:
+
+        18 October 2026 -- created for faster ASCII output in las2txt and LASwriterTXT
+        18 October 2026 -- the one lidarprecision2decimals() of las2txt and LASwriterTXT
+
+===============================================================================
+*/
+#ifndef LAS_FORMATTER_HPP
+#define LAS_FORMATTER_HPP
+
+#include "lasdefinitions.hpp"
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// room that must be left in the buffer before formatting a single number
+#define LAS_FORMATTER_MAX_NUMBER 64
+
+// the number of decimal digits that coordinates or attributes with this scale factor need
+inline I32 lidarprecision2decimals(const F64 precision) {
+  if (precision == 0.01)
+    return 2;
+  else if (precision == 0.001)
+    return 3;
+  else if (precision == 0.0001)
+    return 4;
+  else if (precision == 0.1)
+    return 1;
+  else if (precision == 0.00001)
+    return 5;
+  else if (precision == 0.000001)
+    return 6;
+  else if (precision == 0.0000001)
+    return 7;
+  else if (precision == 0.00000001)
+    return 8;
+  else if (precision == 0.000000001)
+    return 9;
+  else if (precision == 0.0025)
+    return 4;
+  else if (precision == 0.00025)
+    return 5;
+  else if (precision == 0.000025)
+    return 6;
+  else if (precision == 0.005)
+    return 3;
+  else if (precision == 0.0005)
+    return 4;
+  else if (precision == 0.00005)
+    return 5;
+  else if (precision == 0.0000000001)
+    return 10;
+  else if (precision == 0.00000000001)
+    return 11;
+  else if (precision == 0.000000000001)
+    return 12;
+  else if (precision == 0.0000000000001)
+    return 13;
+  else if (precision == 0.00000000000001)
+    return 14;
+  else if (precision == 0.000000000000001)
+    return 15;
+  else
+    return -1;  // all digits without trailing zeros
+}
+
+class LASformatter {
+ public:
+  // starts formatting into a new buffer for this file
+  BOOL open(FILE* file, U32 size = LAS_TOOLS_IO_OBUFFER_SIZE) {
+    close();
+    if (size < 4 * LAS_FORMATTER_MAX_NUMBER) size = 4 * LAS_FORMATTER_MAX_NUMBER;
+    buffer = (CHAR*)malloc(size);
+    if (buffer == 0) return FALSE;
+    this->file = file;
+    this->size = size;
+    used = 0;
+    return TRUE;
+  };
+
+  // flushes what is buffered and continues with another file
+  BOOL refile(FILE* file) {
+    BOOL success = flush();
+    this->file = file;
+    return success;
+  };
+
+  // writes the buffered characters to the file
+  BOOL flush() {
+    if (used == 0) return TRUE;
+    BOOL success = (fwrite(buffer, 1, used, file) == used);
+    used = 0;
+    return success;
+  };
+
+  // flushes and frees the buffer but does not close the file
+  BOOL close() {
+    BOOL success = TRUE;
+    if (buffer) {
+      success = flush();
+      free(buffer);
+      buffer = 0;
+    }
+    file = 0;
+    size = 0;
+    return success;
+  };
+
+  inline void put(const CHAR c) {
+    if (used == size) flush();
+    buffer[used++] = c;
+  };
+
+  void put(const CHAR* string) {
+    size_t length = strlen(string);
+    if (length > (size_t)(size - used)) {
+      flush();
+      if (length > size) {
+        fwrite(string, 1, length, file);
+        return;
+      }
+    }
+    memcpy(buffer + used, string, length);
+    used += (U32)length;
+  };
+
+  // like printf("%d") or printf("%lld")
+  inline void put_int(const I64 value) {
+    reserve(LAS_FORMATTER_MAX_NUMBER);
+    if (value < 0) {
+      buffer[used++] = '-';
+      put_digits((U64)0 - (U64)value);
+    } else {
+      put_digits((U64)value);
+    }
+  };
+
+  // like printf("%.Nf") with 'decimals' as N or, if 'decimals' is negative,
+  // like printf("%.15f") without the trailing zeros (and without the decimal
+  // point when all digits after it are zero)
+  inline void put_double(const F64 value, const I32 decimals) {
+    if (decimals < 0) {
+      put_double(value, 15);
+      while (buffer[used - 1] == '0') used--;
+      if (buffer[used - 1] == '.') used--;
+      return;
+    }
+    reserve(LAS_FORMATTER_MAX_NUMBER);
+    if (decimals <= 9) {
+      static const F64 scales[10] = {1.0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+      static const U64 powers[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+      F64 magnitude = fabs(value);
+      F64 high = magnitude * scales[decimals];
+      // up to 2^53 every double is an integer or the rounded product still has a fraction
+      if (high < 9007199254740992.0) {
+        // the exact product is 'high + low' and is rounded like printf() does: to the nearest
+        // integer and with ties to the even one. the rounding error 'low' only matters when
+        // 'high' itself lies exactly half-way between two integers.
+        F64 low = fma(magnitude, scales[decimals], -high);
+        F64 rounded = nearbyint(high);
+        F64 fraction = high - rounded;
+        if ((fraction == 0.5) && (low > 0.0))
+          rounded += 1.0;
+        else if ((fraction == -0.5) && (low < 0.0))
+          rounded -= 1.0;
+        U64 digits = (U64)rounded;
+        if (signbit(value)) buffer[used++] = '-';
+        if (decimals == 0) {
+          put_digits(digits);
+        } else {
+          put_digits(digits / powers[decimals]);
+          buffer[used++] = '.';
+          U64 remainder = digits % powers[decimals];
+          for (I32 i = decimals - 1; i >= 0; i--) {
+            buffer[used + i] = '0' + (CHAR)(remainder % 10);
+            remainder /= 10;
+          }
+          used += decimals;
+        }
+        return;
+      }
+    }
+    printf("%.*f", decimals, value);
+  };
+
+  // like printf("%g")
+  inline void put_g(const F64 value) {
+    // integers with up to six digits are printed without exponent and fraction
+    if ((value > -1000000.0) && (value < 1000000.0) && (value == (F64)(I32)value) && !((value == 0.0) && signbit(value))) {
+      put_int((I32)value);
+    } else {
+      printf("%g", value);
+    }
+  };
+
+  // everything else
+  void printf(const CHAR* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer + used, size - used, format, args);
+    va_end(args);
+    if ((length >= 0) && ((U32)length >= size - used)) {
+      flush();
+      va_start(args, format);
+      if ((U32)length < size)
+        length = vsnprintf(buffer, size, format, args);
+      else
+        length = vfprintf(file, format, args);
+      va_end(args);
+      if ((U32)length >= size) return;
+    }
+    if (length > 0) used += length;
+  };
+
+  LASformatter() {
+    file = 0;
+    buffer = 0;
+    size = 0;
+    used = 0;
+  };
+
+  ~LASformatter() {
+    close();
+  };
+
+ private:
+  FILE* file;
+  CHAR* buffer;
+  U32 size;
+  U32 used;
+
+  inline void reserve(const U32 bytes) {
+    if (size - used < bytes) flush();
+  };
+
+  inline void put_digits(U64 value) {
+    CHAR digits[24];
+    I32 n = 0;
+    do {
+      digits[n++] = '0' + (CHAR)(value % 10);
+      value /= 10;
+    } while (value);
+    while (n) buffer[used++] = digits[--n];
+  };
+};
+
+#endif
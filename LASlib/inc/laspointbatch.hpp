@@ -0,0 +1,238 @@
+/*
+===============================================================================
+
+    FILE:  laspointbatch.hpp
+
+    CONTENTS:
+
+        A caller-owned batch of points stored as structure-of-arrays columns
+        that LASreader::read_points() fills with thousands of points per call
+        so that downstream processing can run in tight (vectorizable) loops.
+
+    PROGRAMMERS:
+
+        info@rapidlasso.de  -  https://rapidlasso.de
+
+    COPYRIGHT:
+
+        (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+        This is free software; you can redistribute and/or modify it under the
+        terms of the GNU Lesser General Licence as published by the Free Software
+        Foundation. See the LICENSE.txt file for more information.
+
+        This software is distributed WITHOUT ANY WARRANTY and without even the
+        implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+    CHANGE HISTORY:
+
+        18 October 2026 -- remove_filtered() compacts the batch after filtering
+        18 October 2026 -- added scan angle column and quantizer for batch filtering
+        18 October 2026 -- created for batch reading of points into columns
+
+===============================================================================
+*/
+#ifndef LAS_POINT_BATCH_HPP
+#define LAS_POINT_BATCH_HPP
+
+#include "lasdefinitions.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+class LASLIB_DLL LASpointBatch {
+ public:
+  // number of points currently in the batch and how many the columns can hold
+  U32 count;
+  U32 capacity;
+
+  // one entry per point. the returns, the classification, and the scan angle
+  // are the extended LAS 1.4 values for the new point types (the scan angle in
+  // 0.006 degree increments) and the legacy values otherwise.
+  I32* X;
+  I32* Y;
+  I32* Z;
+  U16* intensity;
+  U8* return_number;
+  U8* number_of_returns;
+  U8* classification;
+  I16* scan_angle;
+  U8* user_data;
+  U16* point_source_ID;
+
+  // only allocated when the point type has these attributes
+  F64* gps_time;             // one per point
+  U16* rgb;                  // four per point: R, G, B, and NIR (or zero)
+  U8* extra_bytes;           // 'extra_bytes_number' per point
+
+  BOOL extended_point_type;
+  BOOL have_gps_time;
+  BOOL have_rgb;
+  BOOL have_nir;
+  I32 extra_bytes_number;
+
+  // for converting the X, Y, and Z integers to scaled and translated coordinates
+  const LASquantizer* quantizer;
+
+  // (re-)allocates the columns for the attributes of this point type
+  BOOL init(const LASpoint* point, const U32 capacity) {
+    count = 0;
+    quantizer = point->quantizer;
+    if ((capacity <= this->capacity) && (extended_point_type == (BOOL)point->extended_point_type) &&
+        (have_gps_time == point->have_gps_time) && (have_rgb == point->have_rgb) && (have_nir == point->have_nir) &&
+        (extra_bytes_number == point->extra_bytes_number)) {
+      return TRUE;
+    }
+    clean();
+    extended_point_type = point->extended_point_type;
+    have_gps_time = point->have_gps_time;
+    have_rgb = point->have_rgb;
+    have_nir = point->have_nir;
+    extra_bytes_number = point->extra_bytes_number;
+    if (capacity == 0) return TRUE;
+    X = (I32*)malloc(sizeof(I32) * capacity);
+    Y = (I32*)malloc(sizeof(I32) * capacity);
+    Z = (I32*)malloc(sizeof(I32) * capacity);
+    intensity = (U16*)malloc(sizeof(U16) * capacity);
+    return_number = (U8*)malloc(capacity);
+    number_of_returns = (U8*)malloc(capacity);
+    classification = (U8*)malloc(capacity);
+    scan_angle = (I16*)malloc(sizeof(I16) * capacity);
+    user_data = (U8*)malloc(capacity);
+    point_source_ID = (U16*)malloc(sizeof(U16) * capacity);
+    if (!X || !Y || !Z || !intensity || !return_number || !number_of_returns || !classification || !scan_angle || !user_data || !point_source_ID) {
+      clean();
+      return FALSE;
+    }
+    if (have_gps_time) {
+      gps_time = (F64*)malloc(sizeof(F64) * capacity);
+      if (gps_time == 0) {
+        clean();
+        return FALSE;
+      }
+    }
+    if (have_rgb) {
+      rgb = (U16*)malloc(sizeof(U16) * 4 * capacity);
+      if (rgb == 0) {
+        clean();
+        return FALSE;
+      }
+    }
+    if (extra_bytes_number > 0) {
+      extra_bytes = (U8*)malloc((size_t)extra_bytes_number * capacity);
+      if (extra_bytes == 0) {
+        clean();
+        return FALSE;
+      }
+    }
+    this->capacity = capacity;
+    return TRUE;
+  };
+
+  // appends the point. the caller makes sure there is space.
+  inline void add(const LASpoint* point) {
+    U32 i = count;
+    X[i] = point->get_X();
+    Y[i] = point->get_Y();
+    Z[i] = point->get_Z();
+    intensity[i] = point->intensity;
+    if (point->extended_point_type) {
+      return_number[i] = point->extended_return_number;
+      number_of_returns[i] = point->extended_number_of_returns;
+      classification[i] = point->extended_classification;
+      scan_angle[i] = point->extended_scan_angle;
+    } else {
+      return_number[i] = point->return_number;
+      number_of_returns[i] = point->number_of_returns;
+      classification[i] = point->classification;
+      scan_angle[i] = point->scan_angle_rank;
+    }
+    user_data[i] = point->user_data;
+    point_source_ID[i] = point->point_source_ID;
+    if (gps_time) gps_time[i] = point->gps_time;
+    if (rgb) {
+      rgb[4 * i] = point->rgb[0];
+      rgb[4 * i + 1] = point->rgb[1];
+      rgb[4 * i + 2] = point->rgb[2];
+      rgb[4 * i + 3] = (have_nir ? point->rgb[3] : 0);
+    }
+    if (extra_bytes) memcpy(extra_bytes + (size_t)extra_bytes_number * i, point->extra_bytes, extra_bytes_number);
+    count++;
+  };
+
+  // removes the points marked in 'filtered' and keeps the others in their order
+  void remove_filtered(const U8* filtered) {
+    U32 i, j = 0;
+    for (i = 0; i < count; i++) {
+      if (filtered[i]) continue;
+      if (i != j) {
+        X[j] = X[i];
+        Y[j] = Y[i];
+        Z[j] = Z[i];
+        intensity[j] = intensity[i];
+        return_number[j] = return_number[i];
+        number_of_returns[j] = number_of_returns[i];
+        classification[j] = classification[i];
+        scan_angle[j] = scan_angle[i];
+        user_data[j] = user_data[i];
+        point_source_ID[j] = point_source_ID[i];
+        if (gps_time) gps_time[j] = gps_time[i];
+        if (rgb) memcpy(rgb + 4 * j, rgb + 4 * i, 4 * sizeof(U16));
+        if (extra_bytes) memcpy(extra_bytes + (size_t)extra_bytes_number * j, extra_bytes + (size_t)extra_bytes_number * i, extra_bytes_number);
+      }
+      j++;
+    }
+    count = j;
+  };
+
+  void clean() {
+    if (X) free(X);
+    if (Y) free(Y);
+    if (Z) free(Z);
+    if (intensity) free(intensity);
+    if (return_number) free(return_number);
+    if (number_of_returns) free(number_of_returns);
+    if (classification) free(classification);
+    if (scan_angle) free(scan_angle);
+    if (user_data) free(user_data);
+    if (point_source_ID) free(point_source_ID);
+    if (gps_time) free(gps_time);
+    if (rgb) free(rgb);
+    if (extra_bytes) free(extra_bytes);
+    X = Y = Z = 0;
+    intensity = 0;
+    return_number = number_of_returns = classification = user_data = 0;
+    scan_angle = 0;
+    point_source_ID = 0;
+    gps_time = 0;
+    rgb = 0;
+    extra_bytes = 0;
+    count = 0;
+    capacity = 0;
+  };
+
+  LASpointBatch() {
+    X = Y = Z = 0;
+    intensity = 0;
+    return_number = number_of_returns = classification = user_data = 0;
+    scan_angle = 0;
+    point_source_ID = 0;
+    gps_time = 0;
+    rgb = 0;
+    extra_bytes = 0;
+    count = 0;
+    capacity = 0;
+    extended_point_type = FALSE;
+    have_gps_time = FALSE;
+    have_rgb = FALSE;
+    have_nir = FALSE;
+    extra_bytes_number = 0;
+    quantizer = 0;
+  };
+
+  ~LASpointBatch() {
+    clean();
+  };
+};
+
+#endif
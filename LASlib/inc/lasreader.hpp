@@ -25,6 +25,18 @@
 
     CHANGE HISTORY:
 
+        18 October 2026 -- read_points() tells the plain reader apart with flags, not by comparing member function pointers
+        18 October 2026 -- read_points() applies a transform to entire batches when all its operations can
+        18 October 2026 -- read_points() applies a filter to entire batches when all its criteria can
+        18 October 2026 -- combine the layers needed by filter, transform, and tool when opening LAZ
+        18 October 2026 -- added '-ilayer_threads 4' option to decompress the layers of LAS 1.4 LAZ chunks on multiple threads
+        18 October 2026 -- '-ithreads 8' also decodes binary PLY vertices on multiple threads
+        18 October 2026 -- '-ithreads 8' also parses text input on multiple threads
+        18 October 2026 -- added '-icache 512' option to keep decompressed LAZ chunks for seeks
+        18 October 2026 -- added '-mmap' option to read LAS/LAZ files through a memory mapping
+        18 October 2026 -- let readers decompress the chunks of intersected index intervals ahead
+        18 October 2026 -- added read_points() to read a batch of points into columns
+        18 October 2026 -- added '-ithreads 8' option for multi-threaded LAZ decompression
         18 April 2023 -- adding support of COPC spatial index standard
         10 March 2022 -- added '-iptx_transform' option
         31 October 2019 -- adding kdtree of bounding boxes for large number of LAS/LAZ files
@@ -60,6 +72,7 @@
 #include <string>
 
 class LASindex;
+class LASpointBatch;
 class COPCindex;
 class LASfilter;
 class LAStransform;
@@ -152,6 +165,11 @@ class LASLIB_DLL LASreader {
   BOOL read_point() {
     return (this->*read_simple)();
   };
+  // reads up to 'max_count' points into the columns of the batch and returns how many
+  // (zero only at the end). a filter whose criteria can all run on batches is applied
+  // to entire batches at once, so that fewer points may be returned before the end.
+  // so is a transform whose operations all can.
+  U32 read_points(LASpointBatch& batch, const U32 max_count);
 
   inline BOOL ignore_point() {
     return (ignore ? ignore->ignore(&point) : FALSE);
@@ -221,6 +239,9 @@ class LASLIB_DLL LASreader {
 
  protected:
   virtual BOOL read_point_default() = 0;
+  virtual U32 read_points_default(LASpointBatch& batch, const U32 max_count);
+  // called when the spatial or COPC index has selected the intervals that will be read (or none)
+  virtual void prefetch_intervals(const BOOL intersected) {};
 
   LASindex* index;
   COPCindex* copc_index;
@@ -243,12 +264,20 @@ class LASLIB_DLL LASreader {
  private:
   BOOL (LASreader::*read_simple)();
   BOOL (LASreader::*read_complex)();
+  // whether read_simple and read_complex are read_point_default() (which comparing
+  // pointers to virtual member functions cannot tell reliably)
+  BOOL read_simple_default;
+  BOOL read_complex_default;
 
   BOOL read_point_none();
   BOOL read_point_filtered();
   BOOL read_point_transformed();
   BOOL read_point_filtered_and_transformed();
 
+  U32 read_points_filtered(LASpointBatch& batch, const U32 max_count);
+  U8* batch_filtered;
+  U32 batch_filtered_alloc;
+
   BOOL read_point_inside_tile();
   BOOL read_point_inside_tile_indexed();
   BOOL read_point_inside_circle();
@@ -272,6 +301,22 @@ class LASLIB_DLL LASreadOpener {
   inline U32 get_io_ibuffer_size() const {
     return io_ibuffer_size;
   };
+  void set_decompress_threads(const U32 decompress_threads);
+  inline U32 get_decompress_threads() const {
+    return decompress_threads;
+  };
+  void set_decompress_layer_threads(const U32 decompress_layer_threads);
+  inline U32 get_decompress_layer_threads() const {
+    return decompress_layer_threads;
+  };
+  void set_mmap(const BOOL mmap);
+  inline BOOL get_mmap() const {
+    return mmap;
+  };
+  void set_chunk_cache_size(const U32 chunk_cache_size);
+  inline U32 get_chunk_cache_size() const {
+    return chunk_cache_size;
+  };
   U32 get_file_name_number() const;
   U32 get_file_name_current() const;
   const CHAR* get_file_name() const;
@@ -352,6 +397,8 @@ class LASLIB_DLL LASreadOpener {
   const CHAR* get_parse_string() const;
   void usage() const;
   void set_decompress_selective(U32 decompress_selective);
+  U32 get_decompress_selective() const;
+  static U32 get_decompress_selective_for_point_type(const U8 point_type);
   void set_inside_tile(const F32 ll_x, const F32 ll_y, const F32 size);
   void set_inside_circle(const F64 center_x, const F64 center_y, const F64 radius);
   void set_inside_rectangle(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y);
@@ -427,6 +474,10 @@ class LASLIB_DLL LASreadOpener {
   BOOL add_file_name(const CHAR* file_name, U32 ID, BOOL unique);
   BOOL add_file_name(const CHAR* file_name, U32 ID, I64 npoints, F64 min_x, F64 min_y, F64 max_x, F64 max_y, BOOL unique = FALSE);
   U32 io_ibuffer_size;
+  U32 decompress_threads;
+  U32 decompress_layer_threads;
+  BOOL mmap;
+  U32 chunk_cache_size;
   const CHAR* file_name;
   BOOL merged;
   BOOL stored;
@@ -493,7 +544,8 @@ class LASLIB_DLL LASreadOpener {
   LAStransform* transform;
   LASignore* ignore;
 
-  // optional selective decompression (compressed new LAS 1.4 point types only)
+  // optional selective decompression (compressed new LAS 1.4 point types only). what the
+  // tool declared is combined with what the filter, transform, and ignore need when opening
   U32 decompress_selective;
 
   // optional area-of-interest query (spatially indexed)
@@ -24,6 +24,13 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- optionally decompress the layers of LAS 1.4 chunks on several threads
+    18 October 2026 -- optionally cache decompressed chunks via LASreadOpener
+    18 October 2026 -- decompress the octants selected by COPC queries ahead in stream order
+    18 October 2026 -- optional reading through a memory mapping via LASreadOpener
+    18 October 2026 -- decompress only the chunks of intersected index intervals ahead
+    18 October 2026 -- read_points() decodes batches without per-point dispatch
+    18 October 2026 -- optional multi-threaded decompression via LASreadOpener
     9 November 2022 -- support of COPC VLR and EVLR
     13 June 2022 -- support unicode filenames
     10 July 2018 -- user must set seek-ability of istream (hard to determine) 
@@ -80,6 +87,8 @@ public:
 
 protected:
   virtual BOOL read_point_default();
+  virtual U32 read_points_default(LASpointBatch& batch, const U32 max_count);
+  virtual void prefetch_intervals(const BOOL intersected);
 
 private:
   FILE* file;
@@ -99,6 +108,7 @@ public:
 protected:
   virtual BOOL open(ByteStreamIn* stream, BOOL peek_only=FALSE, U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL);
   virtual BOOL read_point_default();
+  virtual U32 read_points_default(LASpointBatch& batch, const U32 max_count);
   BOOL rescale_x, rescale_y, rescale_z;
   BOOL check_for_overflow;
   F64 scale_factor[3];
@@ -114,6 +124,7 @@ public:
 protected:
   virtual BOOL open(ByteStreamIn* stream, BOOL peek_only=FALSE, U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL);
   virtual BOOL read_point_default();
+  virtual U32 read_points_default(LASpointBatch& batch, const U32 max_count);
   BOOL auto_reoffset;
   BOOL reoffset_x, reoffset_y, reoffset_z;
   F64 offset[3] = {0};
@@ -129,6 +140,7 @@ public:
 protected:
   BOOL open(ByteStreamIn* stream, BOOL peek_only=FALSE, U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL);
   BOOL read_point_default();
+  U32 read_points_default(LASpointBatch& batch, const U32 max_count);
 };
 
 #endif
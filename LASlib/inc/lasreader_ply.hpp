@@ -24,6 +24,8 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- warnings of the decoding threads are emitted in the order of the vertices
+    18 October 2026 -- reading binary vertices in blocks that are decoded on multiple threads
     9 May 2020 -- added silly 'obj_info' used by Cloud Compare
     4 September 2018 -- created after returning to Samara with locks changed
   
@@ -36,6 +38,9 @@
 
 #include <stdio.h>
 
+class LASreaderPLYthreads;
+class LASreaderPLYblock;
+
 class LASreaderPLY : public LASreader
 {
 public:
@@ -44,6 +49,7 @@ public:
   void set_scale_intensity(F32 scale_intensity);
   void set_scale_factor(const F64* scale_factor);
   void set_offset(const F64* offset);
+  void set_threads(U32 num_threads);
   void add_attribute(I32 data_type, const CHAR* name, const CHAR* description=0, F64 scale=1.0, F64 offset=0.0, F64 pre_scale=1.0, F64 pre_offset=0.0, F64 no_data=F64_MAX);
   virtual BOOL open(const CHAR* file_name, U8 point_type=0, BOOL populate_header=FALSE);
   virtual BOOL open(FILE* file, const CHAR* file_name=0, U8 point_type=0, BOOL populate_header=FALSE);
@@ -86,12 +92,32 @@ private:
   F64 attribute_no_datas[32];
   F64 orig_x_offset, orig_y_offset, orig_z_offset;
   F64 orig_x_scale_factor, orig_y_scale_factor, orig_z_scale_factor;
+  // fixed layout of the little endian binary vertices that are read in blocks
+  U32 binary_record_size;
+  U16 binary_offsets[64];
+  I64 binary_remaining;
+  U32 binary_block_vertices;
+  U32 binary_block_count;
+  U32 binary_block_next;
+  U8* binary_block;
+  U32 num_threads;
+  LASreaderPLYthreads* threads;
   BOOL parse_header();
   BOOL set_attribute(I32 index, F64 value);
   BOOL parse_attribute(const CHAR* l, I32 index);
   BOOL parse(const CHAR* parse_string);
   F64 read_binary_value(CHAR type);
   BOOL read_binary_point();
+  BOOL init_binary_layout();
+  U32 read_binary_block(U8* block);
+  BOOL decode_binary_point(const U8* record);
+  BOOL start_threads();
+  void stop_threads();
+  BOOL read_threaded();
+  void decode_blocks(LASreaderPLY* decoder);
+  BOOL init_decoder(const LASreaderPLY* reader);
+  LASreaderPLYblock* decoding;
+  void message(LAS_MESSAGE_TYPE type, LAS_FORMAT_STRING(const CHAR*) fmt, ...);
   void populate_scale_and_offset();
   void populate_bounding_box();
   void clean();
@@ -24,6 +24,9 @@
 
   CHANGE HISTORY:
 
+   18 October 2026 -- warnings of the parsing threads are emitted in the order of the lines
+   18 October 2026 -- parsing large text files on multiple threads with '-ithreads 8'
+   18 October 2026 -- reading lines from large blocks and parsing numbers without sscanf()
    10 March 2022 -- added '-iptx_transform' option
     7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
    22 July 2018 -- bug fix for parsing classfication to point type 6 (or higher)
@@ -42,6 +45,9 @@
 
 #include <stdio.h>
 
+class LASreaderTXTthreads;
+class LASreaderTXTblock;
+
 class LASreaderTXT : public LASreader
 {
 public:
@@ -56,6 +62,7 @@ public:
   void set_scale_scan_angle(F32 scale_scan_angle);
   void set_scale_factor(const F64* scale_factor);
   void set_offset(const F64* offset);
+  void set_threads(U32 num_threads);
   void add_attribute(I32 data_type, const CHAR* name, const CHAR* description = 0, F64 scale = 1.0, F64 offset = 0.0, F64 pre_scale = 1.0, F64 pre_offset = 0.0, F64 no_data = F64_MAX);
   virtual BOOL open(const CHAR* file_name, U8 point_type = 0, const CHAR* parse_string = 0, I32 skip_lines = 0, BOOL populate_header = FALSE);
   virtual BOOL open(FILE* file, const CHAR* file_name = 0, U8 point_type = 0, const CHAR* parse_string = 0, I32 skip_lines = 0, BOOL populate_header = FALSE);
@@ -91,6 +98,19 @@ private:
   bool piped;
   const char* lptr;
   CHAR line[512];
+  CHAR* block;
+  U32 block_start;
+  U32 block_end;
+  BOOL get_line();
+  U32 num_threads;
+  LASreaderTXTthreads* threads;
+  BOOL start_threads(const CHAR* parse_string, BOOL populate);
+  void stop_threads();
+  BOOL read_threaded();
+  void parse_blocks(LASreaderTXT* parser);
+  BOOL init_parser(const LASreaderTXT* reader);
+  LASreaderTXTblock* parsing;
+  void message(LAS_MESSAGE_TYPE type, LAS_FORMAT_STRING(const CHAR*) fmt, ...);
   I32 number_attributes;
   I32 attributes_data_types[32];
   const CHAR* attribute_names[32];
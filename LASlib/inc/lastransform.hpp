@@ -24,6 +24,7 @@
 
 	CHANGE HISTORY:
 
+		18 October 2026 -- transform a columnar LASpointBatch with vectorizable operations
 		10 March 2022 -- added TransformMatrix operation
 		18 November 2021 -- new '-forceRGB' to use RGB values also in non-RGB point versions
 		15 June 2021 -- new '-clamp_RGB_to_8bit' transform useful to avoid 8 bit overflow
@@ -49,6 +50,7 @@
 
 class LASfilter;
 class LASreader;
+class LASpointBatch;
 
 struct LASTransformMatrix {
 	F64 r11;
@@ -76,6 +78,9 @@ public:
   inline void set_header(LASheader& header){ this->header = &header; };
   virtual F64* transform_coords_for_offset_adjustment(F64 x, F64 y, F64 z) = 0;
 	virtual void transform(LASpoint* point) = 0;
+	// operations with a kernel for the columns of a batch override these two
+	virtual BOOL can_transform(const LASpointBatch*) const { return FALSE; };
+	virtual void transform(LASpointBatch*) {};
 	virtual void reset() { overflow = 0; };
 	inline void set_offset_adjust(BOOL offset_adjust) { this->offset_adjust = offset_adjust; };
   void set_origins(F64 orig_x_offset, F64 orig_y_offset, F64 orig_z_offset, F64 orig_x_scale_factor, F64 orig_y_scale_factor, F64 orig_z_scale_factor);
@@ -168,6 +173,8 @@ public:
       }
     }
 	};
+	BOOL can_transform(const LASpointBatch* batch) const;
+	void transform(LASpointBatch* batch);
 	LASoperationTransformMatrix(F64 r11, F64 r12, F64 r13, F64 r21, F64 r22, F64 r23, F64 r31, F64 r32, F64 r33, F64 tr1, F64 tr2, F64 tr3)
 	{
 		this->r11 = r11; this->r12 = r12; this->r13 = r13;
@@ -260,6 +267,11 @@ public:
 
 	void transform(LASpoint* point);
 
+	// transforms all points of the batch in place. returns FALSE without
+	// touching the batch if the transform is filtered or one of its operations
+	// has no batch kernel so that the caller falls back to transform(point).
+	BOOL transform(LASpointBatch* batch);
+
 	void check_for_overflow() const;
 
 	void reset();
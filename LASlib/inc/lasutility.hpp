@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- LAShistogram reports which LAZ layers its bins need
     27 August 2017 -- added '-histo scanner_channel 1'
      1 June 2017 -- improved "fluff" detection
      3 May 2015 -- updated LASinventory to handle LAS 1.4 content 
@@ -137,6 +138,7 @@ public:
   BOOL histo(const CHAR* name, F64 step);
   BOOL histo_avg(const CHAR* name, F64 step, const CHAR* name_avg);
   void add(const LASpoint* point);
+  U32 get_decompress_selective() const;
   void report(FILE* file) const;
   void reset();
   LAShistogram();
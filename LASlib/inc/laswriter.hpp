@@ -25,6 +25,8 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- add get_chunk_table() so copc writers need not tell() after every chunk
+    18 October 2026 -- added '-othreads 8' option for multi-threaded LAZ compression
     14 June 2023 -- add tell() to the writers to be able to write copc files
     7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
     17 August 2017 -- switch on "native LAS 1.4 extension". turns off with '-no_native'.
@@ -64,6 +66,7 @@ public:
   virtual BOOL update_header(const LASheader* header, BOOL use_inventory=FALSE, BOOL update_extra_bytes=FALSE) = 0;
   virtual I64 close(BOOL update_npoints=TRUE) = 0;
   virtual I64 tell() { return 0; };
+  virtual BOOL get_chunk_table(U32* number_chunks, const U32** chunk_bytes) { return FALSE; };
 
   void dealloc();
 
@@ -87,6 +90,8 @@ public:
   BOOL set_format(const CHAR* format);
   void set_force(BOOL force);
   void set_chunk_size(U32 chunk_size);
+  void set_compress_threads(U32 compress_threads);
+  inline U32 get_compress_threads() const { return compress_threads; };
   void make_numbered_file_name(const CHAR* file_name, I32 digits);
   void make_file_name(const CHAR* file_name, I32 file_number=-1);
   const CHAR* get_directory() const;
@@ -131,6 +136,7 @@ private:
   BOOL force;
   BOOL native;
   U32 chunk_size;
+  U32 compress_threads;
   BOOL use_stdout;
   BOOL use_nil;
 };
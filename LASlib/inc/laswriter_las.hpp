@@ -23,6 +23,8 @@
     implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
   CHANGE HISTORY:
+    18 October 2026 -- get_chunk_table() reports the byte sizes of the LAZ chunks written
+    18 October 2026 -- optionally compress the chunks of LAZ output on multiple threads
     04 August 2023 -- set default of VLR header "reserved" to 0 instead of 0xAABB
     29 March 2017 -- read and write support "native LAS 1.4 extension" for LASzip
     23 October 2016 -- support writing Extended Variable Length Records (ELVRs)
@@ -61,6 +63,7 @@ public:
 
   BOOL refile(FILE* file);
   void set_delete_stream(BOOL delete_stream=TRUE) { this->delete_stream = delete_stream; };
+  void set_compress_threads(U32 compress_threads) { this->compress_threads = compress_threads; };
 
   BOOL open(const LASheader* header, U32 compressor=LASZIP_COMPRESSOR_NONE, I32 requested_version=0, I32 chunk_size=50000);
   BOOL open(const char* file_name, const LASheader* header, U32 compressor=LASZIP_COMPRESSOR_NONE, I32 requested_version=0, I32 chunk_size=50000, I32 io_buffer_size=LAS_TOOLS_IO_OBUFFER_SIZE);
@@ -74,6 +77,7 @@ public:
   BOOL update_header(const LASheader* header, BOOL use_inventory=FALSE, BOOL update_extra_bytes=FALSE);
   I64 close(BOOL update_npoints=TRUE);
   I64 tell();
+  BOOL get_chunk_table(U32* number_chunks, const U32** chunk_bytes);
 
   LASwriterLAS();
   ~LASwriterLAS();
@@ -82,6 +86,7 @@ private:
   FILE* file;
   ByteStreamOut* stream;
   BOOL delete_stream;
+  U32 compress_threads;
   LASwritePoint* writer;
   I64 header_start_position;
   BOOL writing_las_1_4;
@@ -24,6 +24,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- format points into a large buffer instead of calling fprintf() per field
      7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
     10 April 2011 -- created after a sunny weekend of biking to/from Buergel
 
@@ -33,6 +34,7 @@
 #define LAS_WRITER_TXT_HPP
 
 #include "laswriter.hpp"
+#include "lasformatter.hpp"
 
 #include <stdio.h>
 
@@ -67,6 +69,10 @@ private:
   BOOL optx;
   F32 scale_rgb;
   CHAR separator_sign;
+  LASformatter formatter;
+  I32 x_decimals;
+  I32 y_decimals;
+  I32 z_decimals;
   CHAR printstring[512] = {0};
   I32 attribute_starts[10] = {0};
   BOOL check_parse_string(const CHAR* parse_string);
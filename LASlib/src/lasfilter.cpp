@@ -30,6 +30,7 @@
 */
 #include "lasfilter.hpp"
 #include "lasmessage.hpp"
+#include "laspointbatch.hpp"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -84,6 +85,124 @@ BOOL rangeValidate(const CHAR* argv, T* is1, T* is2, T min, T max)
   return TRUE;
 }
 
+// the batch columns hold the extended values of the new LAS 1.4 point types
+// but the single point criteria look at the legacy values that are derived
+// from them while reading. these give the batch criteria the same results.
+static inline U8 legacy_return_number(const U8 return_number, const U8 number_of_returns)
+{
+  if (number_of_returns > 7) return (return_number > 6 ? (return_number >= number_of_returns ? 7 : 6) : return_number);
+  return (return_number & 7);
+}
+
+static inline U8 legacy_number_of_returns(const U8 number_of_returns)
+{
+  return (number_of_returns > 7 ? 7 : number_of_returns);
+}
+
+static inline I32 legacy_scan_angle_rank(const I16 scan_angle)
+{
+  return I8_CLAMP(I16_QUANTIZE(0.006f*scan_angle));
+}
+
+// the return criteria decide with the legacy return number r and number of returns n
+template <typename Criterion>
+static inline BOOL filter_returns(const LASpointBatch* batch, U8* filtered, Criterion criterion)
+{
+  const U8* return_number = batch->return_number;
+  const U8* number_of_returns = batch->number_of_returns;
+  for (U32 j = 0; j < batch->count; j++)
+  {
+    filtered[j] = (criterion(legacy_return_number(return_number[j], number_of_returns[j]), legacy_number_of_returns(number_of_returns[j])) ? 1 : 0);
+  }
+  return TRUE;
+}
+
+// the integer criteria decide with the values of one column of the batch
+template <typename Criterion>
+static inline BOOL filter_column(const LASpointBatch* batch, U8* filtered, const I32* column, Criterion criterion)
+{
+  for (U32 j = 0; j < batch->count; j++)
+  {
+    filtered[j] = (criterion(column[j]) ? 1 : 0);
+  }
+  return TRUE;
+}
+
+template <typename Criterion>
+static inline BOOL filter_XY(const LASpointBatch* batch, U8* filtered, Criterion criterion)
+{
+  const I32* X = batch->X;
+  const I32* Y = batch->Y;
+  for (U32 j = 0; j < batch->count; j++)
+  {
+    filtered[j] = (criterion(X[j], Y[j]) ? 1 : 0);
+  }
+  return TRUE;
+}
+
+// the coordinate criteria decide with the coordinates x, y, and z that the quantizer of
+// the batch computes from the integers X, Y, and Z (and without one they cannot decide)
+template <typename Criterion>
+static inline BOOL filter_x(const LASpointBatch* batch, U8* filtered, Criterion criterion)
+{
+  if (batch->quantizer == 0) return FALSE;
+  const F64 scale_x = batch->quantizer->x_scale_factor;
+  const F64 offset_x = batch->quantizer->x_offset;
+  return filter_column(batch, filtered, batch->X, [&](I32 X) { return criterion(scale_x*X + offset_x); });
+}
+
+template <typename Criterion>
+static inline BOOL filter_y(const LASpointBatch* batch, U8* filtered, Criterion criterion)
+{
+  if (batch->quantizer == 0) return FALSE;
+  const F64 scale_y = batch->quantizer->y_scale_factor;
+  const F64 offset_y = batch->quantizer->y_offset;
+  return filter_column(batch, filtered, batch->Y, [&](I32 Y) { return criterion(scale_y*Y + offset_y); });
+}
+
+template <typename Criterion>
+static inline BOOL filter_z(const LASpointBatch* batch, U8* filtered, Criterion criterion)
+{
+  if (batch->quantizer == 0) return FALSE;
+  const F64 scale_z = batch->quantizer->z_scale_factor;
+  const F64 offset_z = batch->quantizer->z_offset;
+  return filter_column(batch, filtered, batch->Z, [&](I32 Z) { return criterion(scale_z*Z + offset_z); });
+}
+
+template <typename Criterion>
+static inline BOOL filter_xy(const LASpointBatch* batch, U8* filtered, Criterion criterion)
+{
+  if (batch->quantizer == 0) return FALSE;
+  const F64 scale_x = batch->quantizer->x_scale_factor;
+  const F64 offset_x = batch->quantizer->x_offset;
+  const F64 scale_y = batch->quantizer->y_scale_factor;
+  const F64 offset_y = batch->quantizer->y_offset;
+  return filter_XY(batch, filtered, [&](I32 X, I32 Y) { return criterion(scale_x*X + offset_x, scale_y*Y + offset_y); });
+}
+
+template <typename Criterion>
+static inline BOOL filter_xyz(const LASpointBatch* batch, U8* filtered, Criterion criterion)
+{
+  if (batch->quantizer == 0) return FALSE;
+  const F64 scale_x = batch->quantizer->x_scale_factor;
+  const F64 offset_x = batch->quantizer->x_offset;
+  const F64 scale_y = batch->quantizer->y_scale_factor;
+  const F64 offset_y = batch->quantizer->y_offset;
+  const F64 scale_z = batch->quantizer->z_scale_factor;
+  const F64 offset_z = batch->quantizer->z_offset;
+  const I32* X = batch->X;
+  const I32* Y = batch->Y;
+  const I32* Z = batch->Z;
+  for (U32 j = 0; j < batch->count; j++)
+  {
+    F64 x = scale_x*X[j] + offset_x;
+    F64 y = scale_y*Y[j] + offset_y;
+    F64 z = scale_z*Z[j] + offset_z;
+    filtered[j] = (criterion(x, y, z) ? 1 : 0);
+  }
+  return TRUE;
+}
+
 class LAScriterionAnd : public LAScriterion
 {
 public:
@@ -139,6 +258,10 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf %lf %lf %lf %lf ", name(), min_x, min_y, min_z, max_x, max_y, max_z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY | LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (!point->inside_box(min_x, min_y, min_z, max_x, max_y, max_z)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_xyz(batch, filtered, [this](F64 x, F64 y, F64 z) { return ((x < min_x) | (x >= max_x) | (y < min_y) | (y >= max_y) | (z < min_z) | (z >= max_z)); });
+  };
   LAScriterionKeepxyz(F64 min_x, F64 min_y, F64 min_z, F64 max_x, F64 max_y, F64 max_z) { this->min_x = min_x; this->min_y = min_y; this->min_z = min_z; this->max_x = max_x; this->max_y = max_y; this->max_z = max_z; };
 private:
   F64 min_x, min_y, min_z, max_x, max_y, max_z;
@@ -216,6 +339,10 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf %lf %lf %lf %lf ", name(), min_x, min_y, min_z, max_x, max_y, max_z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY | LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->inside_box(min_x, min_y, min_z, max_x, max_y, max_z)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_xyz(batch, filtered, [this](F64 x, F64 y, F64 z) { return ((min_x <= x) & (x < max_x) & (min_y <= y) & (y < max_y) & (min_z <= z) & (z < max_z)); });
+  };
   LAScriterionDropxyz(F64 min_x, F64 min_y, F64 min_z, F64 max_x, F64 max_y, F64 max_z) { this->min_x = min_x; this->min_y = min_y; this->min_z = min_z; this->max_x = max_x; this->max_y = max_y; this->max_z = max_z; };
 private:
   F64 min_x, min_y, min_z, max_x, max_y, max_z;
@@ -227,6 +354,10 @@ public:
   inline const CHAR* name() const { return "keep_xy"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf %lf %lf ", name(), below_x, below_y, above_x, above_y); };
   inline BOOL filter(const LASpoint* point) { return (!point->inside_rectangle(below_x, below_y, above_x, above_y)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_xy(batch, filtered, [this](F64 x, F64 y) { return ((x < below_x) | (x >= above_x) | (y < below_y) | (y >= above_y)); });
+  };
   LAScriterionKeepxy(F64 below_x, F64 below_y, F64 above_x, F64 above_y) { this->below_x = below_x; this->below_y = below_y; this->above_x = above_x; this->above_y = above_y; };
 private:
   F64 below_x, below_y, above_x, above_y;
@@ -238,6 +369,10 @@ public:
   inline const CHAR* name() const { return "drop_xy"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf %lf %lf ", name(), below_x, below_y, above_x, above_y); };
   inline BOOL filter(const LASpoint* point) { return (point->inside_rectangle(below_x, below_y, above_x, above_y)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_xy(batch, filtered, [this](F64 x, F64 y) { return ((below_x <= x) & (x < above_x) & (below_y <= y) & (y < above_y)); });
+  };
   LAScriterionDropxy(F64 below_x, F64 below_y, F64 above_x, F64 above_y) { this->below_x = below_x; this->below_y = below_y; this->above_x = above_x; this->above_y = above_y; };
 private:
   F64 below_x, below_y, above_x, above_y;
@@ -249,6 +384,10 @@ public:
   inline const CHAR* name() const { return "keep_x"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_x, above_x); };
   inline BOOL filter(const LASpoint* point) { F64 x = point->get_x(); return (x < below_x) || (x >= above_x); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_x(batch, filtered, [this](F64 x) { return ((x < below_x) | (x >= above_x)); });
+  };
   LAScriterionKeepx(F64 below_x, F64 above_x) { this->below_x = below_x; this->above_x = above_x; };
 private:
   F64 below_x, above_x;
@@ -260,6 +399,10 @@ public:
   inline const CHAR* name() const { return "drop_x"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_x, above_x); };
   inline BOOL filter(const LASpoint* point) { F64 x = point->get_x(); return ((below_x <= x) && (x < above_x)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_x(batch, filtered, [this](F64 x) { return ((below_x <= x) & (x < above_x)); });
+  };
   LAScriterionDropx(F64 below_x, F64 above_x) { this->below_x = below_x; this->above_x = above_x; };
 private:
   F64 below_x, above_x;
@@ -271,6 +414,10 @@ public:
   inline const CHAR* name() const { return "keep_y"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_y, above_y); };
   inline BOOL filter(const LASpoint* point) { F64 y = point->get_y(); return (y < below_y) || (y >= above_y); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_y(batch, filtered, [this](F64 y) { return ((y < below_y) | (y >= above_y)); });
+  };
   LAScriterionKeepy(F64 below_y, F64 above_y) { this->below_y = below_y; this->above_y = above_y; };
 private:
   F64 below_y, above_y;
@@ -282,6 +429,10 @@ public:
   inline const CHAR* name() const { return "drop_y"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_y, above_y); };
   inline BOOL filter(const LASpoint* point) { F64 y = point->get_y(); return ((below_y <= y) && (y < above_y)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_y(batch, filtered, [this](F64 y) { return ((below_y <= y) & (y < above_y)); });
+  };
   LAScriterionDropy(F64 below_y, F64 above_y) { this->below_y = below_y; this->above_y = above_y; };
 private:
   F64 below_y, above_y;
@@ -294,6 +445,10 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_z, above_z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { F64 z = point->get_z(); return (z < below_z) || (z >= above_z); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_z(batch, filtered, [this](F64 z) { return ((z < below_z) | (z >= above_z)); });
+  };
   LAScriterionKeepz(F64 below_z, F64 above_z) { this->below_z = below_z; this->above_z = above_z; };
 private:
   F64 below_z, above_z;
@@ -306,6 +461,10 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_z, above_z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { F64 z = point->get_z(); return ((below_z <= z) && (z < above_z)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_z(batch, filtered, [this](F64 z) { return ((below_z <= z) & (z < above_z)); });
+  };
   LAScriterionDropz(F64 below_z, F64 above_z) { this->below_z = below_z; this->above_z = above_z; };
 private:
   F64 below_z, above_z;
@@ -317,6 +476,10 @@ public:
   inline const CHAR* name() const { return "drop_x_below"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), below_x); };
   inline BOOL filter(const LASpoint* point) { return (point->get_x() < below_x); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_x(batch, filtered, [this](F64 x) { return (x < below_x); });
+  };
   LAScriterionDropxBelow(F64 below_x) { this->below_x = below_x; };
 private:
   F64 below_x;
@@ -328,6 +491,10 @@ public:
   inline const CHAR* name() const { return "drop_x_above"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), above_x); };
   inline BOOL filter(const LASpoint* point) { return (point->get_x() >= above_x); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_x(batch, filtered, [this](F64 x) { return (x >= above_x); });
+  };
   LAScriterionDropxAbove(F64 above_x) { this->above_x = above_x; };
 private:
   F64 above_x;
@@ -339,6 +506,10 @@ public:
   inline const CHAR* name() const { return "drop_y_below"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), below_y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_y() < below_y); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_y(batch, filtered, [this](F64 y) { return (y < below_y); });
+  };
   LAScriterionDropyBelow(F64 below_y) { this->below_y = below_y; };
 private:
   F64 below_y;
@@ -350,6 +521,10 @@ public:
   inline const CHAR* name() const { return "drop_y_above"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), above_y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_y() >= above_y); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_y(batch, filtered, [this](F64 y) { return (y >= above_y); });
+  };
   LAScriterionDropyAbove(F64 above_y) { this->above_y = above_y; };
 private:
   F64 above_y;
@@ -362,6 +537,10 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), below_z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->get_z() < below_z); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_z(batch, filtered, [this](F64 z) { return (z < below_z); });
+  };
   LAScriterionDropzBelow(F64 below_z) { this->below_z = below_z; };
 private:
   F64 below_z;
@@ -374,6 +553,10 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), above_z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->get_z() >= above_z); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_z(batch, filtered, [this](F64 z) { return (z >= above_z); });
+  };
   LAScriterionDropzAbove(F64 above_z) { this->above_z = above_z; };
 private:
   F64 above_z;
@@ -385,6 +568,10 @@ public:
   inline const CHAR* name() const { return "keep_XY"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d %d %d ", name(), below_X, below_Y, above_X, above_Y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_X() < below_X) || (point->get_Y() < below_Y) || (point->get_X() >= above_X) || (point->get_Y() >= above_Y); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_XY(batch, filtered, [this](I32 X, I32 Y) { return ((X < below_X) | (Y < below_Y) | (X >= above_X) | (Y >= above_Y)); });
+  };
   LAScriterionKeepXY(I32 below_X, I32 below_Y, I32 above_X, I32 above_Y) { this->below_X = below_X; this->below_Y = below_Y; this->above_X = above_X; this->above_Y = above_Y; };
 private:
   I32 below_X, below_Y, above_X, above_Y;
@@ -396,6 +583,10 @@ public:
   inline const CHAR* name() const { return "keep_X"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_X, above_X); };
   inline BOOL filter(const LASpoint* point) { return (point->get_X() < below_X) || (above_X <= point->get_X()); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_column(batch, filtered, batch->X, [this](I32 X) { return ((X < below_X) | (above_X <= X)); });
+  };
   LAScriterionKeepX(I32 below_X, I32 above_X) { this->below_X = below_X; this->above_X = above_X; };
 private:
   I32 below_X, above_X;
@@ -407,6 +598,10 @@ public:
   inline const CHAR* name() const { return "drop_X"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_X, above_X); };
   inline BOOL filter(const LASpoint* point) { return ((below_X <= point->get_X()) && (point->get_X() < above_X)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_column(batch, filtered, batch->X, [this](I32 X) { return ((below_X <= X) & (X < above_X)); });
+  };
   LAScriterionDropX(I32 below_X, I32 above_X) { this->below_X = below_X; this->above_X = above_X; };
 private:
   I32 below_X;
@@ -419,6 +614,10 @@ public:
   inline const CHAR* name() const { return "keep_Y"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_Y, above_Y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_Y() < below_Y) || (above_Y <= point->get_Y()); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_column(batch, filtered, batch->Y, [this](I32 Y) { return ((Y < below_Y) | (above_Y <= Y)); });
+  };
   LAScriterionKeepY(I32 below_Y, I32 above_Y) { this->below_Y = below_Y; this->above_Y = above_Y; };
 private:
   I32 below_Y, above_Y;
@@ -430,6 +629,10 @@ public:
   inline const CHAR* name() const { return "drop_Y"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_Y, above_Y); };
   inline BOOL filter(const LASpoint* point) { return ((below_Y <= point->get_Y()) && (point->get_Y() < above_Y)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_column(batch, filtered, batch->Y, [this](I32 Y) { return ((below_Y <= Y) & (Y < above_Y)); });
+  };
   LAScriterionDropY(I32 below_Y, I32 above_Y) { this->below_Y = below_Y; this->above_Y = above_Y; };
 private:
   I32 below_Y;
@@ -443,6 +646,10 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_Z, above_Z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->get_Z() < below_Z) || (above_Z <= point->get_Z()); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_column(batch, filtered, batch->Z, [this](I32 Z) { return ((Z < below_Z) | (above_Z <= Z)); });
+  };
   LAScriterionKeepZ(I32 below_Z, I32 above_Z) { this->below_Z = below_Z; this->above_Z = above_Z; };
 private:
   I32 below_Z, above_Z;
@@ -455,6 +662,10 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_Z, above_Z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return ((below_Z <= point->get_Z()) && (point->get_Z() < above_Z)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_column(batch, filtered, batch->Z, [this](I32 Z) { return ((below_Z <= Z) & (Z < above_Z)); });
+  };
   LAScriterionDropZ(I32 below_Z, I32 above_Z) { this->below_Z = below_Z; this->above_Z = above_Z; };
 private:
   I32 below_Z;
@@ -467,6 +678,10 @@ public:
   inline const CHAR* name() const { return "drop_X_below"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_X); };
   inline BOOL filter(const LASpoint* point) { return (point->get_X() < below_X); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_column(batch, filtered, batch->X, [this](I32 X) { return (X < below_X); });
+  };
   LAScriterionDropXBelow(I32 below_X) { this->below_X = below_X; };
 private:
   I32 below_X;
@@ -478,6 +693,10 @@ public:
   inline const CHAR* name() const { return "drop_X_above"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_X); };
   inline BOOL filter(const LASpoint* point) { return (point->get_X() >= above_X); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_column(batch, filtered, batch->X, [this](I32 X) { return (X >= above_X); });
+  };
   LAScriterionDropXAbove(I32 above_X) { this->above_X = above_X; };
 private:
   I32 above_X;
@@ -489,6 +708,10 @@ public:
   inline const CHAR* name() const { return "drop_Y_below"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_Y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_Y() < below_Y); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_column(batch, filtered, batch->Y, [this](I32 Y) { return (Y < below_Y); });
+  };
   LAScriterionDropYBelow(I32 below_Y) { this->below_Y = below_Y; };
 private:
   I32 below_Y;
@@ -500,6 +723,10 @@ public:
   inline const CHAR* name() const { return "drop_Y_above"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_Y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_Y() >= above_Y); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_column(batch, filtered, batch->Y, [this](I32 Y) { return (Y >= above_Y); });
+  };
   LAScriterionDropYAbove(I32 above_Y) { this->above_Y = above_Y; };
 private:
   I32 above_Y;
@@ -512,6 +739,10 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_Z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->get_Z() < below_Z); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_column(batch, filtered, batch->Z, [this](I32 Z) { return (Z < below_Z); });
+  };
   LAScriterionDropZBelow(I32 below_Z) { this->below_Z = below_Z; };
 private:
   I32 below_Z;
@@ -524,6 +755,10 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_Z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->get_Z() >= above_Z); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered)
+  {
+    return filter_column(batch, filtered, batch->Z, [this](I32 Z) { return (Z >= above_Z); });
+  };
   LAScriterionDropZAbove(I32 above_Z) { this->above_Z = above_Z; };
 private:
   I32 above_Z;
@@ -535,6 +770,7 @@ public:
   inline const CHAR* name() const { return "keep_first"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline BOOL filter(const LASpoint* point) { return (point->return_number > 1); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { return filter_returns(batch, filtered, [](U8 r, U8) { return (r > 1); }); };
 };
 
 class LAScriterionKeepFirstOfManyReturn : public LAScriterion
@@ -543,6 +779,7 @@ public:
   inline const CHAR* name() const { return "keep_first_of_many"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline BOOL filter(const LASpoint* point) { return ((point->number_of_returns == 1) || (point->return_number > 1)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { return filter_returns(batch, filtered, [](U8 r, U8 n) { return ((n == 1) | (r > 1)); }); };
 };
 
 class LAScriterionKeepMiddleReturn : public LAScriterion
@@ -551,6 +788,7 @@ public:
   inline const CHAR* name() const { return "keep_middle"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline BOOL filter(const LASpoint* point) { return ((point->return_number == 1) || (point->return_number >= point->number_of_returns)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { return filter_returns(batch, filtered, [](U8 r, U8 n) { return ((r == 1) | (r >= n)); }); };
 };
 
 class LAScriterionKeepLastReturn : public LAScriterion
@@ -559,6 +797,7 @@ public:
   inline const CHAR* name() const { return "keep_last"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline BOOL filter(const LASpoint* point) { return (point->return_number < point->number_of_returns); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { return filter_returns(batch, filtered, [](U8 r, U8 n) { return (r < n); }); };
 };
 
 class LAScriterionKeepLastOfManyReturn : public LAScriterion
@@ -567,6 +806,7 @@ public:
   inline const CHAR* name() const { return "keep_last_of_many"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline BOOL filter(const LASpoint* point) { return ((point->return_number == 1) || (point->return_number < point->number_of_returns)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { return filter_returns(batch, filtered, [](U8 r, U8 n) { return ((r == 1) | (r < n)); }); };
 };
 
 class LAScriterionKeepSecondLast : public LAScriterion
@@ -575,6 +815,7 @@ public:
   inline const CHAR* name() const { return "keep_second_last"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline BOOL filter(const LASpoint* point) { return ((point->number_of_returns <= 1) || (point->return_number != (point->number_of_returns - 1))); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { return filter_returns(batch, filtered, [](U8 r, U8 n) { return ((n <= 1) | (r != (n - 1))); }); };
 };
 
 class LAScriterionDropFirstReturn : public LAScriterion
@@ -583,6 +824,7 @@ public:
   inline const CHAR* name() const { return "drop_first"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline BOOL filter(const LASpoint* point) { return (point->return_number == 1); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { return filter_returns(batch, filtered, [](U8 r, U8) { return (r == 1); }); };
 };
 
 class LAScriterionDropFirstOfManyReturn : public LAScriterion
@@ -591,6 +833,7 @@ public:
   inline const CHAR* name() const { return "drop_first_of_many"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline BOOL filter(const LASpoint* point) { return ((point->number_of_returns > 1) && (point->return_number == 1)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { return filter_returns(batch, filtered, [](U8 r, U8 n) { return ((n > 1) & (r == 1)); }); };
 };
 
 class LAScriterionDropMiddleReturn : public LAScriterion
@@ -599,6 +842,7 @@ public:
   inline const CHAR* name() const { return "drop_middle"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline BOOL filter(const LASpoint* point) { return ((point->return_number > 1) && (point->return_number < point->number_of_returns)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { return filter_returns(batch, filtered, [](U8 r, U8 n) { return ((r > 1) & (r < n)); }); };
 };
 
 class LAScriterionDropLastReturn : public LAScriterion
@@ -607,6 +851,7 @@ public:
   inline const CHAR* name() const { return "drop_last"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline BOOL filter(const LASpoint* point) { return (point->return_number >= point->number_of_returns); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { return filter_returns(batch, filtered, [](U8 r, U8 n) { return (r >= n); }); };
 };
 
 class LAScriterionDropLastOfManyReturn : public LAScriterion
@@ -615,6 +860,7 @@ public:
   inline const CHAR* name() const { return "drop_last_of_many"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline BOOL filter(const LASpoint* point) { return ((point->number_of_returns > 1) && (point->return_number >= point->number_of_returns)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { return filter_returns(batch, filtered, [](U8 r, U8 n) { return ((n > 1) & (r >= n)); }); };
 };
 
 class LAScriterionDropSecondLast : public LAScriterion
@@ -623,6 +869,7 @@ public:
   inline const CHAR* name() const { return "drop_second_last"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline BOOL filter(const LASpoint* point) { return ((point->number_of_returns > 1) && (point->return_number == (point->number_of_returns - 1))); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { return filter_returns(batch, filtered, [](U8 r, U8 n) { return ((n > 1) & (r == (n - 1))); }); };
 };
 
 class LAScriterionKeepReturns : public LAScriterion
@@ -637,6 +884,7 @@ public:
     return n;
   };
   inline BOOL filter(const LASpoint* point) { return ((1 << point->get_return_number()) & drop_return_mask); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { return filter_returns(batch, filtered, [this](U8 r, U8) { return (((1 << r) & drop_return_mask) != 0); }); };
   LAScriterionKeepReturns(U16 keep_return_mask) { drop_return_mask = ~keep_return_mask; };
   inline U16 get_keep_return_mask() const { return ~drop_return_mask; };
 private:
@@ -654,6 +902,7 @@ public:
     return n;
   };
   inline BOOL filter(const LASpoint* point) { return ((1 << point->get_return_number()) & drop_return_mask); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { return filter_returns(batch, filtered, [this](U8 r, U8) { return (((1 << r) & drop_return_mask) != 0); }); };
   LAScriterionDropReturns(U16 drop_return_mask) { this->drop_return_mask = drop_return_mask; };
   inline U16 get_drop_return_mask() const { return drop_return_mask; };
 private:
@@ -666,6 +915,7 @@ public:
   inline const CHAR* name() const { return (number_of_returns == 1 ? "keep_single" : (number_of_returns == 2 ? "keep_double" : (number_of_returns == 3 ? "keep_triple" : (number_of_returns == 4 ? "keep_quadruple" : "keep_quintuple")))); };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline BOOL filter(const LASpoint* point) { return (point->get_number_of_returns() != number_of_returns); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { const U8* returns = batch->number_of_returns; for (U32 j = 0; j < batch->count; j++) filtered[j] = (legacy_number_of_returns(returns[j]) != number_of_returns); return TRUE; };
   LAScriterionKeepSpecificNumberOfReturns(U32 number_of_returns) { this->number_of_returns = number_of_returns; };
 private:
   U32 number_of_returns;
@@ -677,6 +927,7 @@ public:
   inline const CHAR* name() const { return (number_of_returns == 1 ? "drop_single" : (number_of_returns == 2 ? "drop_double" : (number_of_returns == 3 ? "drop_triple" : (number_of_returns == 4 ? "drop_quadruple" : "drop_quintuple")))); };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline BOOL filter(const LASpoint* point) { return (point->get_number_of_returns() == number_of_returns); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { const U8* returns = batch->number_of_returns; for (U32 j = 0; j < batch->count; j++) filtered[j] = (legacy_number_of_returns(returns[j]) == number_of_returns); return TRUE; };
   LAScriterionDropSpecificNumberOfReturns(U32 number_of_returns) { this->number_of_returns = number_of_returns; };
 private:
   U32 number_of_returns;
@@ -778,6 +1029,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s_%s %d %d ", name(), (channel == 0 ? "red" : (channel == 1 ? "green" : (channel == 2 ? "blue" : "nir"))), below_RGB, above_RGB); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_RGB; };
   inline BOOL filter(const LASpoint* point) { return ((point->rgb[channel] < below_RGB) || (above_RGB < point->rgb[channel])); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { if (batch->rgb == 0) return FALSE; const U16* rgb = batch->rgb; for (U32 j = 0; j < batch->count; j++) filtered[j] = ((rgb[4*j+channel] < below_RGB) | (above_RGB < rgb[4*j+channel])); return TRUE; };
   LAScriterionKeepRGB(I32 below_RGB, I32 above_RGB, I32 channel) { if (above_RGB < below_RGB) { this->below_RGB = above_RGB; this->above_RGB = below_RGB; } else { this->below_RGB = below_RGB; this->above_RGB = above_RGB; }; this->channel = channel; };
 private:
   I32 below_RGB, above_RGB, channel;
@@ -790,6 +1042,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_RGB, above_RGB); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_RGB; };
   inline BOOL filter(const LASpoint* point) { I32 greenness = 2 * point->get_G() - point->get_R() - point->get_B(); return ((greenness < below_RGB) || (above_RGB < greenness)); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { if (batch->rgb == 0) return FALSE; const U16* rgb = batch->rgb; for (U32 j = 0; j < batch->count; j++) { I32 greenness = 2 * rgb[4*j+1] - rgb[4*j] - rgb[4*j+2]; filtered[j] = ((greenness < below_RGB) | (above_RGB < greenness)); } return TRUE; };
   LAScriterionKeepRGBgreenness(I32 below_RGB, I32 above_RGB) { if (above_RGB < below_RGB) { this->below_RGB = above_RGB; this->above_RGB = below_RGB; } else { this->below_RGB = below_RGB; this->above_RGB = above_RGB; }; };
 private:
   I32 below_RGB, above_RGB;
@@ -805,6 +1058,7 @@ public:
   {
     return ((below_RGB <= point->rgb[channel]) && (point->rgb[channel] <= above_RGB));
   };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { if (batch->rgb == 0) return FALSE; const U16* rgb = batch->rgb; for (U32 j = 0; j < batch->count; j++) filtered[j] = ((below_RGB <= rgb[4*j+channel]) & (rgb[4*j+channel] <= above_RGB)); return TRUE; };
   LAScriterionDropRGB(I32 below_RGB, I32 above_RGB, I32 channel)
   {
     if (above_RGB < below_RGB)
@@ -1099,6 +1353,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_scan, above_scan); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_SCAN_ANGLE; };
   inline BOOL filter(const LASpoint* point) { return (point->scan_angle_rank < below_scan) || (above_scan < point->scan_angle_rank); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { const I16* scan_angle = batch->scan_angle; const BOOL extended = batch->extended_point_type; for (U32 j = 0; j < batch->count; j++) { I32 scan_angle_rank = (extended ? legacy_scan_angle_rank(scan_angle[j]) : scan_angle[j]); filtered[j] = ((scan_angle_rank < below_scan) | (above_scan < scan_angle_rank)); } return TRUE; };
   LAScriterionKeepScanAngle(I32 below_scan, I32 above_scan) { if (above_scan < below_scan) { this->below_scan = above_scan; this->above_scan = below_scan; } else { this->below_scan = below_scan; this->above_scan = above_scan; } };
 private:
   I32 below_scan, above_scan;
@@ -1111,6 +1366,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_scan); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_SCAN_ANGLE; };
   inline BOOL filter(const LASpoint* point) { return (point->scan_angle_rank < below_scan); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { const I16* scan_angle = batch->scan_angle; const BOOL extended = batch->extended_point_type; for (U32 j = 0; j < batch->count; j++) { I32 scan_angle_rank = (extended ? legacy_scan_angle_rank(scan_angle[j]) : scan_angle[j]); filtered[j] = (scan_angle_rank < below_scan); } return TRUE; };
   LAScriterionDropScanAngleBelow(I32 below_scan) { this->below_scan = below_scan; };
 private:
   I32 below_scan;
@@ -1123,6 +1379,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_scan); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_SCAN_ANGLE; };
   inline BOOL filter(const LASpoint* point) { return (point->scan_angle_rank > above_scan); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { const I16* scan_angle = batch->scan_angle; const BOOL extended = batch->extended_point_type; for (U32 j = 0; j < batch->count; j++) { I32 scan_angle_rank = (extended ? legacy_scan_angle_rank(scan_angle[j]) : scan_angle[j]); filtered[j] = (scan_angle_rank > above_scan); } return TRUE; };
   LAScriterionDropScanAngleAbove(I32 above_scan) { this->above_scan = above_scan; };
 private:
   I32 above_scan;
@@ -1135,6 +1392,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_scan, above_scan); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_SCAN_ANGLE; };
   inline BOOL filter(const LASpoint* point) { return (below_scan <= point->scan_angle_rank) && (point->scan_angle_rank <= above_scan); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { const I16* scan_angle = batch->scan_angle; const BOOL extended = batch->extended_point_type; for (U32 j = 0; j < batch->count; j++) { I32 scan_angle_rank = (extended ? legacy_scan_angle_rank(scan_angle[j]) : scan_angle[j]); filtered[j] = ((below_scan <= scan_angle_rank) & (scan_angle_rank <= above_scan)); } return TRUE; };
   LAScriterionDropScanAngleBetween(I32 below_scan, I32 above_scan) { if (above_scan < below_scan) { this->below_scan = above_scan; this->above_scan = below_scan; } else { this->below_scan = below_scan; this->above_scan = above_scan; } };
 private:
   I32 below_scan, above_scan;
@@ -1147,6 +1405,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_intensity, above_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (point->get_intensity() < below_intensity) || (point->get_intensity() > above_intensity); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { const U16* intensity = batch->intensity; for (U32 j = 0; j < batch->count; j++) filtered[j] = ((intensity[j] < below_intensity) | (intensity[j] > above_intensity)); return TRUE; };
   LAScriterionKeepIntensity(U16 below_intensity, U16 above_intensity) { this->below_intensity = below_intensity; this->above_intensity = above_intensity; };
 private:
   U16 below_intensity, above_intensity;
@@ -1159,6 +1418,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (point->get_intensity() >= below_intensity); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { const U16* intensity = batch->intensity; for (U32 j = 0; j < batch->count; j++) filtered[j] = (intensity[j] >= below_intensity); return TRUE; };
   LAScriterionKeepIntensityBelow(U16 below_intensity) { this->below_intensity = below_intensity; };
 private:
   U16 below_intensity;
@@ -1171,6 +1431,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (point->get_intensity() <= above_intensity); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { const U16* intensity = batch->intensity; for (U32 j = 0; j < batch->count; j++) filtered[j] = (intensity[j] <= above_intensity); return TRUE; };
   LAScriterionKeepIntensityAbove(U16 above_intensity) { this->above_intensity = above_intensity; };
 private:
   U16 above_intensity;
@@ -1183,6 +1444,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (point->get_intensity() < below_intensity); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { const U16* intensity = batch->intensity; for (U32 j = 0; j < batch->count; j++) filtered[j] = (intensity[j] < below_intensity); return TRUE; };
   LAScriterionDropIntensityBelow(I32 below_intensity) { this->below_intensity = below_intensity; };
 private:
   I32 below_intensity;
@@ -1195,6 +1457,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (point->get_intensity() > above_intensity); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { const U16* intensity = batch->intensity; for (U32 j = 0; j < batch->count; j++) filtered[j] = (intensity[j] > above_intensity); return TRUE; };
   LAScriterionDropIntensityAbove(I32 above_intensity) { this->above_intensity = above_intensity; };
 private:
   I32 above_intensity;
@@ -1207,6 +1470,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_intensity, above_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (below_intensity <= point->get_intensity()) && (point->get_intensity() <= above_intensity); };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { const U16* intensity = batch->intensity; for (U32 j = 0; j < batch->count; j++) filtered[j] = ((below_intensity <= intensity[j]) & (intensity[j] <= above_intensity)); return TRUE; };
   LAScriterionDropIntensityBetween(I32 below_intensity, I32 above_intensity) { this->below_intensity = below_intensity; this->above_intensity = above_intensity; };
 private:
   I32 below_intensity, above_intensity;
@@ -1242,6 +1506,7 @@ public:
       return ((1u << point->classification) & drop_classification_mask);
     }
   };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { const U8* classification = batch->classification; for (U32 j = 0; j < batch->count; j++) filtered[j] = ((classification[j] > 31) | (((1u << (classification[j] & 31)) & drop_classification_mask) != 0)); return TRUE; };
   LAScriterionKeepClassifications(U32 keep_classification_mask) { drop_classification_mask = ~keep_classification_mask; };
   inline U32 get_keep_classification_mask() const { return ~drop_classification_mask; };
 private:
@@ -1277,6 +1542,7 @@ public:
       return ((1u << point->classification) & drop_classification_mask);
     }
   };
+  inline BOOL filter(const LASpointBatch* batch, U8* filtered) { const U8* classification = batch->classification; for (U32 j = 0; j < batch->count; j++) filtered[j] = ((classification[j] < 32) & (((1u << (classification[j] & 31)) & drop_classification_mask) != 0)); return TRUE; };
   LAScriterionDropClassifications(U32 drop_classification_mask) { this->drop_classification_mask = drop_classification_mask; };
   inline U32 get_drop_classification_mask() const { return drop_classification_mask; };
 private:
@@ -2029,10 +2295,15 @@ void LASfilter::clean()
   }
   if (criteria) delete[] criteria;
   if (counters) delete[] counters;
+  if (batch_counters) delete[] batch_counters;
+  if (mask) delete[] mask;
   alloc_criteria = 0;
   num_criteria = 0;
   criteria = 0;
   counters = 0;
+  batch_counters = 0;
+  alloc_mask = 0;
+  mask = 0;
 }
 
 void LASfilter::usage() const
@@ -5428,6 +5699,43 @@ BOOL LASfilter::filter(const LASpoint* point)
   return FALSE; // point survived
 }
 
+BOOL LASfilter::filter(const LASpointBatch* batch, U8* filtered)
+{
+  U32 i, j;
+  U32 count = batch->count;
+
+  if (count > alloc_mask)
+  {
+    if (mask) delete[] mask;
+    mask = new U8[count];
+    alloc_mask = count;
+  }
+
+  // each criterion marks the points it filters in its own mask and these
+  // masks are OR-ed. a point is counted for the first criterion filtering
+  // it, exactly as if the points had been filtered one by one.
+  memset(filtered, 0, count);
+  for (i = 0; i < num_criteria; i++)
+  {
+    if (!criteria[i]->filter(batch, mask))
+    {
+      return FALSE; // criterion can only filter single points
+    }
+    I32 n = 0;
+    for (j = 0; j < count; j++)
+    {
+      n += (mask[j] & (filtered[j] ^ 1));
+      filtered[j] |= mask[j];
+    }
+    batch_counters[i] = n;
+  }
+  for (i = 0; i < num_criteria; i++)
+  {
+    counters[i] += batch_counters[i];
+  }
+  return TRUE;
+}
+
 void LASfilter::reset()
 {
   U32 i;
@@ -5443,11 +5751,14 @@ LASfilter::LASfilter()
   num_criteria = 0;
   criteria = 0;
   counters = 0;
+  batch_counters = 0;
+  alloc_mask = 0;
+  mask = 0;
 }
 
 LASfilter::~LASfilter()
 {
-  if (criteria) clean();
+  if (criteria || mask) clean();
 }
 
 void LASfilter::add_criterion(LAScriterion* filter_criterion)
@@ -5467,9 +5778,11 @@ void LASfilter::add_criterion(LAScriterion* filter_criterion)
       }
       delete[] criteria;
       delete[] counters;
+      delete[] batch_counters;
     }
     criteria = temp_criteria;
     counters = temp_counters;
+    batch_counters = new int[alloc_criteria]; // what each criterion filtered in the current batch
   }
   criteria[num_criteria] = filter_criterion;
   counters[num_criteria] = 0;
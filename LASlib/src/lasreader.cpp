@@ -35,6 +35,7 @@
 #include "lasindex.hpp"
 #include "laskdtree.hpp"
 #include "lasmessage.hpp"
+#include "laspointbatch.hpp"
 #include "lasreader_asc.hpp"
 #include "lasreader_bil.hpp"
 #include "lasreader_bin.hpp"
@@ -62,7 +63,11 @@ LASreader::LASreader(LASreadOpener* opener) {
   p_idx = 0;
   p_cnt = 0;
   read_simple = &LASreader::read_point_default;
+  read_simple_default = TRUE;
   read_complex = 0;
+  read_complex_default = FALSE;
+  batch_filtered = 0;
+  batch_filtered_alloc = 0;
   index = 0;
   copc_index = 0;
   copc_stream_order = 0;
@@ -97,6 +102,7 @@ LASreader::~LASreader() {
   if (index) delete index;
   if (copc_index) delete copc_index;
   if (transform) transform->check_for_overflow();
+  if (batch_filtered) delete[] batch_filtered;
 }
 
 void LASreader::dealloc() {
@@ -117,28 +123,38 @@ void LASreader::set_filter(LASfilter* filter) {
   this->filter = filter;
   if (filter && transform) {
     read_simple = &LASreader::read_point_filtered_and_transformed;
+    read_simple_default = FALSE;
   } else if (filter) {
     read_simple = &LASreader::read_point_filtered;
+    read_simple_default = FALSE;
   } else if (transform) {
     read_simple = &LASreader::read_point_transformed;
+    read_simple_default = FALSE;
   } else {
     read_simple = &LASreader::read_point_default;
+    read_simple_default = TRUE;
   }
   read_complex = &LASreader::read_point_default;
+  read_complex_default = TRUE;
 }
 
 void LASreader::set_transform(LAStransform* transform) {
   this->transform = transform;
   if (filter && transform) {
     read_simple = &LASreader::read_point_filtered_and_transformed;
+    read_simple_default = FALSE;
   } else if (filter) {
     read_simple = &LASreader::read_point_filtered;
+    read_simple_default = FALSE;
   } else if (transform) {
     read_simple = &LASreader::read_point_transformed;
+    read_simple_default = FALSE;
   } else {
     read_simple = &LASreader::read_point_default;
+    read_simple_default = TRUE;
   }
   read_complex = &LASreader::read_point_default;
+  read_complex_default = TRUE;
 }
 
 void LASreader::set_ignore(LASignore* ignore) {
@@ -146,10 +162,13 @@ void LASreader::set_ignore(LASignore* ignore) {
 }
 
 BOOL LASreader::inside_none() {
+  if (index) prefetch_intervals(FALSE);
   if (filter || transform) {
     read_complex = &LASreader::read_point_default;
+    read_complex_default = TRUE;
   } else {
     read_simple = &LASreader::read_point_default;
+    read_simple_default = TRUE;
   }
   if (inside) {
     header.min_x = orig_min_x;
@@ -181,22 +200,28 @@ BOOL LASreader::inside_tile(const F32 ll_x, const F32 ll_y, const F32 size) {
   if (((orig_min_x > header.max_x) || (orig_min_y > header.max_y) || (orig_max_x < header.min_x) || (orig_max_y < header.min_y))) {
     if (filter || transform) {
       read_complex = &LASreader::read_point_none;
+      read_complex_default = FALSE;
     } else {
       read_simple = &LASreader::read_point_none;
+      read_simple_default = FALSE;
     }
   } else if (filter || transform) {
     if (index) {
-      if (index) index->intersect_tile(ll_x, ll_y, size);
+      prefetch_intervals(index->intersect_tile(ll_x, ll_y, size));
       read_complex = &LASreader::read_point_inside_tile_indexed;
+      read_complex_default = FALSE;
     } else {
       read_complex = &LASreader::read_point_inside_tile;
+      read_complex_default = FALSE;
     }
   } else {
     if (index) {
-      if (index) index->intersect_tile(ll_x, ll_y, size);
+      prefetch_intervals(index->intersect_tile(ll_x, ll_y, size));
       read_simple = &LASreader::read_point_inside_tile_indexed;
+      read_simple_default = FALSE;
     } else {
       read_simple = &LASreader::read_point_inside_tile;
+      read_simple_default = FALSE;
     }
   }
   return TRUE;
@@ -219,28 +244,38 @@ BOOL LASreader::inside_circle(const F64 center_x, const F64 center_y, const F64
   if (((orig_min_x > header.max_x) || (orig_min_y > header.max_y) || (orig_max_x < header.min_x) || (orig_max_y < header.min_y))) {
     if (filter || transform) {
       read_complex = &LASreader::read_point_none;
+      read_complex_default = FALSE;
     } else {
       read_simple = &LASreader::read_point_none;
+      read_simple_default = FALSE;
     }
   } else if (filter || transform) {
     if (index) {
-      if (index) index->intersect_circle(center_x, center_y, radius);
+      prefetch_intervals(index->intersect_circle(center_x, center_y, radius));
       read_complex = &LASreader::read_point_inside_circle_indexed;
+      read_complex_default = FALSE;
     } else if (copc_index) {
       copc_index->intersect_circle(center_x, center_y, radius);
+      prefetch_intervals(TRUE);
       read_complex = &LASreader::read_point_inside_circle_copc_indexed;
+      read_complex_default = FALSE;
     } else {
       read_complex = &LASreader::read_point_inside_circle;
+      read_complex_default = FALSE;
     }
   } else {
     if (index) {
-      if (index) index->intersect_circle(center_x, center_y, radius);
+      prefetch_intervals(index->intersect_circle(center_x, center_y, radius));
       read_simple = &LASreader::read_point_inside_circle_indexed;
+      read_simple_default = FALSE;
     } else if (copc_index) {
       copc_index->intersect_circle(center_x, center_y, radius);
+      prefetch_intervals(TRUE);
       read_simple = &LASreader::read_point_inside_circle_copc_indexed;
+      read_simple_default = FALSE;
     } else {
       read_simple = &LASreader::read_point_inside_circle;
+      read_simple_default = FALSE;
     }
   }
   return TRUE;
@@ -263,28 +298,38 @@ BOOL LASreader::inside_rectangle(const F64 min_x, const F64 min_y, const F64 max
   if (((orig_min_x > max_x) || (orig_min_y > max_y) || (orig_max_x < min_x) || (orig_max_y < min_y))) {
     if (filter || transform) {
       read_complex = &LASreader::read_point_none;
+      read_complex_default = FALSE;
     } else {
       read_simple = &LASreader::read_point_none;
+      read_simple_default = FALSE;
     }
   } else if (filter || transform) {
     if (index) {
-      index->intersect_rectangle(min_x, min_y, max_x, max_y);
+      prefetch_intervals(index->intersect_rectangle(min_x, min_y, max_x, max_y));
       read_complex = &LASreader::read_point_inside_rectangle_indexed;
+      read_complex_default = FALSE;
     } else if (copc_index) {
       copc_index->intersect_rectangle(min_x, min_y, max_x, max_y);
+      prefetch_intervals(TRUE);
       read_complex = &LASreader::read_point_inside_rectangle_copc_indexed;
+      read_complex_default = FALSE;
     } else {
       read_complex = &LASreader::read_point_inside_rectangle;
+      read_complex_default = FALSE;
     }
   } else {
     if (index) {
-      index->intersect_rectangle(min_x, min_y, max_x, max_y);
+      prefetch_intervals(index->intersect_rectangle(min_x, min_y, max_x, max_y));
       read_simple = &LASreader::read_point_inside_rectangle_indexed;
+      read_simple_default = FALSE;
     } else if (copc_index) {
       copc_index->intersect_rectangle(min_x, min_y, max_x, max_y);
+      prefetch_intervals(TRUE);
       read_simple = &LASreader::read_point_inside_rectangle_copc_indexed;
+      read_simple_default = FALSE;
     } else {
       read_simple = &LASreader::read_point_inside_rectangle;
+      read_simple_default = FALSE;
     }
   }
   return TRUE;
@@ -306,14 +351,19 @@ BOOL LASreader::inside_copc_depth(const U8 mode, const I32 depth, const F32 reso
   else
     return FALSE;
 
+  prefetch_intervals(TRUE);
+
   // If inside we are already using read_point_inside_[rectangle|circle]_copc_indexed
   // We do not overwrite read_[simple|complex] with a non spatial aware reader.
   if (inside) return TRUE;
 
-  if (filter || transform)
+  if (filter || transform) {
     read_complex = &LASreader::read_point_inside_depth_copc_indexed;
-  else
+    read_complex_default = FALSE;
+  } else {
     read_simple = &LASreader::read_point_inside_depth_copc_indexed;
+    read_simple_default = FALSE;
+  }
 
   return TRUE;
 }
@@ -392,6 +442,58 @@ BOOL LASreader::read_point_none() {
   return FALSE;
 }
 
+U32 LASreader::read_points(LASpointBatch& batch, const U32 max_count) {
+  if (!batch.init(&point, max_count)) {
+    laserror("cannot allocate batch of %u points", max_count);
+    return 0;
+  }
+  // without filter, transform, or area of interest there is nothing between us and the decoder
+  if (read_simple_default) {
+    return read_points_default(batch, max_count);
+  }
+  // with a filter and/or a transform (but no area of interest) their criteria and their
+  // operations run over the columns of entire batches
+  if (read_complex_default && (filter || transform)) {
+    BOOL filtered = (filter != 0);
+    BOOL transformed = (transform != 0);
+    if (filtered && (max_count > batch_filtered_alloc)) {
+      if (batch_filtered) delete[] batch_filtered;
+      batch_filtered = new U8[max_count];
+      batch_filtered_alloc = max_count;
+    }
+    // the empty batch only checks whether all criteria and operations can handle batches of this point type
+    if ((!filtered || filter->filter(&batch, batch_filtered)) && (!transformed || transform->transform(&batch))) {
+      if (filtered) {
+        read_points_filtered(batch, max_count);
+      } else {
+        read_points_default(batch, max_count);
+      }
+      if (transformed) transform->transform(&batch);
+      return batch.count;
+    }
+  }
+  while ((batch.count < max_count) && read_point()) {
+    batch.add(&point);
+  }
+  return batch.count;
+}
+
+U32 LASreader::read_points_default(LASpointBatch& batch, const U32 max_count) {
+  while ((batch.count < max_count) && read_point_default()) {
+    batch.add(&point);
+  }
+  return batch.count;
+}
+
+U32 LASreader::read_points_filtered(LASpointBatch& batch, const U32 max_count) {
+  while (read_points_default(batch, max_count)) {
+    filter->filter(&batch, batch_filtered);
+    batch.remove_filtered(batch_filtered);
+    if (batch.count) break;
+  }
+  return batch.count;
+}
+
 BOOL LASreader::read_point_filtered() {
   while ((this->*read_complex)()) {
     if (!filter->filter(&point)) return TRUE;
@@ -474,6 +576,18 @@ I32 LASreadOpener::unparse(CHAR* string) const {
   if (io_ibuffer_size != LAS_TOOLS_IO_IBUFFER_SIZE) {
     n += sprintf(string + n, "-io_ibuffer %u ", io_ibuffer_size);
   }
+  if (decompress_threads > 1) {
+    n += sprintf(string + n, "-ithreads %u ", decompress_threads);
+  }
+  if (decompress_layer_threads > 1) {
+    n += sprintf(string + n, "-ilayer_threads %u ", decompress_layer_threads);
+  }
+  if (mmap) {
+    n += sprintf(string + n, "-mmap ");
+  }
+  if (chunk_cache_size) {
+    n += sprintf(string + n, "-icache %u ", chunk_cache_size);
+  }
   if (!temp_file_base.empty()) {
     n += sprintf(string + n, "-temp_files \"%s\" ", temp_file_base.c_str());
   }
@@ -720,7 +834,7 @@ LASreader* LASreadOpener::open(const CHAR* other_file_name, BOOL reset_after_oth
           lasreaderlas = new LASreaderLASrescalereoffset(this, scale_factor[0], scale_factor[1], scale_factor[2], offset[0], offset[1], offset[2]);
 
         lasreaderlas->set_keep_copc(keep_copc);
-        if (lasreaderlas->open(file_name, io_ibuffer_size, FALSE, decompress_selective)) {
+        if (lasreaderlas->open(file_name, io_ibuffer_size, FALSE, get_decompress_selective())) {
           LASMessage(LAS_VERY_VERBOSE, "open file '%s'", file_name);
         } else {
           laserror("cannot open lasreaderlas with file name '%s'", file_name);
@@ -1070,6 +1184,7 @@ LASreader* LASreadOpener::open(const CHAR* other_file_name, BOOL reset_after_oth
         if (scale_intensity != 1.0f) lasreaderply->set_scale_intensity(scale_intensity);
         lasreaderply->set_scale_factor(scale_factor);
         lasreaderply->set_offset(offset);
+        if (decompress_threads > 1) lasreaderply->set_threads(decompress_threads);
         if (!lasreaderply->open(file_name, point_type, populate_header)) {
           laserror("cannot open lasreaderply with file name '%s'", file_name);
           delete lasreaderply;
@@ -1176,6 +1291,7 @@ LASreader* LASreadOpener::open(const CHAR* other_file_name, BOOL reset_after_oth
         if (scale_scan_angle != 1.0f) lasreadertxt->set_scale_scan_angle(scale_scan_angle);
         lasreadertxt->set_scale_factor(scale_factor);
         lasreadertxt->set_offset(offset);
+        if (decompress_threads > 1) lasreadertxt->set_threads(decompress_threads);
         if (number_attributes) {
           for (I32 i = 0; i < number_attributes; i++) {
             lasreadertxt->add_attribute(
@@ -1244,6 +1360,7 @@ LASreader* LASreadOpener::open(const CHAR* other_file_name, BOOL reset_after_oth
       if (scale_scan_angle != 1.0f) lasreadertxt->set_scale_scan_angle(scale_scan_angle);
       lasreadertxt->set_scale_factor(scale_factor);
       lasreadertxt->set_offset(offset);
+      if (decompress_threads > 1) lasreadertxt->set_threads(decompress_threads);
       if (number_attributes) {
         for (I32 i = 0; i < number_attributes; i++) {
           lasreadertxt->add_attribute(
@@ -1404,7 +1521,7 @@ BOOL LASreadOpener::reopen(LASreader* lasreader, BOOL remain_buffered) {
       if (!file_name) return FALSE;
       if (strstr(file_name, ".las") || strstr(file_name, ".laz") || strstr(file_name, ".LAS") || strstr(file_name, ".LAZ")) {
         LASreaderLAS* lasreaderlas = (LASreaderLAS*)lasreader;
-        if (!lasreaderlas->open(file_name, io_ibuffer_size, FALSE, decompress_selective)) {
+        if (!lasreaderlas->open(file_name, io_ibuffer_size, FALSE, get_decompress_selective())) {
           laserror("cannot reopen lasreaderlas with file name '%s'", file_name);
           return FALSE;
         }
@@ -1578,6 +1695,10 @@ void LASreadOpener::usage() const {
       "  -rescale_xy 0.01 0.01\n"
       "  -rescale_z 0.01\n"
       "  -reoffset 600000 4000000 0\n"
+      "  -ithreads 8 (decompress LAZ chunks, parse text, or decode PLY on 8 threads)\n"
+      "  -ilayer_threads 4 (decompress the layers of LAS 1.4 LAZ chunks on 4 threads)\n"
+      "  -mmap (read LAS/LAZ files through a memory mapping)\n"
+      "  -icache 512 (keep up to 512 MB of decompressed LAZ chunks for seeks)\n"
       "Fast AOI Queries for LAS/LAZ with spatial indexing LAX files\n"
       "  -inside min_x min_y max_x max_y\n"
       "  -inside_tile ll_x ll_y size\n"
@@ -1826,6 +1947,48 @@ void LASreadOpener::parse(int argc, char* argv[], BOOL parse_ignore, BOOL suppre
         *argv[i] = '\0';
         *argv[i + 1] = '\0';
         i += 1;
+      } else if (strcmp(argv[i], "-ithreads") == 0) {
+        if ((i + 1) >= argc) {
+          laserror("'%s' needs 1 argument: number", argv[i]);
+        }
+        U32 number_threads;
+        if (sscanf(argv[i + 1], "%u", &number_threads) != 1) {
+          laserror("'%s' needs 1 argument: number but '%s' is not a valid number.", argv[i], argv[i + 1]);
+        }
+        if (number_threads == 0) {
+          laserror("'%s' needs 1 argument: number but %u is not valid.", argv[i], number_threads);
+        }
+        set_decompress_threads(number_threads);
+        *argv[i] = '\0';
+        *argv[i + 1] = '\0';
+        i += 1;
+      } else if (strcmp(argv[i], "-ilayer_threads") == 0) {
+        if ((i + 1) >= argc) {
+          laserror("'%s' needs 1 argument: number", argv[i]);
+        }
+        U32 number_threads;
+        if (sscanf(argv[i + 1], "%u", &number_threads) != 1) {
+          laserror("'%s' needs 1 argument: number but '%s' is not a valid number.", argv[i], argv[i + 1]);
+        }
+        if (number_threads == 0) {
+          laserror("'%s' needs 1 argument: number but %u is not valid.", argv[i], number_threads);
+        }
+        set_decompress_layer_threads(number_threads);
+        *argv[i] = '\0';
+        *argv[i + 1] = '\0';
+        i += 1;
+      } else if (strcmp(argv[i], "-icache") == 0) {
+        if ((i + 1) >= argc) {
+          laserror("'%s' needs 1 argument: megabytes", argv[i]);
+        }
+        U32 megabytes;
+        if (sscanf(argv[i + 1], "%u", &megabytes) != 1) {
+          laserror("'%s' needs 1 argument: megabytes but '%s' is not a valid number.", argv[i], argv[i + 1]);
+        }
+        set_chunk_cache_size(megabytes);
+        *argv[i] = '\0';
+        *argv[i + 1] = '\0';
+        i += 1;
       } else if (strcmp(argv[i], "-itranslate_intensity") == 0) {
         if ((i + 1) >= argc) {
           laserror("'%s' needs 1 argument: translation", argv[i]);
@@ -2077,6 +2240,9 @@ void LASreadOpener::parse(int argc, char* argv[], BOOL parse_ignore, BOOL suppre
     } else if (strcmp(argv[i], "-offset_adjust") == 0) {
       set_offset_adjust(TRUE);
       *argv[i] = '\0';
+    } else if (strcmp(argv[i], "-mmap") == 0) {
+      set_mmap(TRUE);
+      *argv[i] = '\0';
     } else if (strcmp(argv[i], "-merged") == 0) {
       set_merged(TRUE);
       *argv[i] = '\0';
@@ -2427,6 +2593,22 @@ void LASreadOpener::set_io_ibuffer_size(const U32 buffer_size) {
   this->io_ibuffer_size = buffer_size;
 }
 
+void LASreadOpener::set_decompress_threads(const U32 decompress_threads) {
+  this->decompress_threads = decompress_threads;
+}
+
+void LASreadOpener::set_decompress_layer_threads(const U32 decompress_layer_threads) {
+  this->decompress_layer_threads = decompress_layer_threads;
+}
+
+void LASreadOpener::set_mmap(const BOOL mmap) {
+  this->mmap = mmap;
+}
+
+void LASreadOpener::set_chunk_cache_size(const U32 chunk_cache_size) {
+  this->chunk_cache_size = chunk_cache_size;
+}
+
 void LASreadOpener::set_file_name(const CHAR* file_name, BOOL unique) {
   add_file_name(file_name, unique);
 }
@@ -2980,15 +3162,39 @@ void LASreadOpener::set_pipe_on(BOOL pipe_on) {
 
 void LASreadOpener::set_decompress_selective(U32 decompress_selective) {
   this->decompress_selective = decompress_selective;
+}
+
+U32 LASreadOpener::get_decompress_selective() const {
+  // what the tool declared plus what the filter, the transform, and the ignore read from the points
+  U32 decompress_selective = this->decompress_selective;
   if (filter) {
-    this->decompress_selective |= filter->get_decompress_selective();
+    decompress_selective |= filter->get_decompress_selective();
   }
   if (transform) {
-    this->decompress_selective |= transform->get_decompress_selective();
+    decompress_selective |= transform->get_decompress_selective();
   }
   if (ignore) {
-    this->decompress_selective |= ignore->get_decompress_selective();
+    decompress_selective |= ignore->get_decompress_selective();
+  }
+  return decompress_selective;
+}
+
+U32 LASreadOpener::get_decompress_selective_for_point_type(const U8 point_type) {
+  // the layers that are written for points of this type (without what the type does not store)
+  U32 decompress_selective = LASZIP_DECOMPRESS_SELECTIVE_ALL;
+  if ((point_type == 0) || (point_type == 2)) {
+    decompress_selective &= ~LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME;
+  }
+  if ((point_type != 2) && (point_type != 3) && (point_type != 5) && (point_type != 7) && (point_type != 8) && (point_type != 10)) {
+    decompress_selective &= ~LASZIP_DECOMPRESS_SELECTIVE_RGB;
+  }
+  if ((point_type != 8) && (point_type != 10)) {
+    decompress_selective &= ~LASZIP_DECOMPRESS_SELECTIVE_NIR;
+  }
+  if ((point_type != 4) && (point_type != 5) && (point_type != 9) && (point_type != 10)) {
+    decompress_selective &= ~LASZIP_DECOMPRESS_SELECTIVE_WAVEPACKET;
   }
+  return decompress_selective;
 }
 
 void LASreadOpener::set_inside_tile(const F32 ll_x, const F32 ll_y, const F32 size) {
@@ -3029,6 +3235,10 @@ BOOL LASreadOpener::active() const {
 
 LASreadOpener::LASreadOpener() {
   io_ibuffer_size = LAS_TOOLS_IO_IBUFFER_SIZE;
+  decompress_threads = 1;
+  decompress_layer_threads = 1;
+  mmap = FALSE;
+  chunk_cache_size = 0;
   file_name = 0;
   file_names = 0;
   file_names_ID = 0;
@@ -31,9 +31,11 @@
 #include "lasreader_las.hpp"
 
 #include "lasmessage.hpp"
+#include "laspointbatch.hpp"
 #include "bytestreamin.hpp"
 #include "bytestreamin_file.hpp"
 #include "bytestreamin_istream.hpp"
+#include "bytestreamin_mmap.hpp"
 #include "lasreadpoint.hpp"
 #include "lasindex.hpp"
 #include "lascopc.hpp"
@@ -53,6 +55,30 @@ BOOL LASreaderLAS::open(const char* file_name, I32 io_buffer_size, BOOL peek_onl
     laserror("file name pointer is zero");
     return FALSE;
   }
+
+  // maybe read through a memory mapping of the entire file
+  if (opener && opener->get_mmap())
+  {
+    ByteStreamIn* in = 0;
+    if (IS_LITTLE_ENDIAN())
+    {
+      ByteStreamInMmapLE* mmap_in = new ByteStreamInMmapLE();
+      if (mmap_in->open(file_name)) in = mmap_in; else delete mmap_in;
+    }
+    else
+    {
+      ByteStreamInMmapBE* mmap_in = new ByteStreamInMmapBE();
+      if (mmap_in->open(file_name)) in = mmap_in; else delete mmap_in;
+    }
+    if (in)
+    {
+      if (this->file_name) free(this->file_name);
+      this->file_name = LASCopyString(file_name);
+      return open(in, peek_only, decompress_selective);
+    }
+    LASMessage(LAS_WARNING, "cannot map '%s' into memory. reading it from file instead.", file_name);
+  }
+
   file = LASfopen(file_name, "rb");
 
   if (file == 0)
@@ -1371,11 +1397,31 @@ BOOL LASreaderLAS::open(ByteStreamIn* stream, BOOL peek_only, U32 decompress_sel
   // create the point reader
   reader = new LASreadPoint(decompress_selective);
 
+  // maybe decompress chunks on several threads
+  if (opener && (opener->get_decompress_threads() > 1))
+  {
+    reader->set_threads(opener->get_decompress_threads(), npoints);
+  }
+
+  // maybe share decompressed chunks of this file with later seeks and other readers
+  if (opener && opener->get_chunk_cache_size() && file_name)
+  {
+    LASreadPoint::set_cache_size((I64)opener->get_chunk_cache_size() << 20);
+    if (opener->get_decompress_threads() <= 1) reader->set_threads(1, npoints);
+    reader->set_cache_key(file_name);
+  }
+
   // initialize point and the reader
   if (header.laszip)
   {
     if (!point.init(&header, header.laszip->num_items, header.laszip->items, &header)) return FALSE;
     if (!reader->setup(header.laszip->num_items, header.laszip->items, header.laszip)) return FALSE;
+
+    // maybe decompress the layers of LAS 1.4 chunks on several threads
+    if (opener && (opener->get_decompress_layer_threads() > 1))
+    {
+      reader->set_layer_threads(opener->get_decompress_layer_threads());
+    }
   }
   else
   {
@@ -1445,6 +1491,37 @@ I32 LASreaderLAS::get_format() const
   return LAS_TOOLS_FORMAT_LAS;
 }
 
+void LASreaderLAS::prefetch_intervals(const BOOL intersected)
+{
+  if (reader == 0) return;
+  U32* starts = 0;
+  U32* ends = 0;
+  U32 num_intervals = 0;
+  if (intersected && copc_index)
+  {
+    // the octants are independent chunks that are read in the order chosen for the stream
+    std::vector<Range> intervals = copc_index->get_points_intervals();
+    num_intervals = (U32)intervals.size();
+    if (num_intervals)
+    {
+      starts = new U32[num_intervals];
+      ends = new U32[num_intervals];
+      for (U32 i = 0; i < num_intervals; i++)
+      {
+        starts[i] = (U32)intervals[i].start;
+        ends[i] = (U32)intervals[i].end;
+      }
+    }
+  }
+  else if (intersected && index)
+  {
+    num_intervals = index->get_intervals(&starts, &ends);
+  }
+  reader->set_intervals(num_intervals, starts, ends);
+  if (starts) delete [] starts;
+  if (ends) delete [] ends;
+}
+
 BOOL LASreaderLAS::seek(const I64 p_index)
 {
   if (reader)
@@ -1528,6 +1605,16 @@ BOOL LASreaderLAS::read_point_default()
   return FALSE;
 }
 
+U32 LASreaderLAS::read_points_default(LASpointBatch& batch, const U32 max_count)
+{
+  // the qualified call avoids the virtual dispatch per point
+  while ((batch.count < max_count) && LASreaderLAS::read_point_default())
+  {
+    batch.add(&point);
+  }
+  return batch.count;
+}
+
 ByteStreamIn* LASreaderLAS::get_stream() const
 {
   return stream;
@@ -1594,6 +1681,12 @@ LASreaderLASrescale::LASreaderLASrescale(LASreadOpener* opener, F64 x_scale_fact
   rescale_z = 0;
 }
 
+U32 LASreaderLASrescale::read_points_default(LASpointBatch& batch, const U32 max_count)
+{
+  // points are modified one by one after decoding
+  return LASreader::read_points_default(batch, max_count);
+}
+
 BOOL LASreaderLASrescale::read_point_default()
 {
   if (!LASreaderLAS::read_point_default()) return FALSE;
@@ -1718,6 +1811,12 @@ LASreaderLASreoffset::LASreaderLASreoffset(LASreadOpener* opener) : LASreaderLAS
   auto_reoffset = TRUE;
 }
 
+U32 LASreaderLASreoffset::read_points_default(LASpointBatch& batch, const U32 max_count)
+{
+  // points are modified one by one after decoding
+  return LASreader::read_points_default(batch, max_count);
+}
+
 BOOL LASreaderLASreoffset::read_point_default()
 {
   if (!LASreaderLAS::read_point_default()) return FALSE;
@@ -1858,6 +1957,12 @@ LASreaderLASrescalereoffset::LASreaderLASrescalereoffset(LASreadOpener* opener,
 {
 }
 
+U32 LASreaderLASrescalereoffset::read_points_default(LASpointBatch& batch, const U32 max_count)
+{
+  // points are modified one by one after decoding
+  return LASreader::read_points_default(batch, max_count);
+}
+
 BOOL LASreaderLASrescalereoffset::read_point_default()
 {
   if (!LASreaderLAS::read_point_default()) return FALSE;
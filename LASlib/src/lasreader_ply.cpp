@@ -30,9 +30,17 @@
 */
 #include "lasreader_ply.hpp"
 
+#include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -42,6 +50,55 @@
 
 extern "C" FILE* fopen_compressed(const char* filename, const char* mode, bool* piped);
 
+// the binary vertices are read from the file in blocks of about this size
+#define LAS_PLY_BLOCK_SIZE (4 * LAS_TOOLS_IO_IBUFFER_SIZE)
+
+// the decoded fields of a point from X up to and including rgb[4]
+#define LAS_PLY_POINT_STRUCT_SIZE 48
+
+// states of a block of vertices used for multi-threaded decoding
+#define LAS_PLY_BLOCK_EMPTY 0
+#define LAS_PLY_BLOCK_BUSY  1
+#define LAS_PLY_BLOCK_READY 2
+#define LAS_PLY_BLOCK_EOF   3
+
+class LASreaderPLYblock
+{
+public:
+  U32 index;
+  U32 state;
+  U8* binary;
+  U32 count;
+  U8* records;
+  // the messages of decoding the block that the reader emits in block order
+  std::vector< std::pair<LAS_MESSAGE_TYPE, std::string> > messages;
+};
+
+class LASreaderPLYthreads
+{
+public:
+  std::vector<std::thread> workers;
+  std::vector<LASreaderPLY*> decoders;
+  // guards the blocks and the window of blocks being decoded
+  std::mutex mutex;
+  std::condition_variable block_done;
+  std::condition_variable block_free;
+  // serializes reading the blocks from the shared file in input order
+  std::mutex io;
+  BOOL stop;
+  BOOL end;
+  U32 num_blocks;
+  LASreaderPLYblock* blocks;
+  // the block that is currently handed out is 'first' and the workers
+  // decode ahead up to 'num_blocks' blocks in the window that follows
+  U32 first;
+  U32 next;
+  LASreaderPLYblock* current;
+  U32 current_point;
+  // layout of one decoded point inside the blocks
+  U32 record_size;
+};
+
 BOOL LASreaderPLY::open(const CHAR* file_name, U8 point_type, BOOL populate_header)
 {
   if (file_name == 0)
@@ -89,6 +146,8 @@ BOOL LASreaderPLY::open(FILE* file, const CHAR* file_name, U8 point_type, BOOL p
 
   // create parse string
 
+  I32 added_attributes = number_attributes;
+
   if (!parse_header())
   {
     return FALSE;
@@ -263,6 +322,10 @@ BOOL LASreaderPLY::open(FILE* file, const CHAR* file_name, U8 point_type, BOOL p
 
   point.init(&header, header.point_data_format, header.point_data_record_length, &header);
 
+  // maybe decode the binary vertices on multiple threads
+
+  start_threads();
+
   // should we perform an extra pass to fully populate the header
 
   if (populate_header && file_name)
@@ -404,6 +467,7 @@ BOOL LASreaderPLY::open(FILE* file, const CHAR* file_name, U8 point_type, BOOL p
 
     // close the input file
     
+    stop_threads();
     fclose(file);
     
     // populate scale and offset
@@ -436,12 +500,21 @@ BOOL LASreaderPLY::open(FILE* file, const CHAR* file_name, U8 point_type, BOOL p
 
     this->file = file;
 
-    // load the header a second time
+    // load the header a second time without registering its attributes twice
+
+    while (number_attributes > added_attributes)
+    {
+      number_attributes--;
+      free((void*)attribute_names[number_attributes]);
+      if (attribute_descriptions[number_attributes]) free((void*)attribute_descriptions[number_attributes]);
+    }
 
     if (!parse_header())
     {
       return FALSE;
     }
+
+    start_threads();
   }
 
   if (streamin) // binary
@@ -540,6 +613,11 @@ void LASreaderPLY::set_scale_factor(const F64* scale_factor)
   }
 }
 
+void LASreaderPLY::set_threads(U32 num_threads)
+{
+  this->num_threads = num_threads;
+}
+
 void LASreaderPLY::set_offset(const F64* offset)
 {
   if (offset)
@@ -598,6 +676,7 @@ BOOL LASreaderPLY::seek(const I64 p_index)
   else if (p_index < p_idx)
   {
     if (piped) return FALSE;
+    stop_threads();
     fseek(file, 0, SEEK_SET);
     // read the first line with full parse_string
     I32 i = 0;
@@ -644,7 +723,17 @@ BOOL LASreaderPLY::read_point_default()
     {
       if (streamin) // binary
       {
-        read_binary_point();
+        if (!read_binary_point() && binary_record_size)
+        {
+          LASMessage(LAS_WARNING, "end-of-file after %lld of %lld points", p_idx, npoints);
+
+          npoints = p_idx;
+          if (!populated_header)
+          {
+            populate_bounding_box();
+          }
+          return FALSE;
+        }
       }
       else // ascii
       {
@@ -754,6 +843,7 @@ ByteStreamIn* LASreaderPLY::get_stream() const
 
 void LASreaderPLY::close(BOOL close_stream)
 {
+  stop_threads();
   if (file)
   {
     if (piped) while(fgets(line, 512, file));
@@ -772,6 +862,7 @@ BOOL LASreaderPLY::reopen(const char* file_name)
     return FALSE;
   }
 
+  stop_threads();
   file = fopen_compressed(file_name, "r", &piped);
   if (file == 0)
   {
@@ -819,6 +910,7 @@ BOOL LASreaderPLY::reopen(const char* file_name)
 
 void LASreaderPLY::clean()
 {
+  stop_threads();
   if (file)
   {
     fclose(file);
@@ -834,6 +926,12 @@ void LASreaderPLY::clean()
     free(type_string);
     type_string = 0;
   }
+  if (binary_block)
+  {
+    free(binary_block);
+    binary_block = 0;
+  }
+  binary_record_size = 0;
   populated_header = FALSE;
 }
 
@@ -856,6 +954,15 @@ LASreaderPLY::LASreaderPLY(LASreadOpener* opener) :LASreader(opener)
   orig_x_scale_factor = 0.01;
   orig_y_scale_factor = 0.01;
   orig_z_scale_factor = 0.01;
+  binary_record_size = 0;
+  binary_remaining = 0;
+  binary_block_vertices = 0;
+  binary_block_count = 0;
+  binary_block_next = 0;
+  binary_block = 0;
+  num_threads = 1;
+  threads = 0;
+  decoding = 0;
   clean();
 }
 
@@ -905,7 +1012,7 @@ BOOL LASreaderPLY::set_attribute(I32 index, F64 value)
     }
     if (temp_i < U8_MIN || temp_i > U8_MAX)
     {
-      LASMessage(LAS_WARNING, "attribute %d of type U8 is %d. clamped to [%d %d] range.", index, temp_i, U8_MIN, U8_MAX);
+      message(LAS_WARNING, "attribute %d of type U8 is %d. clamped to [%d %d] range.", index, temp_i, U8_MIN, U8_MAX);
       point.set_attribute(header.attribute_starts[index], U8_CLAMP(temp_i));
     }
     else
@@ -930,7 +1037,7 @@ BOOL LASreaderPLY::set_attribute(I32 index, F64 value)
     }
     if (temp_i < I8_MIN || temp_i > I8_MAX)
     {
-      LASMessage(LAS_WARNING, "attribute %d of type I8 is %d. clamped to [%d %d] range.", index, temp_i, I8_MIN, I8_MAX);
+      message(LAS_WARNING, "attribute %d of type I8 is %d. clamped to [%d %d] range.", index, temp_i, I8_MIN, I8_MAX);
       point.set_attribute(header.attribute_starts[index], I8_CLAMP(temp_i));
     }
     else
@@ -955,7 +1062,7 @@ BOOL LASreaderPLY::set_attribute(I32 index, F64 value)
     }
     if (temp_i < U16_MIN || temp_i > U16_MAX)
     {
-      LASMessage(LAS_WARNING, "attribute %d of type U16 is %d. clamped to [%d %d] range.", index, temp_i, U16_MIN, U16_MAX);
+      message(LAS_WARNING, "attribute %d of type U16 is %d. clamped to [%d %d] range.", index, temp_i, U16_MIN, U16_MAX);
       point.set_attribute(header.attribute_starts[index], U16_CLAMP(temp_i));
     }
     else
@@ -980,7 +1087,7 @@ BOOL LASreaderPLY::set_attribute(I32 index, F64 value)
     }
     if (temp_i < I16_MIN || temp_i > I16_MAX)
     {
-      LASMessage(LAS_WARNING, "attribute %d of type I16 is %d. clamped to [%d %d] range.", index, temp_i, I16_MIN, I16_MAX);
+      message(LAS_WARNING, "attribute %d of type I16 is %d. clamped to [%d %d] range.", index, temp_i, I16_MIN, I16_MAX);
       point.set_attribute(header.attribute_starts[index], I16_CLAMP(temp_i));
     }
     else
@@ -1033,7 +1140,7 @@ BOOL LASreaderPLY::set_attribute(I32 index, F64 value)
   }
   else
   {
-    LASMessage(LAS_WARNING, "attribute %d not (yet) implemented.", index);
+    message(LAS_WARNING, "attribute %d not (yet) implemented.", index);
     return FALSE;
   }
   return TRUE;
@@ -1090,16 +1197,149 @@ F64 LASreaderPLY::read_binary_value(CHAR type)
   return value;
 }
 
+static inline F64 get_binary_value(CHAR type, const U8* bytes)
+{
+  if (type == 'f')
+  {
+    F32 temp_f32;
+    memcpy(&temp_f32, bytes, 4);
+    return (F64)temp_f32;
+  }
+  else if (type == 'd')
+  {
+    F64 temp_f64;
+    memcpy(&temp_f64, bytes, 8);
+    return temp_f64;
+  }
+  else if (type == 'C')
+  {
+    return (F64)bytes[0];
+  }
+  else if (type == 'c')
+  {
+    return (F64)((I8)bytes[0]);
+  }
+  else if (type == 'I')
+  {
+    U32 temp_u32;
+    memcpy(&temp_u32, bytes, 4);
+    return (F64)temp_u32;
+  }
+  else if (type == 'i')
+  {
+    I32 temp_i32;
+    memcpy(&temp_i32, bytes, 4);
+    return (F64)temp_i32;
+  }
+  else if (type == 'S')
+  {
+    U16 temp_u16;
+    memcpy(&temp_u16, bytes, 2);
+    return (F64)temp_u16;
+  }
+  else if (type == 's')
+  {
+    I16 temp_i16;
+    memcpy(&temp_i16, bytes, 2);
+    return (F64)temp_i16;
+  }
+  return 0;
+}
+
+static U32 get_binary_size(CHAR type)
+{
+  switch (type)
+  {
+  case 'd':
+    return 8;
+  case 'f':
+  case 'I':
+  case 'i':
+    return 4;
+  case 'S':
+  case 's':
+    return 2;
+  default:
+    return 1;
+  }
+}
+
+BOOL LASreaderPLY::init_binary_layout()
+{
+  U32 i;
+  binary_record_size = 0;
+  for (i = 0; type_string[i]; i++)
+  {
+    binary_offsets[i] = (U16)binary_record_size;
+    binary_record_size += get_binary_size(type_string[i]);
+  }
+  if (binary_record_size == 0)
+  {
+    return FALSE;
+  }
+  binary_remaining = npoints;
+  binary_block_vertices = LAS_PLY_BLOCK_SIZE / binary_record_size;
+  if (binary_block_vertices == 0) binary_block_vertices = 1;
+  binary_block_count = 0;
+  binary_block_next = 0;
+  if (binary_block) free(binary_block);
+  binary_block = (U8*)malloc((size_t)binary_block_vertices*binary_record_size);
+  if (binary_block == 0)
+  {
+    binary_record_size = 0;
+    return FALSE;
+  }
+  return TRUE;
+}
+
+// reads the next block of whole vertices and returns how many
+U32 LASreaderPLY::read_binary_block(U8* block)
+{
+  U32 count = binary_block_vertices;
+  if (count > binary_remaining) count = (U32)binary_remaining;
+  if (count == 0) return 0;
+  count = (U32)fread(block, binary_record_size, count, file);
+  binary_remaining -= count;
+  return count;
+}
+
 BOOL LASreaderPLY::read_binary_point()
+{
+  if (threads)
+  {
+    return read_threaded();
+  }
+  if (binary_record_size)
+  {
+    if (binary_block_next == binary_block_count)
+    {
+      binary_block_count = read_binary_block(binary_block);
+      binary_block_next = 0;
+      if (binary_block_count == 0)
+      {
+        return FALSE;
+      }
+    }
+    decode_binary_point(binary_block + (size_t)binary_block_next*binary_record_size);
+    binary_block_next++;
+    return TRUE;
+  }
+  return decode_binary_point(0);
+}
+
+// maps the properties of one vertex to the point either from the record
+// with the precomputed offsets or, without record, from the stream
+BOOL LASreaderPLY::decode_binary_point(const U8* record)
 {
   const CHAR* p = parse_string;
   const CHAR* t = type_string;
+  const U16* o = binary_offsets;
 
   F64 value;
 
   while (p[0])
   {
-    value = read_binary_value(t[0]);
+    value = (record ? get_binary_value(t[0], record + o[0]) : read_binary_value(t[0]));
     if (p[0] == 'x') // we expect the x coordinate
     {
       point.coordinates[0] = value;
@@ -1140,19 +1380,19 @@ BOOL LASreaderPLY::read_binary_point()
     {
       if (translate_intensity != 0.0f) value = value+translate_intensity;
       if (scale_intensity != 1.0f) value = value*scale_intensity;
-      if (value < 0.0 || value >= 65535.5) LASMessage(LAS_WARNING, "intensity %g is out of range of unsigned short", value);
+      if (value < 0.0 || value >= 65535.5) message(LAS_WARNING, "intensity %g is out of range of unsigned short", value);
       point.set_intensity(U16_QUANTIZE(value));
     }
     else if (p[0] == 'n') // we expect the number of returns of given pulse
     {
       if (point_type > 5)
       {
-        if ((value < 0) || (value > 15)) LASMessage(LAS_WARNING, "number of returns of given pulse %g is out of range of four bits", value);
+        if ((value < 0) || (value > 15)) message(LAS_WARNING, "number of returns of given pulse %g is out of range of four bits", value);
         point.set_extended_number_of_returns(U8_QUANTIZE(value) & 15);
       }
       else
       {
-        if ((value < 0) || (value > 7)) LASMessage(LAS_WARNING, "number of returns of given pulse %g is out of range of three bits", value);
+        if ((value < 0) || (value > 7)) message(LAS_WARNING, "number of returns of given pulse %g is out of range of three bits", value);
         point.set_number_of_returns(U8_QUANTIZE(value) & 7);
       }
     }
@@ -1160,12 +1400,12 @@ BOOL LASreaderPLY::read_binary_point()
     {
       if (point_type > 5)
       {
-        if ((value < 0) || (value > 15)) LASMessage(LAS_WARNING, "return number %g is out of range of four bits", value);
+        if ((value < 0) || (value > 15)) message(LAS_WARNING, "return number %g is out of range of four bits", value);
         point.set_extended_return_number(U8_QUANTIZE(value) & 15);
       }
       else
       {
-        if ((value < 0) || (value > 7)) LASMessage(LAS_WARNING, "return number %g is out of range of three bits", value);
+        if ((value < 0) || (value > 7)) message(LAS_WARNING, "return number %g is out of range of three bits", value);
         point.set_return_number(U8_QUANTIZE(value) & 7);
       }
     }
@@ -1173,23 +1413,23 @@ BOOL LASreaderPLY::read_binary_point()
     {
       if (point_type > 5)
       {
-        if ((value < 0) || (value > 255)) LASMessage(LAS_WARNING, "classification %g is out of range of eight bits", value);
+        if ((value < 0) || (value > 255)) message(LAS_WARNING, "classification %g is out of range of eight bits", value);
         point.set_extended_classification(U8_QUANTIZE(value));
       }
       else
       {
-        if ((value < 0) || (value > 31)) LASMessage(LAS_WARNING, "classification %g is out of range of five bits", value);
+        if ((value < 0) || (value > 31)) message(LAS_WARNING, "classification %g is out of range of five bits", value);
         point.set_classification(U8_QUANTIZE(value) & 31);
       }
     }
     else if (p[0] == 'u') // we expect the user data
     {
-      if ((value < 0) || (value > 255)) LASMessage(LAS_WARNING, "user data %g is out of range of eight bits", value);
+      if ((value < 0) || (value > 255)) message(LAS_WARNING, "user data %g is out of range of eight bits", value);
       point.set_user_data(U8_QUANTIZE(value));
     }
     else if (p[0] == 'p') // we expect the point source ID
     {
-      if ((value < 0) || (value > 65535)) LASMessage(LAS_WARNING, "point source ID %g is out of range of sixteen bits", value);
+      if ((value < 0) || (value > 65535)) message(LAS_WARNING, "point source ID %g is out of range of sixteen bits", value);
       point.set_point_source_ID(U16_QUANTIZE(value));
     }
     else if ((p[0] >= '0') && (p[0] <= '9')) // we expect attribute number 0 to 9
@@ -1214,10 +1454,237 @@ BOOL LASreaderPLY::read_binary_point()
     }
     p++;
     t++;
+    o++;
   }
   return TRUE;
 }
 
+BOOL LASreaderPLY::start_threads()
+{
+  U32 i;
+
+  if ((num_threads < 2) || (binary_record_size == 0)) return FALSE;
+
+  // a few blocks are decoded faster than threads are started
+  if (npoints < 4*(I64)binary_block_vertices) return FALSE;
+
+  threads = new LASreaderPLYthreads();
+  threads->stop = FALSE;
+  threads->end = FALSE;
+  threads->num_blocks = 2*num_threads;
+  threads->blocks = new LASreaderPLYblock[threads->num_blocks];
+  threads->record_size = LAS_PLY_POINT_STRUCT_SIZE + 3*sizeof(F64) + point.extra_bytes_number;
+  for (i = 0; i < threads->num_blocks; i++)
+  {
+    threads->blocks[i].index = U32_MAX;
+    threads->blocks[i].state = LAS_PLY_BLOCK_EMPTY;
+    threads->blocks[i].count = 0;
+    threads->blocks[i].binary = (U8*)malloc((size_t)binary_block_vertices*binary_record_size);
+    threads->blocks[i].records = (U8*)malloc((size_t)binary_block_vertices*threads->record_size);
+  }
+  threads->first = 0;
+  threads->next = 0;
+  threads->current = 0;
+  threads->current_point = 0;
+  for (i = 0; i < threads->num_blocks; i++)
+  {
+    if ((threads->blocks[i].binary == 0) || (threads->blocks[i].records == 0))
+    {
+      stop_threads();
+      return FALSE;
+    }
+  }
+
+  // each worker decodes into its own point
+  for (i = 0; i < num_threads; i++)
+  {
+    LASreaderPLY* decoder = new LASreaderPLY(opener);
+    if (!decoder->init_decoder(this))
+    {
+      delete decoder;
+      break;
+    }
+    threads->decoders.push_back(decoder);
+    threads->workers.push_back(std::thread(&LASreaderPLY::decode_blocks, this, decoder));
+  }
+
+  if (threads->workers.size() == 0)
+  {
+    stop_threads();
+    return FALSE;
+  }
+  return TRUE;
+}
+
+void LASreaderPLY::stop_threads()
+{
+  if (threads == 0) return;
+
+  U32 i;
+  {
+    std::lock_guard<std::mutex> lock(threads->mutex);
+    threads->stop = TRUE;
+  }
+  threads->block_free.notify_all();
+  for (i = 0; i < threads->workers.size(); i++)
+  {
+    threads->workers[i].join();
+  }
+  for (i = 0; i < threads->decoders.size(); i++)
+  {
+    delete threads->decoders[i];
+  }
+  for (i = 0; i < threads->num_blocks; i++)
+  {
+    if (threads->blocks[i].binary) free(threads->blocks[i].binary);
+    if (threads->blocks[i].records) free(threads->blocks[i].records);
+  }
+  delete [] threads->blocks;
+  delete threads;
+  threads = 0;
+}
+
+BOOL LASreaderPLY::read_threaded()
+{
+  LASreaderPLYblock* block = threads->current;
+
+  while ((block == 0) || (threads->current_point >= block->count))
+  {
+    std::unique_lock<std::mutex> lock(threads->mutex);
+    if (block)
+    {
+      // hand back the exhausted block and move on to the next one
+      block->state = LAS_PLY_BLOCK_EMPTY;
+      block->index = U32_MAX;
+      threads->first++;
+      threads->current = 0;
+      threads->current_point = 0;
+      threads->block_free.notify_all();
+    }
+    // wait until a worker has decoded the next block
+    block = &(threads->blocks[threads->first % threads->num_blocks]);
+    while ((block->index != threads->first) || (block->state == LAS_PLY_BLOCK_EMPTY) || (block->state == LAS_PLY_BLOCK_BUSY))
+    {
+      threads->block_done.wait(lock);
+    }
+    // the workers leave this block alone until it is handed back
+    lock.unlock();
+    for (size_t m = 0; m < block->messages.size(); m++)
+    {
+      LASMessage(block->messages[m].first, "%s", block->messages[m].second.c_str());
+    }
+    block->messages.clear();
+    // the block after the last vertex stays in place
+    if (block->state == LAS_PLY_BLOCK_EOF)
+    {
+      return FALSE;
+    }
+    threads->current = block;
+  }
+
+  U8* record = block->records + (size_t)threads->current_point*threads->record_size;
+  memcpy(&(point.X), record, LAS_PLY_POINT_STRUCT_SIZE);
+  memcpy(point.coordinates, record + LAS_PLY_POINT_STRUCT_SIZE, 3*sizeof(F64));
+  if (point.extra_bytes_number)
+  {
+    memcpy(point.extra_bytes, record + LAS_PLY_POINT_STRUCT_SIZE + 3*sizeof(F64), point.extra_bytes_number);
+  }
+  threads->current_point++;
+  return TRUE;
+}
+
+void LASreaderPLY::decode_blocks(LASreaderPLY* decoder)
+{
+  U32 i;
+
+  while (true)
+  {
+    // read the next block of vertices from the file
+    std::unique_lock<std::mutex> io_lock(threads->io);
+    std::unique_lock<std::mutex> lock(threads->mutex);
+    LASreaderPLYblock* block = &(threads->blocks[threads->next % threads->num_blocks]);
+    while (!threads->stop && (threads->end || (block->state != LAS_PLY_BLOCK_EMPTY)))
+    {
+      threads->block_free.wait(lock);
+    }
+    if (threads->stop) return;
+    block->index = threads->next;
+    block->state = LAS_PLY_BLOCK_BUSY;
+    block->messages.clear();
+    threads->next++;
+    lock.unlock();
+
+    block->count = read_binary_block(block->binary);
+    if (block->count == 0)
+    {
+      lock.lock();
+      block->state = LAS_PLY_BLOCK_EOF;
+      threads->end = TRUE;
+      threads->block_done.notify_all();
+      continue;
+    }
+    io_lock.unlock();
+
+    // decode the vertices into points for the reader
+    decoder->decoding = block;
+    LASpoint* point = &(decoder->point);
+    for (i = 0; i < block->count; i++)
+    {
+      decoder->decode_binary_point(block->binary + (size_t)i*binary_record_size);
+      U8* record = block->records + (size_t)i*threads->record_size;
+      memcpy(record, &(point->X), LAS_PLY_POINT_STRUCT_SIZE);
+      memcpy(record + LAS_PLY_POINT_STRUCT_SIZE, point->coordinates, 3*sizeof(F64));
+      if (point->extra_bytes_number)
+      {
+        memcpy(record + LAS_PLY_POINT_STRUCT_SIZE + 3*sizeof(F64), point->extra_bytes, point->extra_bytes_number);
+      }
+    }
+
+    lock.lock();
+    block->state = LAS_PLY_BLOCK_READY;
+    threads->block_done.notify_all();
+  }
+}
+
+// a decoding thread keeps its messages with the block it decodes because only
+// the thread that reads the points may emit them (in the order of the vertices)
+void LASreaderPLY::message(LAS_MESSAGE_TYPE type, const CHAR* fmt, ...)
+{
+  CHAR buffer[LAS_MAX_MESSAGE_LENGTH];
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(buffer, LAS_MAX_MESSAGE_LENGTH, fmt, args);
+  va_end(args);
+  if (decoding)
+  {
+    decoding->messages.push_back(std::make_pair(type, std::string(buffer)));
+  }
+  else
+  {
+    LASMessage(type, "%s", buffer);
+  }
+}
+
+// sets up a reader that only decodes vertices the same way as 'reader' does
+BOOL LASreaderPLY::init_decoder(const LASreaderPLY* reader)
+{
+  parse_string = LASCopyString(reader->parse_string);
+  type_string = LASCopyString(reader->type_string);
+  memcpy(binary_offsets, reader->binary_offsets, sizeof(binary_offsets));
+  point_type = reader->point_type;
+  translate_intensity = reader->translate_intensity;
+  scale_intensity = reader->scale_intensity;
+  if (reader->header.number_attributes)
+  {
+    memcpy(attribute_pre_scales, reader->attribute_pre_scales, sizeof(F64)*reader->header.number_attributes);
+    memcpy(attribute_pre_offsets, reader->attribute_pre_offsets, sizeof(F64)*reader->header.number_attributes);
+    if (!header.init_attributes(reader->header.number_attributes, reader->header.attributes)) return FALSE;
+  }
+  header.point_data_format = reader->header.point_data_format;
+  header.point_data_record_length = reader->header.point_data_record_length;
+  return point.init(&header, header.point_data_format, header.point_data_record_length, &header);
+}
+
 BOOL LASreaderPLY::parse_attribute(const char* l, I32 index)
 {
   F64 temp_d;
@@ -1556,6 +2023,7 @@ BOOL LASreaderPLY::parse(const char* parse_string)
 BOOL LASreaderPLY::parse_header()
 {
   BOOL skip_remaining = FALSE;
+  BOOL little_endian = FALSE;
   CHAR line[512];
   U32 items = 0;
   U32 offset = 0;
@@ -1575,6 +2043,7 @@ BOOL LASreaderPLY::parse_header()
   type_string = (CHAR*)malloc(64);
   memset(parse_string, 0, 64);
   memset(type_string, 0, 64);
+  binary_record_size = 0;
 
   // remaining header lines describing file
 
@@ -1596,6 +2065,7 @@ BOOL LASreaderPLY::parse_header()
       if (strncmp(&line[7], "binary_little_endian", 20) == 0)
       {
         streamin = new ByteStreamInFileLE(file);
+        little_endian = TRUE;
       }
       else if (strncmp(&line[7], "binary_big_endian", 18) == 0)
       {
@@ -1861,6 +2331,14 @@ BOOL LASreaderPLY::parse_header()
     LASMessage(LAS_VERBOSE, "parsed: %s", line);
   }
 
+  // little endian vertices have a fixed layout and are read in blocks
+
+  if (little_endian && !init_binary_layout())
+  {
+    laserrorm("cannot allocate block of binary vertices");
+    return FALSE;
+  }
+
   return TRUE;
 }
 
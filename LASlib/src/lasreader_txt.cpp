@@ -33,15 +33,241 @@
 #include "lasmessage.hpp"
 #include "lastransform.hpp"
 
+#include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
 extern "C" FILE * fopen_compressed(const char* filename, const char* mode, bool* piped);
 
+// the text is handed to the parsing threads in blocks of whole lines
+#define LAS_TXT_BLOCK_SIZE (4 * LAS_TOOLS_IO_IBUFFER_SIZE)
+
+// the parsed fields of a point from X up to and including rgb[4]
+#define LAS_TXT_POINT_STRUCT_SIZE 48
+
+// states of a block of text used for multi-threaded parsing
+#define LAS_TXT_BLOCK_EMPTY 0
+#define LAS_TXT_BLOCK_BUSY  1
+#define LAS_TXT_BLOCK_READY 2
+#define LAS_TXT_BLOCK_EOF   3
+
+class LASreaderTXTblock
+{
+public:
+  U32 index;
+  U32 state;
+  U32 length;
+  CHAR* text;
+  U32 count;
+  U32 allocated;
+  U8* records;
+  // the messages of parsing the block that the reader emits in block order
+  std::vector< std::pair<LAS_MESSAGE_TYPE, std::string> > messages;
+};
+
+class LASreaderTXTthreads
+{
+public:
+  std::vector<std::thread> workers;
+  std::vector<LASreaderTXT*> parsers;
+  // guards the blocks and the window of blocks being parsed
+  std::mutex mutex;
+  std::condition_variable block_done;
+  std::condition_variable block_free;
+  // serializes cutting the blocks out of the shared file in input order
+  std::mutex io;
+  BOOL stop;
+  BOOL end;
+  const CHAR* parse_string;
+  const CHAR* parse_string_unparsed;
+  // the populate pass only counts and bounds the points of each block
+  BOOL populate;
+  U32 num_blocks;
+  LASreaderTXTblock* blocks;
+  // the block that is currently handed out is 'first' and the workers
+  // parse ahead up to 'num_blocks' blocks in the window that follows
+  U32 first;
+  U32 next;
+  LASreaderTXTblock* current;
+  U32 current_point;
+  // the incomplete last line of the most recently cut block
+  CHAR* carry;
+  U32 carry_length;
+  // layout of one parsed point inside the blocks
+  U32 record_size;
+};
+
+// the powers of ten that are exact in double and in float precision
+static const F64 las_exact_powers_of_ten[23] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+static const F32 las_exact_powers_of_ten_f[11] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+// splits a plain decimal number like '-123.456e2' into sign, up to 19 significant
+// digits, and a power of ten without involving the locale. returns the end of the
+// number or 0 when the text needs the full strtod() treatment (no digits, more
+// digits, hexadecimal, infinity, nan, or an unusual exponent).
+static inline const CHAR* las_scan_decimal(const CHAR* s, BOOL* negative, U64* mantissa, I32* exponent)
+{
+  I32 digits = 0;
+  BOOL any = FALSE;
+  *negative = FALSE;
+  *mantissa = 0;
+  *exponent = 0;
+  if (s[0] == '-')
+  {
+    *negative = TRUE;
+    s++;
+  }
+  else if (s[0] == '+')
+  {
+    s++;
+  }
+  while ((s[0] >= '0') && (s[0] <= '9'))
+  {
+    if (digits == 19) return 0;
+    *mantissa = 10 * (*mantissa) + (U64)(s[0] - '0');
+    if (*mantissa) digits++;
+    any = TRUE;
+    s++;
+  }
+  if (s[0] == '.')
+  {
+    s++;
+    while ((s[0] >= '0') && (s[0] <= '9'))
+    {
+      if (digits == 19) return 0;
+      *mantissa = 10 * (*mantissa) + (U64)(s[0] - '0');
+      if (*mantissa) digits++;
+      (*exponent)--;
+      any = TRUE;
+      s++;
+    }
+  }
+  if (!any) return 0;
+  if ((s[0] == 'e') || (s[0] == 'E'))
+  {
+    const CHAR* e = s + 1;
+    BOOL negative_exponent = FALSE;
+    if (e[0] == '-')
+    {
+      negative_exponent = TRUE;
+      e++;
+    }
+    else if (e[0] == '+')
+    {
+      e++;
+    }
+    if ((e[0] < '0') || (e[0] > '9')) return 0;
+    I32 value = 0;
+    while ((e[0] >= '0') && (e[0] <= '9'))
+    {
+      if (value > 9999) return 0;
+      value = 10 * value + (I32)(e[0] - '0');
+      e++;
+    }
+    *exponent += (negative_exponent ? -value : value);
+    s = e;
+  }
+  else if ((s[0] == 'x') || (s[0] == 'X'))
+  {
+    return 0;
+  }
+  return s;
+}
+
+// same result as sscanf(s, "%lf", value) but without scanf overhead. mantissas of
+// at most 53 bits times or divided by exact powers of ten round correctly in one
+// operation. all other numbers fall back to strtod().
+static inline const CHAR* las_parse_f64(const CHAR* s, F64* value)
+{
+  while ((s[0] == ' ') || ((s[0] >= '\t') && (s[0] <= '\r'))) s++;
+  BOOL negative;
+  U64 mantissa;
+  I32 exponent;
+  const CHAR* end = las_scan_decimal(s, &negative, &mantissa, &exponent);
+  if (end && (mantissa <= ((U64)1 << 53)) && (exponent >= -22) && (exponent <= 22))
+  {
+    F64 result = (F64)mantissa;
+    if (exponent < 0) result /= las_exact_powers_of_ten[-exponent];
+    else if (exponent > 0) result *= las_exact_powers_of_ten[exponent];
+    *value = (negative ? -result : result);
+    return end;
+  }
+  CHAR* strtod_end;
+  F64 result = strtod(s, &strtod_end);
+  if (strtod_end == s) return 0;
+  *value = result;
+  return strtod_end;
+}
+
+// same result as sscanf(s, "%f", value)
+static inline const CHAR* las_parse_f32(const CHAR* s, F32* value)
+{
+  while ((s[0] == ' ') || ((s[0] >= '\t') && (s[0] <= '\r'))) s++;
+  BOOL negative;
+  U64 mantissa;
+  I32 exponent;
+  const CHAR* end = las_scan_decimal(s, &negative, &mantissa, &exponent);
+  if (end && (mantissa <= ((U64)1 << 24)) && (exponent >= -10) && (exponent <= 10))
+  {
+    F32 result = (F32)mantissa;
+    if (exponent < 0) result /= las_exact_powers_of_ten_f[-exponent];
+    else if (exponent > 0) result *= las_exact_powers_of_ten_f[exponent];
+    *value = (negative ? -result : result);
+    return end;
+  }
+  CHAR* strtof_end;
+  F32 result = strtof(s, &strtof_end);
+  if (strtof_end == s) return 0;
+  *value = result;
+  return strtof_end;
+}
+
+// same result as sscanf(s, "%d", value) for numbers with up to nine digits
+static inline const CHAR* las_parse_i32(const CHAR* s, I32* value)
+{
+  while ((s[0] == ' ') || ((s[0] >= '\t') && (s[0] <= '\r'))) s++;
+  const CHAR* d = s;
+  BOOL negative = FALSE;
+  if (d[0] == '-')
+  {
+    negative = TRUE;
+    d++;
+  }
+  else if (d[0] == '+')
+  {
+    d++;
+  }
+  if ((d[0] < '0') || (d[0] > '9')) return 0;
+  I32 result = 0;
+  I32 digits = 0;
+  while ((d[0] >= '0') && (d[0] <= '9'))
+  {
+    if (digits == 9)
+    {
+      // leave overflow handling to the library
+      if (sscanf(s, "%d", value) != 1) return 0;
+      while ((d[0] >= '0') && (d[0] <= '9')) d++;
+      return d;
+    }
+    result = 10 * result + (I32)(d[0] - '0');
+    if (result) digits++;
+    d++;
+  }
+  *value = (negative ? -result : result);
+  return d;
+}
+
 BOOL LASreaderTXT::open(const CHAR* file_name, U8 point_type, const CHAR* parse_string, I32 skip_lines, BOOL populate_header)
 {
   if (file_name == 0)
@@ -81,6 +307,7 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
   header.clean();
   // set the file pointer
   this->file = file;
+  block_start = block_end = 0;
   // add attributes in extra bytes
   if (number_attributes)
   {
@@ -541,9 +768,39 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
       }
     }
 
-    // loop over the remaining lines
+    // maybe parse the remaining lines in parallel
 
-    while (fgets(line, 512, file))
+    if (start_threads(parse_less, TRUE))
+    {
+      // the blocks carry no points and only need to be handed back
+      while (read_threaded());
+      // merge what the threads have counted and bounded
+      for (U32 t = 0; t < threads->parsers.size(); t++)
+      {
+        LASreaderTXT* parser = threads->parsers[t];
+        if (parser->npoints == 0) continue;
+        npoints += parser->npoints;
+        for (i = 0; i < 15; i++)
+        {
+          header.extended_number_of_points_by_return[i] += parser->header.extended_number_of_points_by_return[i];
+        }
+        if (parser->header.min_x < header.min_x) header.min_x = parser->header.min_x;
+        if (parser->header.max_x > header.max_x) header.max_x = parser->header.max_x;
+        if (parser->header.min_y < header.min_y) header.min_y = parser->header.min_y;
+        if (parser->header.max_y > header.max_y) header.max_y = parser->header.max_y;
+        if (parser->header.min_z < header.min_z) header.min_z = parser->header.min_z;
+        if (parser->header.max_z > header.max_z) header.max_z = parser->header.max_z;
+        for (i = 0; i < number_attributes; i++)
+        {
+          header.attributes[i].update_min_max(&(parser->header.attributes[i]));
+        }
+      }
+      stop_threads();
+    }
+
+    // loop over the remaining lines (none are left after the parallel pass)
+
+    while (get_line())
     {
       if (parse(parse_less))
       {
@@ -638,6 +895,7 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
 
     // reopen input file for the second pass
 
+    block_start = block_end = 0;
     file = fopen_compressed(file_name, "r", &piped);
     if (file == 0)
     {
@@ -1014,6 +1272,11 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
 
     populate_scale_and_offset();
   }
+
+  // maybe parse the remaining lines in parallel
+
+  start_threads(this->parse_string, FALSE);
+
   p_idx = 0;
   p_cnt = 0;
   return TRUE;
@@ -1098,6 +1361,11 @@ void LASreaderTXT::set_offset(const F64* offset)
   }
 }
 
+void LASreaderTXT::set_threads(U32 num_threads)
+{
+  this->num_threads = num_threads;
+}
+
 void LASreaderTXT::add_attribute(I32 data_type, const char* name, const char* description, F64 scale, F64 offset, F64 pre_scale, F64 pre_offset, F64 no_data)
 {
   attributes_data_types[number_attributes] = data_type;
@@ -1137,7 +1405,9 @@ BOOL LASreaderTXT::seek(const I64 p_index)
   else if (p_index < p_idx)
   {
     if (piped) return FALSE;
+    stop_threads();
     fseek(file, 0, SEEK_SET);
+    block_start = block_end = 0;
     // skip lines if we have to
     int i;
     for (i = 0; i < skip_lines; i++) fgets(line, 512, file);
@@ -1167,6 +1437,7 @@ BOOL LASreaderTXT::seek(const I64 p_index)
       this->parse_string = 0;
       return FALSE;
     }
+    start_threads(this->parse_string, FALSE);
     delta = (U32)p_index;
   }
   while (delta)
@@ -1184,9 +1455,10 @@ BOOL LASreaderTXT::read_point_default()
   {
     while (true)
     {
-      if (fgets(line, 512, file))
+      // the threads hand out points that they have already parsed
+      if (threads ? read_threaded() : get_line())
       {
-        if (parse(parse_string))
+        if (threads || parse(parse_string))
         {
           break;
         }
@@ -1284,6 +1556,371 @@ BOOL LASreaderTXT::read_point_default()
   return TRUE;
 }
 
+// like fgets(line, 512, file) but the lines are cut out of large blocks with memchr()
+BOOL LASreaderTXT::get_line()
+{
+  if (block == 0)
+  {
+    block = (CHAR*)malloc(LAS_TOOLS_IO_IBUFFER_SIZE);
+    if (block == 0) return (fgets(line, 512, file) != 0);
+    block_start = block_end = 0;
+  }
+  U32 length = 0;
+  while (true)
+  {
+    if (block_start == block_end)
+    {
+      block_start = 0;
+      block_end = (U32)fread(block, 1, LAS_TOOLS_IO_IBUFFER_SIZE, file);
+      if (block_end == 0)
+      {
+        line[length] = '\0';
+        return (length != 0);
+      }
+    }
+    U32 number = block_end - block_start;
+    if (number > (511 - length)) number = 511 - length;
+    const CHAR* newline = (const CHAR*)memchr(block + block_start, '\n', number);
+    if (newline) number = (U32)(newline - (block + block_start)) + 1;
+    memcpy(line + length, block + block_start, number);
+    length += number;
+    block_start += number;
+    if (newline || (length == 511))
+    {
+      line[length] = '\0';
+      return TRUE;
+    }
+  }
+}
+
+BOOL LASreaderTXT::start_threads(const CHAR* parse_string, BOOL populate)
+{
+  U32 i;
+
+  if (num_threads < 2) return FALSE;
+
+  threads = new LASreaderTXTthreads();
+  threads->stop = FALSE;
+  threads->end = FALSE;
+  threads->parse_string = parse_string;
+  threads->parse_string_unparsed = (populate ? parse_string : parse_string_unparsed);
+  threads->populate = populate;
+  threads->num_blocks = 2*num_threads;
+  threads->blocks = new LASreaderTXTblock[threads->num_blocks];
+  for (i = 0; i < threads->num_blocks; i++)
+  {
+    threads->blocks[i].index = U32_MAX;
+    threads->blocks[i].state = LAS_TXT_BLOCK_EMPTY;
+    threads->blocks[i].length = 0;
+    threads->blocks[i].text = 0;
+    threads->blocks[i].count = 0;
+    threads->blocks[i].allocated = 0;
+    threads->blocks[i].records = 0;
+  }
+  threads->first = 0;
+  threads->next = 0;
+  threads->current = 0;
+  threads->current_point = 0;
+  threads->carry = (CHAR*)malloc(LAS_TXT_BLOCK_SIZE);
+  threads->carry_length = 0;
+  threads->record_size = LAS_TXT_POINT_STRUCT_SIZE + 3*sizeof(F64) + point.extra_bytes_number;
+  if (threads->carry == 0)
+  {
+    stop_threads();
+    return FALSE;
+  }
+  for (i = 0; i < threads->num_blocks; i++)
+  {
+    threads->blocks[i].text = (CHAR*)malloc(LAS_TXT_BLOCK_SIZE);
+    if (threads->blocks[i].text == 0)
+    {
+      stop_threads();
+      return FALSE;
+    }
+  }
+
+  // each worker parses with its own point and its own line
+  for (i = 0; i < num_threads; i++)
+  {
+    LASreaderTXT* parser = new LASreaderTXT(opener);
+    if (!parser->init_parser(this))
+    {
+      delete parser;
+      break;
+    }
+    threads->parsers.push_back(parser);
+    threads->workers.push_back(std::thread(&LASreaderTXT::parse_blocks, this, parser));
+  }
+
+  if (threads->workers.size() == 0)
+  {
+    stop_threads();
+    return FALSE;
+  }
+  return TRUE;
+}
+
+void LASreaderTXT::stop_threads()
+{
+  if (threads == 0) return;
+
+  U32 i;
+  {
+    std::lock_guard<std::mutex> lock(threads->mutex);
+    threads->stop = TRUE;
+  }
+  threads->block_free.notify_all();
+  for (i = 0; i < threads->workers.size(); i++)
+  {
+    threads->workers[i].join();
+  }
+  for (i = 0; i < threads->parsers.size(); i++)
+  {
+    delete threads->parsers[i];
+  }
+  for (i = 0; i < threads->num_blocks; i++)
+  {
+    if (threads->blocks[i].text) free(threads->blocks[i].text);
+    if (threads->blocks[i].records) free(threads->blocks[i].records);
+  }
+  delete [] threads->blocks;
+  if (threads->carry) free(threads->carry);
+  delete threads;
+  threads = 0;
+}
+
+BOOL LASreaderTXT::read_threaded()
+{
+  LASreaderTXTblock* block = threads->current;
+
+  while ((block == 0) || (threads->current_point >= block->count))
+  {
+    std::unique_lock<std::mutex> lock(threads->mutex);
+    if (block)
+    {
+      // hand back the exhausted block and move on to the next one
+      block->state = LAS_TXT_BLOCK_EMPTY;
+      block->index = U32_MAX;
+      threads->first++;
+      threads->current = 0;
+      threads->current_point = 0;
+      threads->block_free.notify_all();
+    }
+    // wait until a worker has parsed the next block
+    block = &(threads->blocks[threads->first % threads->num_blocks]);
+    while ((block->index != threads->first) || (block->state == LAS_TXT_BLOCK_EMPTY) || (block->state == LAS_TXT_BLOCK_BUSY))
+    {
+      threads->block_done.wait(lock);
+    }
+    // the workers leave this block alone until it is handed back
+    lock.unlock();
+    for (size_t m = 0; m < block->messages.size(); m++)
+    {
+      LASMessage(block->messages[m].first, "%s", block->messages[m].second.c_str());
+    }
+    block->messages.clear();
+    // the block after the last line stays in place
+    if (block->state == LAS_TXT_BLOCK_EOF)
+    {
+      return FALSE;
+    }
+    threads->current = block;
+  }
+
+  U8* record = block->records + (size_t)threads->current_point*threads->record_size;
+  memcpy(&(point.X), record, LAS_TXT_POINT_STRUCT_SIZE);
+  memcpy(point.coordinates, record + LAS_TXT_POINT_STRUCT_SIZE, 3*sizeof(F64));
+  if (point.extra_bytes_number)
+  {
+    memcpy(point.extra_bytes, record + LAS_TXT_POINT_STRUCT_SIZE + 3*sizeof(F64), point.extra_bytes_number);
+  }
+  threads->current_point++;
+  return TRUE;
+}
+
+void LASreaderTXT::parse_blocks(LASreaderTXT* parser)
+{
+  I32 i;
+
+  while (true)
+  {
+    // cut the next block of whole lines out of the file
+    std::unique_lock<std::mutex> io_lock(threads->io);
+    std::unique_lock<std::mutex> lock(threads->mutex);
+    LASreaderTXTblock* block = &(threads->blocks[threads->next % threads->num_blocks]);
+    while (!threads->stop && (threads->end || (block->state != LAS_TXT_BLOCK_EMPTY)))
+    {
+      threads->block_free.wait(lock);
+    }
+    if (threads->stop) return;
+    block->index = threads->next;
+    block->state = LAS_TXT_BLOCK_BUSY;
+    block->count = 0;
+    block->messages.clear();
+    threads->next++;
+    lock.unlock();
+
+    U32 length = threads->carry_length;
+    memcpy(block->text, threads->carry, length);
+    length += (U32)fread(block->text + length, 1, LAS_TXT_BLOCK_SIZE - length, file);
+    threads->carry_length = 0;
+    if (length == LAS_TXT_BLOCK_SIZE)
+    {
+      // the incomplete last line goes with the next block
+      U32 cut = length;
+      while (cut && (block->text[cut - 1] != '\n')) cut--;
+      if (cut)
+      {
+        threads->carry_length = length - cut;
+        memcpy(threads->carry, block->text + cut, threads->carry_length);
+        length = cut;
+      }
+    }
+    block->length = length;
+    if (length == 0)
+    {
+      lock.lock();
+      block->state = LAS_TXT_BLOCK_EOF;
+      threads->end = TRUE;
+      threads->block_done.notify_all();
+      continue;
+    }
+    io_lock.unlock();
+
+    // parse the same lines that get_line() would cut
+    parser->parsing = block;
+    U32 state = LAS_TXT_BLOCK_READY;
+    U32 position = 0;
+    while (position < length)
+    {
+      U32 number = length - position;
+      if (number > 511) number = 511;
+      const CHAR* newline = (const CHAR*)memchr(block->text + position, '\n', number);
+      if (newline) number = (U32)(newline - (block->text + position)) + 1;
+      memcpy(parser->line, block->text + position, number);
+      parser->line[number] = '\0';
+      position += number;
+      if (!parser->parse(threads->parse_string))
+      {
+        parser->line[strlen(parser->line) - 1] = '\0';
+        parser->message(LAS_WARNING, "cannot parse '%s' with '%s'. skipping ...", parser->line, threads->parse_string_unparsed);
+        continue;
+      }
+      LASpoint* point = &(parser->point);
+      if (threads->populate)
+      {
+        // count and bound the points like the sequential populate pass
+        if (parser->npoints == 0)
+        {
+          parser->header.min_x = parser->header.max_x = point->coordinates[0];
+          parser->header.min_y = parser->header.max_y = point->coordinates[1];
+          parser->header.min_z = parser->header.max_z = point->coordinates[2];
+          for (i = 0; i < number_attributes; i++)
+          {
+            parser->header.attributes[i].set_min(point->extra_bytes + attribute_starts[i]);
+            parser->header.attributes[i].set_max(point->extra_bytes + attribute_starts[i]);
+          }
+        }
+        else
+        {
+          if (point->coordinates[0] < parser->header.min_x) parser->header.min_x = point->coordinates[0];
+          else if (point->coordinates[0] > parser->header.max_x) parser->header.max_x = point->coordinates[0];
+          if (point->coordinates[1] < parser->header.min_y) parser->header.min_y = point->coordinates[1];
+          else if (point->coordinates[1] > parser->header.max_y) parser->header.max_y = point->coordinates[1];
+          if (point->coordinates[2] < parser->header.min_z) parser->header.min_z = point->coordinates[2];
+          else if (point->coordinates[2] > parser->header.max_z) parser->header.max_z = point->coordinates[2];
+          for (i = 0; i < number_attributes; i++)
+          {
+            parser->header.attributes[i].update_min(point->extra_bytes + attribute_starts[i]);
+            parser->header.attributes[i].update_max(point->extra_bytes + attribute_starts[i]);
+          }
+        }
+        parser->npoints++;
+        if (point->extended_point_type)
+        {
+          if (point->extended_return_number >= 1 && point->extended_return_number <= 15) parser->header.extended_number_of_points_by_return[point->extended_return_number - 1]++;
+        }
+        else
+        {
+          if (point->return_number >= 1 && point->return_number <= 7) parser->header.extended_number_of_points_by_return[point->return_number - 1]++;
+        }
+        continue;
+      }
+      // store the parsed point for the reader
+      if (block->count == block->allocated)
+      {
+        U32 allocated = (block->allocated ? 2*block->allocated : 4096);
+        U8* records = (U8*)realloc(block->records, (size_t)allocated*threads->record_size);
+        if (records == 0)
+        {
+          parser->message(LAS_ERROR, "cannot allocate memory for %u parsed points", allocated);
+          state = LAS_TXT_BLOCK_EOF;
+          break;
+        }
+        block->records = records;
+        block->allocated = allocated;
+      }
+      U8* record = block->records + (size_t)block->count*threads->record_size;
+      memcpy(record, &(point->X), LAS_TXT_POINT_STRUCT_SIZE);
+      memcpy(record + LAS_TXT_POINT_STRUCT_SIZE, point->coordinates, 3*sizeof(F64));
+      if (point->extra_bytes_number)
+      {
+        memcpy(record + LAS_TXT_POINT_STRUCT_SIZE + 3*sizeof(F64), point->extra_bytes, point->extra_bytes_number);
+      }
+      block->count++;
+    }
+
+    lock.lock();
+    block->state = state;
+    if (state == LAS_TXT_BLOCK_EOF) threads->end = TRUE;
+    threads->block_done.notify_all();
+  }
+}
+
+// a parsing thread keeps its messages with the block it parses because only
+// the thread that reads the points may emit them (in the order of the lines)
+void LASreaderTXT::message(LAS_MESSAGE_TYPE type, const CHAR* fmt, ...)
+{
+  CHAR buffer[LAS_MAX_MESSAGE_LENGTH];
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(buffer, LAS_MAX_MESSAGE_LENGTH, fmt, args);
+  va_end(args);
+  if (parsing)
+  {
+    parsing->messages.push_back(std::make_pair(type, std::string(buffer)));
+  }
+  else
+  {
+    LASMessage(type, "%s", buffer);
+  }
+}
+
+// sets up a reader that only parses lines the same way as 'reader' does
+BOOL LASreaderTXT::init_parser(const LASreaderTXT* reader)
+{
+  point_type = reader->point_type;
+  translate_intensity = reader->translate_intensity;
+  scale_intensity = reader->scale_intensity;
+  translate_scan_angle = reader->translate_scan_angle;
+  scale_scan_angle = reader->scale_scan_angle;
+  number_attributes = reader->number_attributes;
+  if (number_attributes)
+  {
+    memcpy(attribute_pre_scales, reader->attribute_pre_scales, sizeof(F64)*number_attributes);
+    memcpy(attribute_pre_offsets, reader->attribute_pre_offsets, sizeof(F64)*number_attributes);
+    memcpy(attribute_starts, reader->attribute_starts, sizeof(I32)*number_attributes);
+  }
+  if (reader->header.number_attributes)
+  {
+    if (!header.init_attributes(reader->header.number_attributes, reader->header.attributes)) return FALSE;
+  }
+  header.point_data_format = reader->header.point_data_format;
+  header.point_data_record_length = reader->header.point_data_record_length;
+  npoints = 0;
+  return point.init(&header, header.point_data_format, header.point_data_record_length, &header);
+}
+
 ByteStreamIn* LASreaderTXT::get_stream() const
 {
   return 0;
@@ -1291,6 +1928,7 @@ ByteStreamIn* LASreaderTXT::get_stream() const
 
 void LASreaderTXT::close(BOOL close_stream)
 {
+  stop_threads();
   if (file)
   {
     if (piped) while (fgets(line, 512, file));
@@ -1309,6 +1947,7 @@ BOOL LASreaderTXT::reopen(const char* file_name)
     return FALSE;
   }
 
+  block_start = block_end = 0;
   file = fopen_compressed(file_name, "r", &piped);
   if (file == 0)
   {
@@ -1352,6 +1991,11 @@ BOOL LASreaderTXT::reopen(const char* file_name)
     file = 0;
     return FALSE;
   }
+
+  // maybe parse the remaining lines in parallel
+
+  start_threads(parse_string, FALSE);
+
   p_idx = 0;
   p_cnt = 0;
   return TRUE;
@@ -1359,6 +2003,7 @@ BOOL LASreaderTXT::reopen(const char* file_name)
 
 void LASreaderTXT::clean()
 {
+  stop_threads();
   if (file)
   {
     fclose(file);
@@ -1382,6 +2027,12 @@ LASreaderTXT::LASreaderTXT(LASreadOpener* opener) :LASreader(opener)
 {
   file = 0;
   piped = false;
+  block = 0;
+  block_start = 0;
+  block_end = 0;
+  num_threads = 1;
+  threads = 0;
+  parsing = 0;
   point_type = 0;
   parse_string = 0;
   parse_string_unparsed = 0;
@@ -1407,6 +2058,11 @@ LASreaderTXT::LASreaderTXT(LASreadOpener* opener) :LASreader(opener)
 LASreaderTXT::~LASreaderTXT()
 {
   clean();
+  if (block)
+  {
+    free(block);
+    block = 0;
+  }
   if (scale_factor)
   {
     delete[] scale_factor;
@@ -1426,7 +2082,7 @@ BOOL LASreaderTXT::parse_attribute(const char* lptr, I32 index)
     return FALSE;
   }
   F64 temp_d;
-  if (sscanf(lptr, "%lf", &temp_d) != 1) return FALSE;
+  if (las_parse_f64(lptr, &temp_d) == 0) return FALSE;
   if (attribute_pre_scales[index] != 1.0)
   {
     temp_d *= attribute_pre_scales[index];
@@ -1452,7 +2108,7 @@ BOOL LASreaderTXT::parse_attribute(const char* lptr, I32 index)
     }
     if (temp_i < U8_MIN || temp_i > U8_MAX)
     {
-      LASMessage(LAS_WARNING, "attribute %d of type U8 is %d. clamped to [%d %d] range.", index, temp_i, U8_MIN, U8_MAX);
+      message(LAS_WARNING, "attribute %d of type U8 is %d. clamped to [%d %d] range.", index, temp_i, U8_MIN, U8_MAX);
       point.set_attribute(attribute_starts[index], U8_CLAMP(temp_i));
     }
     else
@@ -1477,7 +2133,7 @@ BOOL LASreaderTXT::parse_attribute(const char* lptr, I32 index)
     }
     if (temp_i < I8_MIN || temp_i > I8_MAX)
     {
-      LASMessage(LAS_WARNING, "attribute %d of type I8 is %d. clamped to [%d %d] range.", index, temp_i, I8_MIN, I8_MAX);
+      message(LAS_WARNING, "attribute %d of type I8 is %d. clamped to [%d %d] range.", index, temp_i, I8_MIN, I8_MAX);
       point.set_attribute(attribute_starts[index], I8_CLAMP(temp_i));
     }
     else
@@ -1502,7 +2158,7 @@ BOOL LASreaderTXT::parse_attribute(const char* lptr, I32 index)
     }
     if (temp_i < U16_MIN || temp_i > U16_MAX)
     {
-      LASMessage(LAS_WARNING, "attribute %d of type U16 is %d. clamped to [%d %d] range.", index, temp_i, U16_MIN, U16_MAX);
+      message(LAS_WARNING, "attribute %d of type U16 is %d. clamped to [%d %d] range.", index, temp_i, U16_MIN, U16_MAX);
       point.set_attribute(attribute_starts[index], U16_CLAMP(temp_i));
     }
     else
@@ -1527,7 +2183,7 @@ BOOL LASreaderTXT::parse_attribute(const char* lptr, I32 index)
     }
     if (temp_i < I16_MIN || temp_i > I16_MAX)
     {
-      LASMessage(LAS_WARNING, "attribute %d of type I16 is %d. clamped to [%d %d] range.", index, temp_i, I16_MIN, I16_MAX);
+      message(LAS_WARNING, "attribute %d of type I16 is %d. clamped to [%d %d] range.", index, temp_i, I16_MIN, I16_MAX);
       point.set_attribute(attribute_starts[index], I16_CLAMP(temp_i));
     }
     else
@@ -1580,7 +2236,7 @@ BOOL LASreaderTXT::parse_attribute(const char* lptr, I32 index)
   }
   else
   {
-    LASMessage(LAS_WARNING, "attribute %d not (yet) implemented.", index);
+    message(LAS_WARNING, "attribute %d not (yet) implemented.", index);
     return FALSE;
   }
   return TRUE;
@@ -1821,9 +2477,9 @@ template<typename T>
 BOOL LASreaderTXT::parse_item_i(I32* out, const I32 imin, const I32 imax, const CHAR* context, T addon) {
   I32 temp_i;
   if (!skip_pre()) return FALSE;
-  if (sscanf(lptr, "%d", &temp_i) != 1) return FALSE;
+  if (las_parse_i32(lptr, &temp_i) == 0) return FALSE;
   addon();
-  if (temp_i < imin || temp_i > imax) LASMessage(LAS_WARNING, "%s %d is out of range [%d,%d]", context, temp_i, imin, imax);
+  if (temp_i < imin || temp_i > imax) message(LAS_WARNING, "%s %d is out of range [%d,%d]", context, temp_i, imin, imax);
   *out = (temp_i <= imin) ? imin : ((temp_i >= imax) ? imax : temp_i);
   skip_post();
   return TRUE;
@@ -1838,9 +2494,9 @@ BOOL LASreaderTXT::parse_item_f(F32* out, const F32 imin, const F32 imax, const
   F32 temp_f;
   if (!skip_pre()) return FALSE;
   if (lptr[0] == 0) return FALSE;
-  if (sscanf(lptr, "%f", &temp_f) != 1) return FALSE;
+  if (las_parse_f32(lptr, &temp_f) == 0) return FALSE;
   addon();
-  if (temp_f < imin || temp_f > imax) LASMessage(LAS_WARNING, "%s %f is out of range [%f,%f]", context, temp_f, imin, imax);
+  if (temp_f < imin || temp_f > imax) message(LAS_WARNING, "%s %f is out of range [%f,%f]", context, temp_f, imin, imax);
   *out = (temp_f <= imin) ? imin : ((temp_f >= imax) ? imax : temp_f);
   skip_post();
   return TRUE;
@@ -1867,25 +2523,25 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     if (p[0] == 'x') // we expect the x coordinate
     {
       if (!skip_pre()) return FALSE;
-      if (sscanf(lptr, "%lf", &(point.coordinates[0])) != 1) return FALSE;
+      if (las_parse_f64(lptr, &(point.coordinates[0])) == 0) return FALSE;
       skip_post();
     }
     else if (p[0] == 'y') // we expect the y coordinate
     {
       if (!skip_pre()) return FALSE;
-      if (sscanf(lptr, "%lf", &(point.coordinates[1])) != 1) return FALSE;
+      if (las_parse_f64(lptr, &(point.coordinates[1])) == 0) return FALSE;
       skip_post();
     }
     else if (p[0] == 'z') // we expect the x coordinate
     {
       if (!skip_pre()) return FALSE;
-      if (sscanf(lptr, "%lf", &(point.coordinates[2])) != 1) return FALSE;
+      if (las_parse_f64(lptr, &(point.coordinates[2])) == 0) return FALSE;
       skip_post();
     }
     else if (p[0] == 't') // we expect the gps time
     {
       if (!skip_pre()) return FALSE;
-      if (sscanf(lptr, "%lf", &(point.gps_time)) != 1) return FALSE;
+      if (las_parse_f64(lptr, &(point.gps_time)) == 0) return FALSE;
       skip_post();
     }
     else if (p[0] == 'R') // we expect the red channel of the RGB field
@@ -1948,15 +2604,15 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     else if (p[0] == 'n') // we expect the number of returns of given pulse
     {
       if (!skip_pre()) return FALSE;
-      if (sscanf(lptr, "%d", &temp_i) != 1) return FALSE;
+      if (las_parse_i32(lptr, &temp_i) == 0) return FALSE;
       if (point_type > 5)
       {
-        if (temp_i < 0 || temp_i > 15) LASMessage(LAS_WARNING, "number of returns of given pulse %d is out of range of four bits", temp_i);
+        if (temp_i < 0 || temp_i > 15) message(LAS_WARNING, "number of returns of given pulse %d is out of range of four bits", temp_i);
         point.set_extended_number_of_returns(temp_i & 15);
       }
       else
       {
-        if (temp_i < 0 || temp_i > 7) LASMessage(LAS_WARNING, "number of returns of given pulse %d is out of range of three bits", temp_i);
+        if (temp_i < 0 || temp_i > 7) message(LAS_WARNING, "number of returns of given pulse %d is out of range of three bits", temp_i);
         point.set_number_of_returns(temp_i & 7);
       }
       skip_post();
@@ -1964,15 +2620,15 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     else if (p[0] == 'r') // we expect the number of the return
     {
       if (!skip_pre()) return FALSE;
-      if (sscanf(lptr, "%d", &temp_i) != 1) return FALSE;
+      if (las_parse_i32(lptr, &temp_i) == 0) return FALSE;
       if (point_type > 5)
       {
-        if (temp_i < 0 || temp_i > 15) LASMessage(LAS_WARNING, "return number %d is out of range of four bits", temp_i);
+        if (temp_i < 0 || temp_i > 15) message(LAS_WARNING, "return number %d is out of range of four bits", temp_i);
         point.set_extended_return_number(temp_i & 15);
       }
       else
       {
-        if (temp_i < 0 || temp_i > 7) LASMessage(LAS_WARNING, "return number %d is out of range of three bits", temp_i);
+        if (temp_i < 0 || temp_i > 7) message(LAS_WARNING, "return number %d is out of range of three bits", temp_i);
         point.set_return_number(temp_i & 7);
       }
       skip_post();
@@ -2015,8 +2671,8 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     else if (p[0] == 'E') // we expect a terrasolid echo encoding)
     {
       if (!skip_pre()) return FALSE;
-      if (sscanf(lptr, "%d", &temp_i) != 1) return FALSE;
-      if (temp_i < 0 || temp_i > 3) LASMessage(LAS_WARNING, "terrasolid echo encoding %d is out of range of 0 to 3", temp_i);
+      if (las_parse_i32(lptr, &temp_i) == 0) return FALSE;
+      if (temp_i < 0 || temp_i > 3) message(LAS_WARNING, "terrasolid echo encoding %d is out of range of 0 to 3", temp_i);
       if (temp_i == 0) // only echo
       {
         point.number_of_returns = 1;
@@ -2042,10 +2698,10 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     else if (p[0] == 'c') // we expect the classification
     {
       if (!skip_pre()) return FALSE;
-      if (sscanf(lptr, "%d", &temp_i) != 1) return FALSE;
+      if (las_parse_i32(lptr, &temp_i) == 0) return FALSE;
       if (temp_i < 0)
       {
-        LASMessage(LAS_WARNING, "classification %d is negative. zeroing ...", temp_i);
+        message(LAS_WARNING, "classification %d is negative. zeroing ...", temp_i);
         point.set_classification(0);
         point.set_extended_classification(0);
       }
@@ -2053,7 +2709,7 @@ BOOL LASreaderTXT::parse(const char* parse_string)
       {
         if (temp_i > 255)
         {
-          LASMessage(LAS_WARNING, "extended classification %d is larger than 255. clamping ...", temp_i);
+          message(LAS_WARNING, "extended classification %d is larger than 255. clamping ...", temp_i);
           point.set_extended_classification(255);
         }
         else
@@ -2065,7 +2721,7 @@ BOOL LASreaderTXT::parse(const char* parse_string)
       {
         if (temp_i > 31)
         {
-          LASMessage(LAS_WARNING, "classification %d is larger than 31. clamping ...", temp_i);
+          message(LAS_WARNING, "classification %d is larger than 31. clamping ...", temp_i);
           point.set_classification(31);
         }
         else
@@ -32,6 +32,7 @@
 
 #include "lasfilter.hpp"
 #include "lasmessage.hpp"
+#include "laspointbatch.hpp"
 #include "lasreader.hpp"
 
 #include <math.h>
@@ -155,6 +156,42 @@ void LASoperation::set_offset_adjust_coord_without_trafo_changes(LASpoint* point
   }
 };
 
+/// Quantizes a coordinate of a batch exactly like LASquantizer::get_X() and returns 1 on an I32 overflow
+static inline U32 batch_quantize(I32& X, const F64 x, const F64 scale_factor, const F64 offset)
+{
+  I64 L;
+  if (x >= offset)
+    L = (I64)(((x - offset) / scale_factor) + 0.5);
+  else
+    L = (I64)(((x - offset) / scale_factor) - 0.5);
+  X = (I32)L;
+  return (I32_FITS_IN_RANGE(L) ? 0 : 1);
+}
+
+BOOL LASoperationTransformMatrix::can_transform(const LASpointBatch* batch) const
+{
+    return (!offset_adjust && batch->quantizer);
+}
+
+void LASoperationTransformMatrix::transform(LASpointBatch* batch)
+{
+    const LASquantizer* quantizer = batch->quantizer;
+    I32* X = batch->X;
+    I32* Y = batch->Y;
+    I32* Z = batch->Z;
+    U32 n = 0;
+    for (U32 i = 0; i < batch->count; i++)
+    {
+        F64 x = quantizer->get_x(X[i]);
+        F64 y = quantizer->get_y(Y[i]);
+        F64 z = quantizer->get_z(Z[i]);
+        n += batch_quantize(X[i], x * r11 + y * r12 + z * r13 + tr1, quantizer->x_scale_factor, quantizer->x_offset);
+        n += batch_quantize(Y[i], x * r21 + y * r22 + z * r23 + tr2, quantizer->y_scale_factor, quantizer->y_offset);
+        n += batch_quantize(Z[i], x * r31 + y * r32 + z * r33 + tr3, quantizer->z_scale_factor, quantizer->z_offset);
+    }
+    overflow += n;
+}
+
 class LASoperationTranslateX : public LASoperation
 {
    public:
@@ -193,6 +230,21 @@ class LASoperationTranslateX : public LASoperation
           }
         }
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* X = batch->X;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            n += batch_quantize(X[i], quantizer->get_x(X[i]) + offset, quantizer->x_scale_factor, quantizer->x_offset);
+        }
+        overflow += n;
+    };
     LASoperationTranslateX(F64 offset)
     {
         this->offset = offset;
@@ -237,6 +289,21 @@ class LASoperationTranslateY : public LASoperation
           }
         }
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* Y = batch->Y;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            n += batch_quantize(Y[i], quantizer->get_y(Y[i]) + offset, quantizer->y_scale_factor, quantizer->y_offset);
+        }
+        overflow += n;
+    };
     LASoperationTranslateY(F64 offset)
     {
         this->offset = offset;
@@ -286,6 +353,21 @@ class LASoperationTranslateZ : public LASoperation
           }
         }
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* Z = batch->Z;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            n += batch_quantize(Z[i], quantizer->get_z(Z[i]) + offset, quantizer->z_scale_factor, quantizer->z_offset);
+        }
+        overflow += n;
+    };
     LASoperationTranslateZ(F64 offset)
     {
         this->offset = offset;
@@ -344,6 +426,25 @@ class LASoperationTranslateXYZ : public LASoperation
           }
         }
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* X = batch->X;
+        I32* Y = batch->Y;
+        I32* Z = batch->Z;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            n += batch_quantize(X[i], quantizer->get_x(X[i]) + offset[0], quantizer->x_scale_factor, quantizer->x_offset);
+            n += batch_quantize(Y[i], quantizer->get_y(Y[i]) + offset[1], quantizer->y_scale_factor, quantizer->y_offset);
+            n += batch_quantize(Z[i], quantizer->get_z(Z[i]) + offset[2], quantizer->z_scale_factor, quantizer->z_offset);
+        }
+        overflow += n;
+    };
     LASoperationTranslateXYZ(F64 x_offset, F64 y_offset, F64 z_offset)
     {
         this->offset[0] = x_offset;
@@ -392,6 +493,21 @@ class LASoperationScaleX : public LASoperation
           }
         }
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* X = batch->X;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            n += batch_quantize(X[i], (quantizer->get_x(X[i])) * scale, quantizer->x_scale_factor, quantizer->x_offset);
+        }
+        overflow += n;
+    };
     LASoperationScaleX(F64 scale)
     {
         this->scale = scale;
@@ -437,6 +553,21 @@ class LASoperationScaleY : public LASoperation
           }
         }
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* Y = batch->Y;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            n += batch_quantize(Y[i], (quantizer->get_y(Y[i])) * scale, quantizer->y_scale_factor, quantizer->y_offset);
+        }
+        overflow += n;
+    };
     LASoperationScaleY(F64 scale)
     {
         this->scale = scale;
@@ -486,6 +617,21 @@ class LASoperationScaleZ : public LASoperation
           }
         }      
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* Z = batch->Z;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            n += batch_quantize(Z[i], (quantizer->get_z(Z[i])) * scale, quantizer->z_scale_factor, quantizer->z_offset);
+        }
+        overflow += n;
+    };
     LASoperationScaleZ(F64 scale)
     {
         this->scale = scale;
@@ -543,6 +689,25 @@ class LASoperationScaleXYZ : public LASoperation
           }
         }      
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* X = batch->X;
+        I32* Y = batch->Y;
+        I32* Z = batch->Z;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            n += batch_quantize(X[i], (quantizer->get_x(X[i])) * scale[0], quantizer->x_scale_factor, quantizer->x_offset);
+            n += batch_quantize(Y[i], (quantizer->get_y(Y[i])) * scale[1], quantizer->y_scale_factor, quantizer->y_offset);
+            n += batch_quantize(Z[i], (quantizer->get_z(Z[i])) * scale[2], quantizer->z_scale_factor, quantizer->z_offset);
+        }
+        overflow += n;
+    };
     LASoperationScaleXYZ(F64 x_scale, F64 y_scale, F64 z_scale)
     {
         this->scale[0] = x_scale;
@@ -590,6 +755,21 @@ class LASoperationTranslateThenScaleX : public LASoperation
           }
         }            
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* X = batch->X;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            n += batch_quantize(X[i], (quantizer->get_x(X[i]) + offset) * scale, quantizer->x_scale_factor, quantizer->x_offset);
+        }
+        overflow += n;
+    };
     LASoperationTranslateThenScaleX(F64 offset, F64 scale)
     {
         this->offset = offset;
@@ -637,6 +817,21 @@ class LASoperationTranslateThenScaleY : public LASoperation
           }
         }    
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* Y = batch->Y;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            n += batch_quantize(Y[i], (quantizer->get_y(Y[i]) + offset) * scale, quantizer->y_scale_factor, quantizer->y_offset);
+        }
+        overflow += n;
+    };
     LASoperationTranslateThenScaleY(F64 offset, F64 scale)
     {
         this->offset = offset;
@@ -688,6 +883,21 @@ class LASoperationTranslateThenScaleZ : public LASoperation
           }
         }  
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* Z = batch->Z;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            n += batch_quantize(Z[i], (quantizer->get_z(Z[i]) + offset) * scale, quantizer->z_scale_factor, quantizer->z_offset);
+        }
+        overflow += n;
+    };
     LASoperationTranslateThenScaleZ(F64 offset, F64 scale)
     {
         this->offset = offset;
@@ -890,6 +1100,25 @@ class LASoperationRotateXY : public LASoperation
           }
         } 
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* X = batch->X;
+        I32* Y = batch->Y;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            F64 x = quantizer->get_x(X[i]) - x_offset;
+            F64 y = quantizer->get_y(Y[i]) - y_offset;
+            n += batch_quantize(X[i], cos_angle * x - sin_angle * y + x_offset, quantizer->x_scale_factor, quantizer->x_offset);
+            n += batch_quantize(Y[i], cos_angle * y + sin_angle * x + y_offset, quantizer->y_scale_factor, quantizer->y_offset);
+        }
+        overflow += n;
+    };
     LASoperationRotateXY(F64 angle, F64 x_offset, F64 y_offset)
     {
         this->angle = angle;
@@ -1092,6 +1321,28 @@ class LASoperationTransformHelmert : public LASoperation
           }
         }
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* X = batch->X;
+        I32* Y = batch->Y;
+        I32* Z = batch->Z;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            F64 x = quantizer->get_x(X[i]);
+            F64 y = quantizer->get_y(Y[i]);
+            F64 z = quantizer->get_z(Z[i]);
+            n += batch_quantize(X[i], scale * (x - (rz_rad * y) + (ry_rad * z)) + dx, quantizer->x_scale_factor, quantizer->x_offset);
+            n += batch_quantize(Y[i], scale * ((rz_rad * x) + y - (rx_rad * z)) + dy, quantizer->y_scale_factor, quantizer->y_offset);
+            n += batch_quantize(Z[i], scale * (-(ry_rad * x) + (rx_rad * y) + z) + dz, quantizer->z_scale_factor, quantizer->z_offset);
+        }
+        overflow += n;
+    };
     LASoperationTransformHelmert(F64 dx, F64 dy, F64 dz, F64 rx, F64 ry, F64 rz, F64 m)
     {
         this->dx = dx;
@@ -1160,6 +1411,25 @@ class LASoperationTransformAffine : public LASoperation
           }
         }
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* X = batch->X;
+        I32* Y = batch->Y;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            F64 x = quantizer->get_x(X[i]);
+            F64 y = quantizer->get_y(Y[i]);
+            n += batch_quantize(X[i], r * ((cosw * x) + (sinw * y)) + tx, quantizer->x_scale_factor, quantizer->x_offset);
+            n += batch_quantize(Y[i], r * ((cosw * y) - (sinw * x)) + ty, quantizer->y_scale_factor, quantizer->y_offset);
+        }
+        overflow += n;
+    };
     LASoperationTransformAffine(F64 r, F64 w, F64 tx, F64 ty)
     {
         this->r = r;
@@ -1237,6 +1507,23 @@ class LASoperationClampZ : public LASoperation
           }
         }
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* Z = batch->Z;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            F64 z = quantizer->get_z(Z[i]);
+            if (z < below) n += batch_quantize(Z[i], below, quantizer->z_scale_factor, quantizer->z_offset);
+            else if (z > above) n += batch_quantize(Z[i], above, quantizer->z_scale_factor, quantizer->z_offset);
+        }
+        overflow += n;
+    };
     LASoperationClampZ(F64 below, F64 above)
     {
         this->below = below;
@@ -1297,6 +1584,21 @@ class LASoperationClampZbelow : public LASoperation
           }
         }
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* Z = batch->Z;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            if (quantizer->get_z(Z[i]) < below) n += batch_quantize(Z[i], below, quantizer->z_scale_factor, quantizer->z_offset);
+        }
+        overflow += n;
+    };
     LASoperationClampZbelow(F64 below)
     {
         this->below = below;
@@ -1356,6 +1658,21 @@ class LASoperationClampZabove : public LASoperation
           }
         }
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->quantizer);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        const LASquantizer* quantizer = batch->quantizer;
+        I32* Z = batch->Z;
+        U32 n = 0;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            if (quantizer->get_z(Z[i]) > above) n += batch_quantize(Z[i], above, quantizer->z_scale_factor, quantizer->z_offset);
+        }
+        overflow += n;
+    };
     LASoperationClampZabove(F64 above)
     {
         this->above = above;
@@ -1404,6 +1721,20 @@ class LASoperationClampRGBto8Bit : public LASoperation
         if (point->get_B() > 255)
             point->set_B(255);
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->rgb);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        U16* rgb = batch->rgb;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            if (rgb[4 * i] > 255) rgb[4 * i] = 255;
+            if (rgb[4 * i + 1] > 255) rgb[4 * i + 1] = 255;
+            if (rgb[4 * i + 2] > 255) rgb[4 * i + 2] = 255;
+        }
+    };
     LASoperationClampRGBto8Bit(){};
 };
 
@@ -1608,6 +1939,18 @@ class LASoperationTranslateRawX : public LASoperation
           point->set_X(point->get_X() + offset);
         }
     };
+    inline BOOL can_transform(const LASpointBatch*) const
+    {
+        return !offset_adjust;
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        I32* X = batch->X;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            X[i] += offset;
+        }
+    };
     LASoperationTranslateRawX(I32 offset)
     {
         this->offset = offset;
@@ -1648,6 +1991,18 @@ class LASoperationTranslateRawY : public LASoperation
           point->set_Y(point->get_Y() + offset);
         }
     };
+    inline BOOL can_transform(const LASpointBatch*) const
+    {
+        return !offset_adjust;
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        I32* Y = batch->Y;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            Y[i] += offset;
+        }
+    };
     LASoperationTranslateRawY(I32 offset)
     {
         this->offset = offset;
@@ -1692,6 +2047,18 @@ class LASoperationTranslateRawZ : public LASoperation
           point->set_Z(point->get_Z() + offset);
         }
     };
+    inline BOOL can_transform(const LASpointBatch*) const
+    {
+        return !offset_adjust;
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        I32* Z = batch->Z;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            Z[i] += offset;
+        }
+    };
     LASoperationTranslateRawZ(I32 offset)
     {
         this->offset = offset;
@@ -1738,6 +2105,22 @@ class LASoperationTranslateRawXYZ : public LASoperation
           point->set_Z(point->get_Z() + raw_offset[2]);
         }
     };
+    inline BOOL can_transform(const LASpointBatch*) const
+    {
+        return !offset_adjust;
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        I32* X = batch->X;
+        I32* Y = batch->Y;
+        I32* Z = batch->Z;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            X[i] += raw_offset[0];
+            Y[i] += raw_offset[1];
+            Z[i] += raw_offset[2];
+        }
+    };
     LASoperationTranslateRawXYZ(I32 raw_x_offset, I32 raw_y_offset, I32 raw_z_offset)
     {
         this->raw_offset[0] = raw_x_offset;
@@ -1852,6 +2235,18 @@ class LASoperationClampRawZ : public LASoperation
           point->set_Z(above);
       }
     };
+    inline BOOL can_transform(const LASpointBatch*) const
+    {
+        return !offset_adjust;
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        I32* Z = batch->Z;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            Z[i] = (Z[i] < below ? below : (Z[i] > above ? above : Z[i]));
+        }
+    };
     LASoperationClampRawZ(I32 below, I32 above)
     {
         this->below = below;
@@ -1883,6 +2278,18 @@ class LASoperationSetIntensity : public LASoperation
 
         point->set_intensity(intensity);
     };
+    inline BOOL can_transform(const LASpointBatch*) const
+    {
+        return !offset_adjust;
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        U16* intensities = batch->intensity;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            intensities[i] = intensity;
+        }
+    };
     LASoperationSetIntensity(U16 intensity)
     {
         this->intensity = intensity;
@@ -1918,6 +2325,19 @@ class LASoperationScaleIntensity : public LASoperation
         F32 intensity = scale * point->get_intensity();
         point->set_intensity(U16_CLAMP(intensity));
     };
+    inline BOOL can_transform(const LASpointBatch*) const
+    {
+        return !offset_adjust;
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        U16* intensity = batch->intensity;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            F32 value = scale * intensity[i];
+            intensity[i] = U16_CLAMP(value);
+        }
+    };
     LASoperationScaleIntensity(F32 scale)
     {
         this->scale = scale;
@@ -1953,6 +2373,19 @@ class LASoperationTranslateIntensity : public LASoperation
         F32 intensity = offset + point->get_intensity();
         point->set_intensity(U16_CLAMP(intensity));
     };
+    inline BOOL can_transform(const LASpointBatch*) const
+    {
+        return !offset_adjust;
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        U16* intensity = batch->intensity;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            F32 value = offset + intensity[i];
+            intensity[i] = U16_CLAMP(value);
+        }
+    };
     LASoperationTranslateIntensity(F32 offset)
     {
         this->offset = offset;
@@ -1988,6 +2421,19 @@ class LASoperationTranslateThenScaleIntensity : public LASoperation
         F32 intensity = (offset + point->get_intensity()) * scale;
         point->set_intensity(U16_CLAMP(intensity));
     };
+    inline BOOL can_transform(const LASpointBatch*) const
+    {
+        return !offset_adjust;
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        U16* intensity = batch->intensity;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            F32 value = (offset + intensity[i]) * scale;
+            intensity[i] = U16_CLAMP(value);
+        }
+    };
     LASoperationTranslateThenScaleIntensity(F32 offset, F32 scale)
     {
         this->offset = offset;
@@ -2027,6 +2473,18 @@ class LASoperationClampIntensity : public LASoperation
         else if (point->get_intensity() < below)
             point->set_intensity(below);
     };
+    inline BOOL can_transform(const LASpointBatch*) const
+    {
+        return !offset_adjust;
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        U16* intensity = batch->intensity;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            intensity[i] = (intensity[i] > above ? above : (intensity[i] < below ? below : intensity[i]));
+        }
+    };
     LASoperationClampIntensity(U16 below, U16 above)
     {
         this->below = below;
@@ -2064,6 +2522,18 @@ class LASoperationClampIntensityBelow : public LASoperation
         if (point->get_intensity() < below)
             point->set_intensity(below);
     };
+    inline BOOL can_transform(const LASpointBatch*) const
+    {
+        return !offset_adjust;
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        U16* intensity = batch->intensity;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            if (intensity[i] < below) intensity[i] = below;
+        }
+    };
     LASoperationClampIntensityBelow(U16 below)
     {
         this->below = below;
@@ -2099,6 +2569,18 @@ class LASoperationClampIntensityAbove : public LASoperation
         if (point->get_intensity() > above)
             point->set_intensity(above);
     };
+    inline BOOL can_transform(const LASpointBatch*) const
+    {
+        return !offset_adjust;
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        U16* intensity = batch->intensity;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            if (intensity[i] > above) intensity[i] = above;
+        }
+    };
     LASoperationClampIntensityAbove(U16 above)
     {
         this->above = above;
@@ -4918,6 +5400,20 @@ class LASoperationSetRGB : public LASoperation
 
         point->set_RGB(RGB);
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->rgb);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        U16* rgb = batch->rgb;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            rgb[4 * i] = RGB[0];
+            rgb[4 * i + 1] = RGB[1];
+            rgb[4 * i + 2] = RGB[2];
+        }
+    };
     LASoperationSetRGB(U16 R, U16 G, U16 B)
     {
         RGB[0] = R;
@@ -5064,6 +5560,20 @@ class LASoperationScaleRGB : public LASoperation
         point->rgb[1] = U16_CLAMP(scale[1] * point->rgb[1]);
         point->rgb[2] = U16_CLAMP(scale[2] * point->rgb[2]);
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->rgb);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        U16* rgb = batch->rgb;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            rgb[4 * i] = U16_CLAMP(scale[0] * rgb[4 * i]);
+            rgb[4 * i + 1] = U16_CLAMP(scale[1] * rgb[4 * i + 1]);
+            rgb[4 * i + 2] = U16_CLAMP(scale[2] * rgb[4 * i + 2]);
+        }
+    };
     LASoperationScaleRGB(F32 scale_R, F32 scale_G, F32 scale_B)
     {
         scale[0] = scale_R;
@@ -5102,6 +5612,20 @@ class LASoperationScaleRGBdown : public LASoperation
         point->rgb[1] = point->rgb[1] / 256;
         point->rgb[2] = point->rgb[2] / 256;
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->rgb);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        U16* rgb = batch->rgb;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            rgb[4 * i] = rgb[4 * i] / 256;
+            rgb[4 * i + 1] = rgb[4 * i + 1] / 256;
+            rgb[4 * i + 2] = rgb[4 * i + 2] / 256;
+        }
+    };
 };
 
 class LASoperationScaleRGBup : public LASoperation
@@ -5131,6 +5655,20 @@ class LASoperationScaleRGBup : public LASoperation
         point->rgb[1] = point->rgb[1] * 256;
         point->rgb[2] = point->rgb[2] * 256;
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->rgb);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        U16* rgb = batch->rgb;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            rgb[4 * i] = rgb[4 * i] * 256;
+            rgb[4 * i + 1] = rgb[4 * i + 1] * 256;
+            rgb[4 * i + 2] = rgb[4 * i + 2] * 256;
+        }
+    };
 };
 
 class LASoperationScaleRGBto8bit : public LASoperation
@@ -5163,6 +5701,23 @@ class LASoperationScaleRGBto8bit : public LASoperation
             point->rgb[2] = point->rgb[2] / 256;
         }
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->rgb);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        U16* rgb = batch->rgb;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            if ((rgb[4 * i] > 255) || (rgb[4 * i + 1] > 255) || (rgb[4 * i + 2] > 255))
+            {
+                rgb[4 * i] = rgb[4 * i] / 256;
+                rgb[4 * i + 1] = rgb[4 * i + 1] / 256;
+                rgb[4 * i + 2] = rgb[4 * i + 2] / 256;
+            }
+        }
+    };
 };
 
 class LASoperationScaleRGBto16bit : public LASoperation
@@ -5195,6 +5750,23 @@ class LASoperationScaleRGBto16bit : public LASoperation
             point->rgb[2] = point->rgb[2] * 256;
         }
     };
+    inline BOOL can_transform(const LASpointBatch* batch) const
+    {
+        return (!offset_adjust && batch->rgb);
+    };
+    inline void transform(LASpointBatch* batch)
+    {
+        U16* rgb = batch->rgb;
+        for (U32 i = 0; i < batch->count; i++)
+        {
+            if ((rgb[4 * i] < 256) && (rgb[4 * i + 1] < 256) && (rgb[4 * i + 2] < 256))
+            {
+                rgb[4 * i] = rgb[4 * i] * 256;
+                rgb[4 * i + 1] = rgb[4 * i + 1] * 256;
+                rgb[4 * i + 2] = rgb[4 * i + 2] * 256;
+            }
+        }
+    };
 };
 
 class LASoperationScaleNIR : public LASoperation
@@ -10792,6 +11364,27 @@ void LAStransform::transform(LASpoint* point)
     }
 }
 
+BOOL LAStransform::transform(LASpointBatch* batch)
+{
+    U32 i;
+    if (filter)
+    {
+        return FALSE;
+    }
+    for (i = 0; i < num_operations; i++)
+    {
+        if (!operations[i]->can_transform(batch))
+        {
+            return FALSE;
+        }
+    }
+    for (i = 0; i < num_operations; i++)
+    {
+        operations[i]->transform(batch);
+    }
+    return TRUE;
+}
+
 void LAStransform::reset()
 {
     U32 i;
@@ -31,6 +31,7 @@
 #include "lasutility.hpp"
 
 #include "lasmessage.hpp"
+#include "laszip_decompress_selective_v3.hpp"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -1265,6 +1266,23 @@ void LAShistogram::add(const LASpoint* point)
   }
 }
 
+U32 LAShistogram::get_decompress_selective() const
+{
+  U32 decompress_selective = LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY;
+  if (z_bin || Z_bin || scan_angle_bin_z) decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_Z;
+  if (intensity_bin || classification_bin_intensity || scan_angle_bin_intensity || return_map_bin_intensity) decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
+  if (classification_bin || classification_bin_intensity || classification_bin_scan_angle) decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
+  if (scan_angle_bin || extended_scan_angle_bin || classification_bin_scan_angle || scan_angle_bin_z || scan_angle_bin_number_of_returns || scan_angle_bin_intensity) decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_SCAN_ANGLE;
+  if (user_data_bin) decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_USER_DATA;
+  if (point_source_id_bin) decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_POINT_SOURCE;
+  if (gps_time_bin) decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME;
+  if (R_bin || G_bin || B_bin) decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_RGB;
+  if (I_bin) decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_NIR;
+  if (attribute0_bin || attribute1_bin || attribute2_bin || attribute3_bin || attribute4_bin || attribute5_bin || attribute6_bin || attribute7_bin || attribute8_bin || attribute9_bin) decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_EXTRA_BYTES;
+  if (wavepacket_index_bin || wavepacket_offset_bin || wavepacket_size_bin || wavepacket_location_bin) decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_WAVEPACKET;
+  return decompress_selective;
+}
+
 void LAShistogram::report(FILE* file) const
 {
   // counter bins
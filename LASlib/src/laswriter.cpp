@@ -57,6 +57,7 @@ LASwriter* LASwriteOpener::open(const LASheader* header)
   if (use_nil)
   {
     LASwriterLAS* laswriterlas = new LASwriterLAS();
+    laswriterlas->set_compress_threads(compress_threads);
     if (!laswriterlas->open(header, (format == LAS_TOOLS_FORMAT_LAZ ? (native ? LASZIP_COMPRESSOR_LAYERED_CHUNKED : LASZIP_COMPRESSOR_CHUNKED) : LASZIP_COMPRESSOR_NONE), 2, chunk_size))
     {
       laserror("cannot open laswriterlas to NULL");
@@ -70,6 +71,7 @@ LASwriter* LASwriteOpener::open(const LASheader* header)
     if (format <= LAS_TOOLS_FORMAT_LAZ)
     {
       LASwriterLAS* laswriterlas = new LASwriterLAS();
+      laswriterlas->set_compress_threads(compress_threads);
       if (!laswriterlas->open(file_name, header, (format == LAS_TOOLS_FORMAT_LAZ ? (native ? LASZIP_COMPRESSOR_LAYERED_CHUNKED : LASZIP_COMPRESSOR_CHUNKED) : LASZIP_COMPRESSOR_NONE), 2, chunk_size, io_obuffer_size))
       {
         laserror("cannot open laswriterlas with file name '%s'", file_name);
@@ -136,6 +138,7 @@ LASwriter* LASwriteOpener::open(const LASheader* header)
     if (format <= LAS_TOOLS_FORMAT_LAZ)
     {
       LASwriterLAS* laswriterlas = new LASwriterLAS();
+      laswriterlas->set_compress_threads(compress_threads);
       if (!laswriterlas->open(stdout, header, (format == LAS_TOOLS_FORMAT_LAZ ? (native ? LASZIP_COMPRESSOR_LAYERED_CHUNKED : LASZIP_COMPRESSOR_CHUNKED) : LASZIP_COMPRESSOR_NONE), 2, chunk_size))
       {
         laserror("cannot open laswriterlas to stdout");
@@ -231,6 +234,7 @@ void LASwriteOpener::usage() const
                        "  -odix _classified (specify file name appendix)\n" \
                        "  -ocut 2 (cut the last two characters from name)\n" \
                        "  -olas -olaz -otxt -obin -oqi (specify format)\n" \
+                       "  -othreads 8 (compress LAZ chunks on 8 threads)\n" \
                        "  -stdout (pipe to stdout)\n" \
                        "  -nil    (pipe to NULL)\n", DIRECTORY_SLASH, DIRECTORY_SLASH);
 }
@@ -371,6 +375,22 @@ BOOL LASwriteOpener::parse(int argc, char* argv[])
       set_chunk_size(atoi(argv[i+1]));
       *argv[i]='\0'; *argv[i+1]='\0'; i+=1;
     }
+    else if (strcmp(argv[i],"-othreads") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        laserror("'%s' needs 1 argument: number", argv[i]);
+        return FALSE;
+      }
+      U32 number_threads;
+      if ((sscanf(argv[i+1], "%u", &number_threads) != 1) || (number_threads == 0))
+      {
+        laserror("'%s' needs 1 argument: number but '%s' is not a valid number.", argv[i], argv[i+1]);
+        return FALSE;
+      }
+      set_compress_threads(number_threads);
+      *argv[i]='\0'; *argv[i+1]='\0'; i+=1;
+    }
     else if (strcmp(argv[i],"-oparse") == 0)
     {
       if ((i+1) >= argc)
@@ -788,6 +808,11 @@ void LASwriteOpener::set_chunk_size(U32 chunk_size)
   this->chunk_size = chunk_size;
 }
 
+void LASwriteOpener::set_compress_threads(U32 compress_threads)
+{
+  this->compress_threads = compress_threads;
+}
+
 void LASwriteOpener::make_numbered_file_name(const CHAR* file_name, I32 digits)
 {
   I32 len;
@@ -1240,6 +1265,7 @@ LASwriteOpener::LASwriteOpener()
   specified = FALSE;
   force = FALSE;
   chunk_size = LASZIP_CHUNK_SIZE_DEFAULT;
+  compress_threads = 1;
   use_stdout = FALSE;
   use_nil = FALSE;
 }
@@ -210,6 +210,7 @@ BOOL LASwriterLAS::open(ByteStreamOut* stream, const LASheader* header, U32 comp
       laserror("point type %d of size %d not supported (with LASzip)", header->point_data_format, header->point_data_record_length);
       return FALSE;
     }
+    if (compress_threads > 1) writer->set_threads(compress_threads);
   }
   else
   {
@@ -1382,11 +1383,18 @@ I64 LASwriterLAS::tell()
   return stream->tell();
 }
 
+BOOL LASwriterLAS::get_chunk_table(U32* number_chunks, const U32** chunk_bytes)
+{
+  if (writer == 0) return FALSE;
+  return writer->get_chunk_table(number_chunks, chunk_bytes);
+}
+
 LASwriterLAS::LASwriterLAS()
 {
   file = 0;
   stream = 0;
   delete_stream = TRUE;
+  compress_threads = 1;
   writer = 0;
   writing_las_1_4 = FALSE;
   writing_new_point_type = FALSE;
@@ -38,7 +38,7 @@
 BOOL LASwriterTXT::refile(FILE* file)
 {
   this->file = file;
-  return TRUE;
+  return formatter.refile(file);
 }
 
 void LASwriterTXT::set_pts(BOOL pts)
@@ -256,40 +256,18 @@ BOOL LASwriterTXT::open(FILE* file, const LASheader* header, const CHAR* parse_s
     }
   }
 
-  return check_parse_string(this->parse_string);
-}
+  // the precision of the coordinates is resolved once and not for every point
+  x_decimals = lidarprecision2decimals(header->x_scale_factor);
+  y_decimals = lidarprecision2decimals(header->y_scale_factor);
+  z_decimals = lidarprecision2decimals(header->z_scale_factor);
 
-static void lidardouble2string(CHAR* string, double value)
-{
-  int len;
-  len = sprintf(string, "%.15f", value) - 1;
-  while (string[len] == '0') len--;
-  if (string[len] != '.') len++;
-  string[len] = '\0';
-}
+  if (!formatter.open(file))
+  {
+    laserror("allocating output buffer");
+    return FALSE;
+  }
 
-static void lidardouble2string(CHAR* string, double value, double precision)
-{
-  if (precision == 0.1)
-    sprintf(string, "%.1f", value);
-  else if (precision == 0.01)
-    sprintf(string, "%.2f", value);
-  else if (precision == 0.001)
-    sprintf(string, "%.3f", value);
-  else if (precision == 0.0001)
-    sprintf(string, "%.4f", value);
-  else if (precision == 0.00001)
-    sprintf(string, "%.5f", value);
-  else if (precision == 0.000001)
-    sprintf(string, "%.6f", value);
-  else if (precision == 0.0000001)
-    sprintf(string, "%.7f", value);
-  else if (precision == 0.00000001)
-    sprintf(string, "%.8f", value);
-  else if (precision == 0.000000001)
-    sprintf(string, "%.9f", value);
-  else
-    lidardouble2string(string, value);
+  return check_parse_string(this->parse_string);
 }
 
 BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
@@ -305,11 +283,11 @@ BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
     if (header->attributes[index].has_scale() || header->attributes[index].has_offset())
     {
       F64 temp_d = header->attributes[index].scale[0]*value + header->attributes[index].offset[0];
-      fprintf(file, "%g", temp_d);
+      formatter.put_g(temp_d);
     }
     else
     {
-      fprintf(file, "%d", (I32)value);
+      formatter.put_int(value);
     }
   }
   else if (header->attributes[index].data_type == 2)
@@ -319,11 +297,11 @@ BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
     if (header->attributes[index].has_scale() || header->attributes[index].has_offset())
     {
       F64 temp_d = header->attributes[index].scale[0]*value + header->attributes[index].offset[0];
-      fprintf(file, "%g", temp_d);
+      formatter.put_g(temp_d);
     }
     else
     {
-      fprintf(file, "%d", (I32)value);
+      formatter.put_int(value);
     }
   }
   else if (header->attributes[index].data_type == 3)
@@ -333,11 +311,11 @@ BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
     if (header->attributes[index].has_scale() || header->attributes[index].has_offset())
     {
       F64 temp_d = header->attributes[index].scale[0]*value + header->attributes[index].offset[0];
-      fprintf(file, "%g", temp_d);
+      formatter.put_g(temp_d);
     }
     else
     {
-      fprintf(file, "%d", (I32)value);
+      formatter.put_int(value);
     }
   }
   else if (header->attributes[index].data_type == 4)
@@ -347,11 +325,11 @@ BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
     if (header->attributes[index].has_scale() || header->attributes[index].has_offset())
     {
       F64 temp_d = header->attributes[index].scale[0]*value + header->attributes[index].offset[0];
-      fprintf(file, "%g", temp_d);
+      formatter.put_g(temp_d);
     }
     else
     {
-      fprintf(file, "%d", (I32)value);
+      formatter.put_int(value);
     }
   }
   else if (header->attributes[index].data_type == 5)
@@ -361,11 +339,11 @@ BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
     if (header->attributes[index].has_scale() || header->attributes[index].has_offset())
     {
       F64 temp_d = header->attributes[index].scale[0]*value + header->attributes[index].offset[0];
-      fprintf(file, "%g", temp_d);
+      formatter.put_g(temp_d);
     }
     else
     {
-      fprintf(file, "%d", (I32)value);
+      formatter.put_int((I32)value);
     }
   }
   else if (header->attributes[index].data_type == 6)
@@ -375,11 +353,11 @@ BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
     if (header->attributes[index].has_scale() || header->attributes[index].has_offset())
     {
       F64 temp_d = header->attributes[index].scale[0]*value + header->attributes[index].offset[0];
-      fprintf(file, "%g", temp_d);
+      formatter.put_g(temp_d);
     }
     else
     {
-      fprintf(file, "%d", value);
+      formatter.put_int(value);
     }
   }
   else if (header->attributes[index].data_type == 9)
@@ -389,11 +367,11 @@ BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
     if (header->attributes[index].has_scale() || header->attributes[index].has_offset())
     {
       F64 temp_d = header->attributes[index].scale[0]*value + header->attributes[index].offset[0];
-      fprintf(file, "%g", temp_d);
+      formatter.put_g(temp_d);
     }
     else
     {
-      fprintf(file, "%g", value);
+      formatter.put_g(value);
     }
   }
   else if (header->attributes[index].data_type == 10)
@@ -403,11 +381,11 @@ BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
     if (header->attributes[index].has_scale() || header->attributes[index].has_offset())
     {
       F64 temp_d = header->attributes[index].scale[0]*value + header->attributes[index].offset[0];
-      fprintf(file, "%g", temp_d);
+      formatter.put_g(temp_d);
     }
     else
     {
-      fprintf(file, "%g", value);
+      formatter.put_g(value);
     }
   }
   else
@@ -427,122 +405,122 @@ BOOL LASwriterTXT::write_point(const LASpoint* point)
     switch (parse_string[i])
     {
     case 'x': // the x coordinate
-      lidardouble2string(printstring, header->get_x(point->get_X()), header->x_scale_factor); fprintf(file, "%s", printstring);
+      formatter.put_double(header->get_x(point->get_X()), x_decimals);
       break;
     case 'y': // the y coordinate
-      lidardouble2string(printstring, header->get_y(point->get_Y()), header->y_scale_factor); fprintf(file, "%s", printstring);
+      formatter.put_double(header->get_y(point->get_Y()), y_decimals);
       break;
     case 'z': // the z coordinate
-      lidardouble2string(printstring, header->get_z(point->get_Z()), header->z_scale_factor); fprintf(file, "%s", printstring);
+      formatter.put_double(header->get_z(point->get_Z()), z_decimals);
       break;
     case 't': // the gps-time
-      fprintf(file, "%.6f", point->get_gps_time());
+      formatter.put_double(point->get_gps_time(), 6);
       break;
     case 'i': // the intensity
       if (opts)
-        fprintf(file, "%d", -2048 + point->get_intensity());
+        formatter.put_int(-2048 + point->get_intensity());
       else if (optx)
       {
         int len = snprintf(printstring, sizeof(printstring), "%.3f", 1.0f/4095.0f * point->get_intensity()) - 1;
         while (printstring[len] == '0') len--;
         if (printstring[len] != '.') len++;
         printstring[len] = '\0';
-        fprintf(file, "%s", printstring);
+        formatter.put(printstring);
       }
       else
-        fprintf(file, "%d", point->get_intensity());
+        formatter.put_int(point->get_intensity());
       break;
     case 'a': // the scan angle
-      fprintf(file, "%d", point->get_scan_angle_rank());
+      formatter.put_int(point->get_scan_angle_rank());
       break;
     case 'r': // the number of the return
-      fprintf(file, "%d", point->get_return_number());
+      formatter.put_int(point->get_return_number());
       break;
     case 'c': // the classification
 			if (header->point_data_format > 5)
 			{
 				if (point->get_extended_classification())
 				{
-      fprintf(file, "%d", point->get_extended_classification());
+      formatter.put_int(point->get_extended_classification());
 				}
 				else
 				{
-					fprintf(file, "%d", point->get_classification());
+					formatter.put_int(point->get_classification());
 				}
 			}
 			else
 			{
-				fprintf(file, "%d", point->get_classification());
+				formatter.put_int(point->get_classification());
 			}
       break;
     case 'u': // the user data
-      fprintf(file, "%d", point->get_user_data());
+      formatter.put_int(point->get_user_data());
       break;
     case 'n': // the number of returns of given pulse
-      fprintf(file, "%d", point->get_number_of_returns());
+      formatter.put_int(point->get_number_of_returns());
       break;
     case 'p': // the point source ID
-      fprintf(file, "%d", point->get_point_source_ID());
+      formatter.put_int(point->get_point_source_ID());
       break;
     case 'e': // the edge of flight line flag
-      fprintf(file, "%d", point->get_edge_of_flight_line());
+      formatter.put_int(point->get_edge_of_flight_line());
       break;
     case 'd': // the direction of scan flag
-      fprintf(file, "%d", point->get_scan_direction_flag());
+      formatter.put_int(point->get_scan_direction_flag());
       break;
     case 'h': // the withheld flag
-      fprintf(file, "%d", point->get_withheld_flag());
+      formatter.put_int(point->get_withheld_flag());
       break;
     case 'k': // the keypoint flag
-      fprintf(file, "%d", point->get_keypoint_flag());
+      formatter.put_int(point->get_keypoint_flag());
       break;
     case 'g': // the synthetic flag
-      fprintf(file, "%d", point->get_synthetic_flag());
+      formatter.put_int(point->get_synthetic_flag());
       break;
     case 'o': // the overlap flag
-      fprintf(file, "%d", point->get_extended_overlap_flag());
+      formatter.put_int(point->get_extended_overlap_flag());
       break;
     case 'l': // the scanner channel
-      fprintf(file, "%d", point->get_extended_scanner_channel());
+      formatter.put_int(point->get_extended_scanner_channel());
       break;
     case 'R': // the red channel of the RGB field
       if (scale_rgb != 1.0f)
-        fprintf(file, "%.2f", scale_rgb*point->get_R());
+        formatter.put_double(scale_rgb*point->get_R(), 2);
       else
-        fprintf(file, "%d", point->get_R());
+        formatter.put_int(point->get_R());
       break;
     case 'G': // the green channel of the RGB field
       if (scale_rgb != 1.0f)
-        fprintf(file, "%.2f", scale_rgb*point->get_G());
+        formatter.put_double(scale_rgb*point->get_G(), 2);
       else
-        fprintf(file, "%d", point->get_G());
+        formatter.put_int(point->get_G());
       break;
     case 'B': // the blue channel of the RGB field
       if (scale_rgb != 1.0f)
-        fprintf(file, "%.2f", scale_rgb*point->get_B());
+        formatter.put_double(scale_rgb*point->get_B(), 2);
       else
-        fprintf(file, "%d", point->get_B());
+        formatter.put_int(point->get_B());
       break;
     case 'm': // the index of the point (count starts at 0)
-      fprintf(file, "%lld", p_count-1);
+      formatter.put_int(p_count-1);
       break;
     case 'M': // the index of the point (count starts at 1)
-      fprintf(file, "%lld", p_count);
+      formatter.put_int(p_count);
       break;
     case 'w': // the wavepacket descriptor index
-      fprintf(file, "%d", point->wavepacket.getIndex());
+      formatter.put_int(point->wavepacket.getIndex());
       break;
     case 'W': // all wavepacket attributes
-      fprintf(file, "%d%c%d%c%d%c%g%c%.15g%c%.15g%c%.15g", point->wavepacket.getIndex(), separator_sign, (U32)point->wavepacket.getOffset(), separator_sign, point->wavepacket.getSize(), separator_sign, point->wavepacket.getLocation(), separator_sign, point->wavepacket.getXt(), separator_sign, point->wavepacket.getYt(), separator_sign, point->wavepacket.getZt());
+      formatter.printf("%d%c%d%c%d%c%g%c%.15g%c%.15g%c%.15g", point->wavepacket.getIndex(), separator_sign, (U32)point->wavepacket.getOffset(), separator_sign, point->wavepacket.getSize(), separator_sign, point->wavepacket.getLocation(), separator_sign, point->wavepacket.getXt(), separator_sign, point->wavepacket.getYt(), separator_sign, point->wavepacket.getZt());
       break;
     case 'X': // the unscaled and unoffset integer X coordinate
-      fprintf(file, "%d", point->get_X());
+      formatter.put_int(point->get_X());
       break;
     case 'Y': // the unscaled and unoffset integer Y coordinate
-      fprintf(file, "%d", point->get_Y());
+      formatter.put_int(point->get_Y());
       break;
     case 'Z': // the unscaled and unoffset integer Z coordinate
-      fprintf(file, "%d", point->get_Z());
+      formatter.put_int(point->get_Z());
       break;
     default:
       unparse_attribute(point, (I32)(parse_string[i]-'0'));
@@ -550,11 +528,11 @@ BOOL LASwriterTXT::write_point(const LASpoint* point)
     i++;
     if (parse_string[i])
     {
-      fprintf(file, "%c", separator_sign);
+      formatter.put(separator_sign);
     }
     else
     {
-      fprintf(file, "\012");
+      formatter.put('\012');
       break;
     }
   }
@@ -568,6 +546,8 @@ BOOL LASwriterTXT::update_header(const LASheader* header, BOOL use_inventory, BO
 
 I64 LASwriterTXT::close(BOOL update_header)
 {
+  formatter.close();
+
   U32 bytes = (U32)ftell(file);
 
   if (file)
@@ -600,6 +580,7 @@ LASwriterTXT::LASwriterTXT()
   opts = FALSE;
   optx = FALSE;
   scale_rgb = 1.0f;
+  x_decimals = y_decimals = z_decimals = -1;
 }
 
 LASwriterTXT::~LASwriterTXT()
@@ -0,0 +1,587 @@
+/*
+===============================================================================
+
+  FILE:  arithmeticdecoderbench.cpp
+
+  CONTENTS:
+
+    A micro-benchmark for the entropy decoder that is on the innermost hot
+    path of every LAZ read. It synthesizes streams of bits, of symbols from
+    small and large alphabets, and of integers (via the IntegerCompressor)
+    that resemble what the point compressors produce, encodes them with the
+    ArithmeticEncoder, and then decodes them with the ArithmeticDecoder and
+    with a reference copy of the decoder as it was before the hot paths got
+    inlined into the callers. Both must decode exactly the same values.
+
+    arithmeticdecoderbench [-n 4000000] [-r 5] [-seed 4711]
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created to compare the inlined decoder with the old one
+
+===============================================================================
+*/
+
+#include "arithmeticdecoder.hpp"
+#include "arithmeticencoder.hpp"
+#include "integercompressor.hpp"
+#include "bytestreamin_array.hpp"
+#include "bytestreamout_array.hpp"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+//---------------------------------------------------------------------------
+// the reference: symbol and bit models and the decoder of Amir Said's FastAC
+// exactly as LASzip used them before, called (as before) without inlining
+//---------------------------------------------------------------------------
+
+class RefModel
+{
+public:
+  RefModel(U32 symbols)
+  {
+    this->symbols = symbols;
+    last_symbol = symbols - 1;
+    if (symbols > 16)
+    {
+      U32 table_bits = 3;
+      while (symbols > (1U << (table_bits + 2))) ++table_bits;
+      table_size  = 1 << table_bits;
+      table_shift = DM__LengthShift - table_bits;
+      distribution = new U32[2*symbols+table_size+2];
+      decoder_table = distribution + 2 * symbols;
+    }
+    else
+    {
+      decoder_table = 0;
+      table_size = table_shift = 0;
+      distribution = new U32[2*symbols];
+    }
+    symbol_count = distribution + symbols;
+    total_count = 0;
+    update_cycle = symbols;
+    for (U32 k = 0; k < symbols; k++) symbol_count[k] = 1;
+    update();
+    symbols_until_update = update_cycle = (symbols + 6) >> 1;
+  };
+  ~RefModel()
+  {
+    delete [] distribution;
+  };
+  void update()
+  {
+    if ((total_count += update_cycle) > DM__MaxCount)
+    {
+      total_count = 0;
+      for (U32 n = 0; n < symbols; n++)
+      {
+        total_count += (symbol_count[n] = (symbol_count[n] + 1) >> 1);
+      }
+    }
+    U32 k, sum = 0, s = 0;
+    U32 scale = 0x80000000U / total_count;
+    if (table_size == 0)
+    {
+      for (k = 0; k < symbols; k++)
+      {
+        distribution[k] = (scale * sum) >> (31 - DM__LengthShift);
+        sum += symbol_count[k];
+      }
+    }
+    else
+    {
+      for (k = 0; k < symbols; k++)
+      {
+        distribution[k] = (scale * sum) >> (31 - DM__LengthShift);
+        sum += symbol_count[k];
+        U32 w = distribution[k] >> table_shift;
+        while (s < w) decoder_table[++s] = k - 1;
+      }
+      decoder_table[0] = 0;
+      while (s <= table_size) decoder_table[++s] = symbols - 1;
+    }
+    update_cycle = (5 * update_cycle) >> 2;
+    U32 max_cycle = (symbols + 6) << 3;
+    if (update_cycle > max_cycle) update_cycle = max_cycle;
+    symbols_until_update = update_cycle;
+  };
+  U32 * distribution, * symbol_count, * decoder_table;
+  U32 total_count, update_cycle, symbols_until_update;
+  U32 symbols, last_symbol, table_size, table_shift;
+};
+
+class RefBitModel
+{
+public:
+  RefBitModel()
+  {
+    bit_0_count = 1;
+    bit_count   = 2;
+    bit_0_prob  = 1U << (BM__LengthShift - 1);
+    update_cycle = bits_until_update = 4;
+  };
+  void update()
+  {
+    if ((bit_count += update_cycle) > BM__MaxCount)
+    {
+      bit_count = (bit_count + 1) >> 1;
+      bit_0_count = (bit_0_count + 1) >> 1;
+      if (bit_0_count == bit_count) ++bit_count;
+    }
+    U32 scale = 0x80000000U / bit_count;
+    bit_0_prob = (bit_0_count * scale) >> (31 - BM__LengthShift);
+    update_cycle = (5 * update_cycle) >> 2;
+    if (update_cycle > 64) update_cycle = 64;
+    bits_until_update = update_cycle;
+  };
+  U32 update_cycle, bits_until_update;
+  U32 bit_0_prob, bit_0_count, bit_count;
+};
+
+class RefDecoder
+{
+public:
+  void init(ByteStreamIn* instream)
+  {
+    this->instream = instream;
+    length = AC__MaxLength;
+    value = (instream->getByte() << 24);
+    value |= (instream->getByte() << 16);
+    value |= (instream->getByte() << 8);
+    value |= (instream->getByte());
+  };
+  BENCH_NOINLINE U32 decodeBit(RefBitModel* m);
+  BENCH_NOINLINE U32 decodeSymbol(RefModel* m);
+  BENCH_NOINLINE U32 readBits(U32 bits);
+  BENCH_NOINLINE U16 readShort();
+private:
+  void renorm_dec_interval()
+  {
+    do {
+      value = (value << 8) | instream->getByte();
+    } while ((length <<= 8) < AC__MinLength);
+  };
+  ByteStreamIn* instream;
+  U32 value, length;
+};
+
+U32 RefDecoder::decodeBit(RefBitModel* m)
+{
+  U32 x = m->bit_0_prob * (length >> BM__LengthShift);
+  U32 sym = (value >= x);
+  if (sym == 0) {
+    length  = x;
+    ++m->bit_0_count;
+  }
+  else {
+    value  -= x;
+    length -= x;
+  }
+  if (length < AC__MinLength) renorm_dec_interval();
+  if (--m->bits_until_update == 0) m->update();
+  return sym;
+}
+
+U32 RefDecoder::decodeSymbol(RefModel* m)
+{
+  U32 n, sym, x, y = length;
+  if (m->decoder_table) {
+    unsigned dv = value / (length >>= DM__LengthShift);
+    unsigned t = dv >> m->table_shift;
+    sym = m->decoder_table[t];
+    n = m->decoder_table[t+1] + 1;
+    while (n > sym + 1) {
+      U32 k = (sym + n) >> 1;
+      if (m->distribution[k] > dv) n = k; else sym = k;
+    }
+    x = m->distribution[sym] * length;
+    if (sym != m->last_symbol) y = m->distribution[sym+1] * length;
+  }
+  else {
+    x = sym = 0;
+    length >>= DM__LengthShift;
+    U32 k = (n = m->symbols) >> 1;
+    do {
+      U32 z = length * m->distribution[k];
+      if (z > value) {
+        n = k;
+        y = z;
+      }
+      else {
+        sym = k;
+        x = z;
+      }
+    } while ((k = (sym + n) >> 1) != sym);
+  }
+  value -= x;
+  length = y - x;
+  if (length < AC__MinLength) renorm_dec_interval();
+  ++m->symbol_count[sym];
+  if (--m->symbols_until_update == 0) m->update();
+  return sym;
+}
+
+U32 RefDecoder::readBits(U32 bits)
+{
+  if (bits > 19)
+  {
+    U32 tmp = readShort();
+    bits = bits - 16;
+    U32 tmp1 = readBits(bits) << 16;
+    return (tmp1|tmp);
+  }
+  U32 sym = value / (length >>= bits);
+  value -= length * sym;
+  if (length < AC__MinLength) renorm_dec_interval();
+  return sym;
+}
+
+U16 RefDecoder::readShort()
+{
+  U32 sym = value / (length >>= 16);
+  value -= length * sym;
+  if (length < AC__MinLength) renorm_dec_interval();
+  return (U16)sym;
+}
+
+// the decompress() of an IntegerCompressor with 32 bits and one context
+class RefIntegerDecoder
+{
+public:
+  RefIntegerDecoder(RefDecoder* dec)
+  {
+    this->dec = dec;
+    mBits = new RefModel(33);
+    for (U32 i = 1; i <= 32; i++)
+    {
+      mCorrector[i] = new RefModel(i <= 8 ? (1u << i) : (1u << 8));
+    }
+  };
+  ~RefIntegerDecoder()
+  {
+    delete mBits;
+    for (U32 i = 1; i <= 32; i++) delete mCorrector[i];
+  };
+  BENCH_NOINLINE I32 decompress(I32 pred);
+private:
+  RefDecoder* dec;
+  RefModel* mBits;
+  RefBitModel mCorrector0;
+  RefModel* mCorrector[33];
+};
+
+I32 RefIntegerDecoder::decompress(I32 pred)
+{
+  I32 c;
+  U32 k = dec->decodeSymbol(mBits);
+  if (k)
+  {
+    if (k < 32)
+    {
+      if (k <= 8)
+      {
+        c = dec->decodeSymbol(mCorrector[k]);
+      }
+      else
+      {
+        int k1 = k-8;
+        c = dec->decodeSymbol(mCorrector[k]);
+        int c1 = dec->readBits(k1);
+        c = (c << k1) | c1;
+      }
+      if (c >= (1<<(k-1)))
+      {
+        c += 1;
+      }
+      else
+      {
+        c -= ((1<<k) - 1);
+      }
+    }
+    else
+    {
+      c = I32_MIN;
+    }
+  }
+  else
+  {
+    c = dec->decodeBit(&mCorrector0);
+  }
+  return pred + c;
+}
+
+//---------------------------------------------------------------------------
+// synthetic data
+//---------------------------------------------------------------------------
+
+static U64 random_state = 4711;
+
+static inline U32 random_next()
+{
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 7;
+  random_state ^= random_state << 17;
+  return (U32)(random_state >> 32);
+}
+
+// a geometric distribution over the symbols of an alphabet (small symbols are frequent)
+static U32 random_symbol(U32 symbols, U32 skew)
+{
+  U32 sym = 0;
+  while ((sym + 1 < symbols) && ((random_next() & 255) < skew)) sym++;
+  return sym;
+}
+
+// a difference of coordinates whose magnitude varies along the "flight line"
+static I32 random_difference(U32 i)
+{
+  U32 scale = 1 + ((i >> 12) % 18);
+  I32 d = (I32)(random_next() & ((1u << scale) - 1));
+  return ((random_next() & 1) ? d : -d);
+}
+
+//---------------------------------------------------------------------------
+
+enum BenchKind
+{
+  BENCH_BITS,
+  BENCH_SYMBOLS,
+  BENCH_INTEGERS
+};
+
+struct BenchStream
+{
+  const char* name;
+  BenchKind kind;
+  U32 symbols;
+  U32 skew;
+  std::vector<U32> values;
+  U8* bytes;
+  I64 num_bytes;
+};
+
+static void encode(BenchStream& stream)
+{
+  ByteStreamOutArray* outstream = new ByteStreamOutArrayLE(stream.values.size());
+  ArithmeticEncoder enc;
+  enc.init(outstream);
+  if (stream.kind == BENCH_BITS)
+  {
+    ArithmeticBitModel* m[4];
+    for (U32 j = 0; j < 4; j++) { m[j] = enc.createBitModel(); enc.initBitModel(m[j]); }
+    for (size_t i = 0; i < stream.values.size(); i++) enc.encodeBit(m[i & 3], stream.values[i]);
+    enc.done();
+    for (U32 j = 0; j < 4; j++) enc.destroyBitModel(m[j]);
+  }
+  else if (stream.kind == BENCH_SYMBOLS)
+  {
+    ArithmeticModel* m = enc.createSymbolModel(stream.symbols);
+    enc.initSymbolModel(m);
+    for (size_t i = 0; i < stream.values.size(); i++) enc.encodeSymbol(m, stream.values[i]);
+    enc.done();
+    enc.destroySymbolModel(m);
+  }
+  else
+  {
+    IntegerCompressor ic(&enc, 32);
+    ic.initCompressor();
+    I32 pred = 0;
+    for (size_t i = 0; i < stream.values.size(); i++)
+    {
+      ic.compress(pred, (I32)stream.values[i]);
+      pred = (I32)stream.values[i];
+    }
+    enc.done();
+  }
+  stream.num_bytes = outstream->getSize();
+  stream.bytes = outstream->takeData();
+  delete outstream;
+}
+
+// decodes with the current decoder and returns FALSE if a value differs
+static BOOL decode(const BenchStream& stream, std::vector<U32>& decoded)
+{
+  ByteStreamInArrayLE instream(stream.bytes, stream.num_bytes);
+  ArithmeticDecoder dec;
+  dec.init(&instream);
+  size_t n = stream.values.size();
+  if (stream.kind == BENCH_BITS)
+  {
+    ArithmeticBitModel* m[4];
+    for (U32 j = 0; j < 4; j++) { m[j] = dec.createBitModel(); dec.initBitModel(m[j]); }
+    for (size_t i = 0; i < n; i++) decoded[i] = dec.decodeBit(m[i & 3]);
+    for (U32 j = 0; j < 4; j++) dec.destroyBitModel(m[j]);
+  }
+  else if (stream.kind == BENCH_SYMBOLS)
+  {
+    ArithmeticModel* m = dec.createSymbolModel(stream.symbols);
+    dec.initSymbolModel(m);
+    for (size_t i = 0; i < n; i++) decoded[i] = dec.decodeSymbol(m);
+    dec.destroySymbolModel(m);
+  }
+  else
+  {
+    IntegerCompressor ic(&dec, 32);
+    ic.initDecompressor();
+    I32 pred = 0;
+    for (size_t i = 0; i < n; i++) decoded[i] = (U32)(pred = ic.decompress(pred));
+  }
+  return (memcmp(decoded.data(), stream.values.data(), n * sizeof(U32)) == 0);
+}
+
+// decodes with the reference decoder and returns FALSE if a value differs
+static BOOL decode_reference(const BenchStream& stream, std::vector<U32>& decoded)
+{
+  ByteStreamInArrayLE instream(stream.bytes, stream.num_bytes);
+  RefDecoder dec;
+  dec.init(&instream);
+  size_t n = stream.values.size();
+  if (stream.kind == BENCH_BITS)
+  {
+    RefBitModel m[4];
+    for (size_t i = 0; i < n; i++) decoded[i] = dec.decodeBit(&m[i & 3]);
+  }
+  else if (stream.kind == BENCH_SYMBOLS)
+  {
+    RefModel m(stream.symbols);
+    for (size_t i = 0; i < n; i++) decoded[i] = dec.decodeSymbol(&m);
+  }
+  else
+  {
+    RefIntegerDecoder ic(&dec);
+    I32 pred = 0;
+    for (size_t i = 0; i < n; i++) decoded[i] = (U32)(pred = ic.decompress(pred));
+  }
+  return (memcmp(decoded.data(), stream.values.data(), n * sizeof(U32)) == 0);
+}
+
+static double taketime()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void usage()
+{
+  fprintf(stderr, "usage:\n");
+  fprintf(stderr, "arithmeticdecoderbench\n");
+  fprintf(stderr, "arithmeticdecoderbench -n 10000000 -r 9\n");
+  fprintf(stderr, "arithmeticdecoderbench -h\n");
+  exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+  U32 n = 4000000;
+  U32 repeats = 5;
+  for (int i = 1; i < argc; i++)
+  {
+    if ((strcmp(argv[i], "-n") == 0) && ((i+1) < argc))
+    {
+      n = (U32)atoi(argv[++i]);
+    }
+    else if ((strcmp(argv[i], "-r") == 0) && ((i+1) < argc))
+    {
+      repeats = (U32)atoi(argv[++i]);
+    }
+    else if ((strcmp(argv[i], "-seed") == 0) && ((i+1) < argc))
+    {
+      random_state = (U64)atoi(argv[++i]) | 1;
+    }
+    else
+    {
+      usage();
+    }
+  }
+  if ((n == 0) || (repeats == 0)) usage();
+
+  BenchStream streams[6] = {
+    { "bits", BENCH_BITS, 2, 0, {}, 0, 0 },
+    { "symbols_8", BENCH_SYMBOLS, 8, 128, {}, 0, 0 },
+    { "symbols_16", BENCH_SYMBOLS, 16, 192, {}, 0, 0 },
+    { "symbols_64", BENCH_SYMBOLS, 64, 224, {}, 0, 0 },
+    { "symbols_256", BENCH_SYMBOLS, 256, 240, {}, 0, 0 },
+    { "integers", BENCH_INTEGERS, 0, 0, {}, 0, 0 }
+  };
+  const U32 num_streams = sizeof(streams) / sizeof(streams[0]);
+
+  for (U32 s = 0; s < num_streams; s++)
+  {
+    BenchStream& stream = streams[s];
+    stream.values.resize(n);
+    if (stream.kind == BENCH_BITS)
+    {
+      static const U32 thresholds[4] = { 128, 230, 253, 180 }; // p(0) of 0.5, 0.9, 0.99, and 0.7
+      for (U32 i = 0; i < n; i++) stream.values[i] = ((random_next() & 255) >= thresholds[i & 3]);
+    }
+    else if (stream.kind == BENCH_SYMBOLS)
+    {
+      for (U32 i = 0; i < n; i++) stream.values[i] = random_symbol(stream.symbols, stream.skew);
+    }
+    else
+    {
+      I32 value = 0;
+      for (U32 i = 0; i < n; i++) stream.values[i] = (U32)(value += random_difference(i));
+    }
+    encode(stream);
+  }
+
+  fprintf(stdout, "stream        values  bits/value  reference ns/value  decoder ns/value  speedup\n");
+
+  std::vector<U32> decoded(n);
+  double total_reference = 0.0;
+  double total_decoder = 0.0;
+  BOOL identical = TRUE;
+  for (U32 s = 0; s < num_streams; s++)
+  {
+    BenchStream& stream = streams[s];
+    double best_reference = 1e30;
+    double best_decoder = 1e30;
+    for (U32 r = 0; r < repeats; r++)
+    {
+      double start = taketime();
+      if (!decode_reference(stream, decoded)) identical = FALSE;
+      double middle = taketime();
+      if (!decode(stream, decoded)) identical = FALSE;
+      double end = taketime();
+      if ((middle - start) < best_reference) best_reference = middle - start;
+      if ((end - middle) < best_decoder) best_decoder = end - middle;
+    }
+    total_reference += best_reference;
+    total_decoder += best_decoder;
+    fprintf(stdout, "%-12s %7u  %10.3f  %18.2f  %16.2f  %6.3fx\n", stream.name, n, 8.0 * stream.num_bytes / n, 1e9 * best_reference / n, 1e9 * best_decoder / n, best_reference / best_decoder);
+    free(stream.bytes);
+  }
+  fprintf(stdout, "%-12s %7u  %10s  %18.2f  %16.2f  %6.3fx\n", "all", n * num_streams, "", 1e9 * total_reference / n / num_streams, 1e9 * total_decoder / n / num_streams, total_reference / total_decoder);
+
+  if (!identical)
+  {
+    fprintf(stderr, "ERROR: decoded values differ from the encoded ones\n");
+    return 1;
+  }
+  return 0;
+}
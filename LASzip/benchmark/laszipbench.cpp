@@ -0,0 +1,702 @@
+/*
+===============================================================================
+
+  FILE:  laszipbench.cpp
+
+  CONTENTS:
+
+    A throughput benchmark for the LASzip point compressors. It synthesizes a
+    point cloud (or loads the points of a LAS/LAZ file with '-i') and then
+    compresses and decompresses it in memory for every point data format from
+    0 to 10 with every compressor that LASzip offers for it: the pointwise and
+    the pointwise chunked compressor with item versions 1 and 2 for the point
+    types 0 to 5 and the layered chunked compressor of the "native LAS 1.4
+    extension" with item versions 3 and 4 for the point types 6 to 10, each
+    with several chunk sizes. Every decompressed point is checked against the
+    original one.
+
+    For each combination it reports the compressed bytes per point, the points
+    per second when compressing and when decompressing (best of '-r' runs) and
+    the peak of the heap memory the compressor and the decompressor allocate
+    with new (models, decoder buffers, ...) as CSV (default) or as JSON. The
+    byte streams that grow with malloc (e.g. those of the layers written by
+    the layered compressor) are not part of this peak. The compressed bytes
+    are those of the point data including the chunk table but without the
+    LAS header. The compression times include copying every point into the
+    LASpoint that is handed to the compressor.
+
+    laszipbench [-n 500000] [-r 3] [-seed 4711] [-i lidar.laz]
+                [-point_type 6] [-version 4] [-chunk_size 50000]
+                [-extra_bytes 4] [-csv | -json] [-o results.csv]
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created to track the codec throughput per point format
+
+===============================================================================
+*/
+
+#include "laszip.hpp"
+#include "laspoint.hpp"
+#include "laswritepoint.hpp"
+#include "lasreadpoint.hpp"
+#include "bytestreamin_array.hpp"
+#include "bytestreamout_array.hpp"
+#include "lasreader.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <math.h>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+//---------------------------------------------------------------------------
+// the heap memory allocated with new is tracked to report the peak of what
+// the compressor and the decompressor need (the streams use malloc)
+//---------------------------------------------------------------------------
+
+static std::atomic<I64> heap_current(0);
+static std::atomic<I64> heap_peak(0);
+
+#define BENCH_HEAP_HEADER 16
+
+static void* heap_allocate(size_t size)
+{
+  U8* memory = (U8*)malloc(size + BENCH_HEAP_HEADER);
+  if (memory == 0) throw std::bad_alloc();
+  *((size_t*)memory) = size;
+  I64 current = (heap_current += (I64)size);
+  I64 peak = heap_peak.load();
+  while ((current > peak) && !heap_peak.compare_exchange_weak(peak, current));
+  return memory + BENCH_HEAP_HEADER;
+}
+
+static void heap_free(void* pointer)
+{
+  if (pointer == 0) return;
+  U8* memory = ((U8*)pointer) - BENCH_HEAP_HEADER;
+  heap_current -= (I64)(*((size_t*)memory));
+  free(memory);
+}
+
+static void heap_reset_peak()
+{
+  heap_peak = heap_current.load();
+}
+
+void* operator new(size_t size) { return heap_allocate(size); }
+void* operator new[](size_t size) { return heap_allocate(size); }
+void operator delete(void* pointer) noexcept { heap_free(pointer); }
+void operator delete[](void* pointer) noexcept { heap_free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { heap_free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { heap_free(pointer); }
+
+//---------------------------------------------------------------------------
+// the points that are compressed (all attributes of all point types)
+//---------------------------------------------------------------------------
+
+struct BenchPoint
+{
+  I32 X;
+  I32 Y;
+  I32 Z;
+  U16 intensity;
+  U8 return_number;
+  U8 number_of_returns;
+  U8 scan_direction_flag;
+  U8 edge_of_flight_line;
+  U8 classification;
+  U8 classification_flags;
+  U8 scanner_channel;
+  U8 user_data;
+  I16 scan_angle;           // in units of 0.006 degrees
+  U16 point_source_ID;
+  F64 gps_time;
+  U16 rgb[4];               // with NIR
+  U8 wavepacket[29];
+  U8 extra_bytes[8];
+};
+
+#define BENCH_MAX_EXTRA_BYTES 8
+
+static U64 random_state = 4711;
+
+static inline U32 random_next()
+{
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 7;
+  random_state ^= random_state << 17;
+  return (U32)(random_state >> 32);
+}
+
+// an airborne scan: pulses along scan lines with up to five returns that
+// hit terrain, vegetation, and buildings, recorded from four flight lines
+static void synthesize(std::vector<BenchPoint>& points)
+{
+  const U32 pulses_per_line = 400;
+  U32 n = (U32)points.size();
+  U32 line = 0;
+  U32 pulse = 0;
+  I32 x = 0;
+  F64 gps_time = 317000000.0;
+  U64 wave_offset = 0;
+  U32 i = 0;
+  while (i < n)
+  {
+    // the next pulse
+    if (++pulse == pulses_per_line)
+    {
+      pulse = 0;
+      line++;
+    }
+    BOOL forward = ((line & 1) == 0);
+    U32 position = (forward ? pulse : pulses_per_line - 1 - pulse);
+    x = (I32)(position * 75) + (I32)(random_next() % 31) - 15;
+    I32 y = (I32)(line * 60) + (I32)(position % 7) * 3 + (I32)(random_next() % 9) - 4;
+    gps_time += 0.00001;
+    U16 flight_line = (U16)(1 + (4 * i) / n);
+
+    // the terrain and what stands on it
+    F64 terrain = 12000.0 + 800.0 * sin(x * 0.0003) + 500.0 * cos(y * 0.0002);
+    U32 cover = ((x / 3000) * 7 + (y / 2000) * 3) % 10;
+    BOOL building = (cover == 0);
+    BOOL vegetation = (cover >= 6);
+    U32 returns = 1;
+    if (vegetation)
+    {
+      U32 r = random_next() & 15;
+      returns = (r < 5 ? 1 : (r < 10 ? 2 : (r < 13 ? 3 : (r < 15 ? 4 : 5))));
+    }
+    F64 top = terrain + (building ? 900.0 : (vegetation ? 400.0 + (random_next() % 1600) : 0.0));
+
+    for (U32 r = 1; (r <= returns) && (i < n); r++, i++)
+    {
+      BenchPoint& point = points[i];
+      memset(&point, 0, sizeof(BenchPoint));
+      F64 z = (r == returns ? terrain : top - (top - terrain) * (r - 1) / returns);
+      point.X = x + (I32)(random_next() % 5);
+      point.Y = y;
+      point.Z = (I32)z + (I32)(random_next() % 7) - 3;
+      point.intensity = (U16)((r == 1 ? 900 : 300) + (building ? 600 : 0) + (random_next() % 200));
+      point.return_number = (U8)r;
+      point.number_of_returns = (U8)returns;
+      point.scan_direction_flag = (forward ? 1 : 0);
+      point.edge_of_flight_line = ((pulse == pulses_per_line - 1) ? 1 : 0);
+      point.classification = (U8)((r == returns) ? (building ? 6 : 2) : (r == 1 ? 5 : 4));
+      point.classification_flags = (U8)(((random_next() & 255) == 0) ? 1 : 0);
+      point.scanner_channel = (U8)(line & 1);
+      point.user_data = (U8)(point.Z - (I32)terrain > 200 ? 1 : 0);
+      point.scan_angle = (I16)(((I32)position - (I32)(pulses_per_line / 2)) * 20);
+      point.point_source_ID = flight_line;
+      point.gps_time = gps_time;
+      point.rgb[0] = (U16)(256 * (90 + (cover * 13) + (random_next() % 16)));
+      point.rgb[1] = (U16)(256 * (110 + (vegetation ? 60 : 0) + (random_next() % 16)));
+      point.rgb[2] = (U16)(256 * (80 + (building ? 70 : 0) + (random_next() % 16)));
+      point.rgb[3] = (U16)(256 * (vegetation ? 180 : 60) + (random_next() % 4096));
+      LASwavepacket wavepacket;
+      wavepacket.setIndex(1);
+      wavepacket.setOffset(wave_offset);
+      wavepacket.setSize(256);
+      wavepacket.setLocation((F32)(1000.0f + 15.0f * (r - 1) + (random_next() % 100) * 0.01f));
+      wavepacket.setXt(0.0001f * (position - pulses_per_line / 2.0f));
+      wavepacket.setYt(0.00002f);
+      wavepacket.setZt(-0.0015f);
+      memcpy(point.wavepacket, &wavepacket, 29);
+      wave_offset += 256;
+      U16 height = (U16)(point.Z - (I32)terrain + 100);
+      for (U32 e = 0; e < BENCH_MAX_EXTRA_BYTES; e += 2)
+      {
+        point.extra_bytes[e] = (U8)(height >> (e & 2 ? 8 : 0));
+        point.extra_bytes[e+1] = (U8)(e == 0 ? returns : (random_next() & 3));
+      }
+    }
+  }
+}
+
+// takes the points of a LAS or LAZ file (all attributes this file does not
+// have are synthesized) and returns how many points were loaded
+static U32 load(const CHAR* file_name, std::vector<BenchPoint>& points)
+{
+  LASreadOpener lasreadopener;
+  lasreadopener.set_file_name(file_name);
+  LASreader* lasreader = lasreadopener.open();
+  if (lasreader == 0)
+  {
+    fprintf(stderr, "ERROR: cannot open '%s'\n", file_name);
+    return 0;
+  }
+  U32 n = (U32)points.size();
+  if ((I64)n > lasreader->npoints) n = (U32)lasreader->npoints;
+  points.resize(n);
+  synthesize(points);
+  const LASpoint& laspoint = lasreader->point;
+  U32 i;
+  for (i = 0; (i < n) && lasreader->read_point(); i++)
+  {
+    BenchPoint& point = points[i];
+    point.X = laspoint.get_X();
+    point.Y = laspoint.get_Y();
+    point.Z = laspoint.get_Z();
+    point.intensity = laspoint.get_intensity();
+    point.scan_direction_flag = laspoint.get_scan_direction_flag();
+    point.edge_of_flight_line = laspoint.get_edge_of_flight_line();
+    point.user_data = laspoint.get_user_data();
+    point.point_source_ID = laspoint.get_point_source_ID();
+    if (laspoint.extended_point_type)
+    {
+      point.return_number = laspoint.get_extended_return_number();
+      point.number_of_returns = laspoint.get_extended_number_of_returns();
+      point.classification = laspoint.get_extended_classification();
+      point.classification_flags = laspoint.extended_classification_flags;
+      point.scanner_channel = laspoint.get_extended_scanner_channel();
+      point.scan_angle = laspoint.get_extended_scan_angle();
+    }
+    else
+    {
+      point.return_number = laspoint.get_return_number();
+      point.number_of_returns = laspoint.get_number_of_returns();
+      point.classification = laspoint.get_classification();
+      point.classification_flags = (U8)(laspoint.get_synthetic_flag() | (laspoint.get_keypoint_flag() << 1) | (laspoint.get_withheld_flag() << 2));
+      point.scanner_channel = 0;
+      point.scan_angle = (I16)(laspoint.get_scan_angle_rank() * 1000 / 6);
+    }
+    if (laspoint.have_gps_time) point.gps_time = laspoint.get_gps_time();
+    if (laspoint.have_rgb) memcpy(point.rgb, laspoint.rgb, 3 * sizeof(U16));
+    if (laspoint.have_nir) point.rgb[3] = laspoint.rgb[3];
+  }
+  lasreader->close();
+  delete lasreader;
+  points.resize(i);
+  return i;
+}
+
+//---------------------------------------------------------------------------
+// moving the points into and out of the LASpoint the codec works on
+//---------------------------------------------------------------------------
+
+static inline void fill(LASpoint& laspoint, const BenchPoint& point)
+{
+  laspoint.set_X(point.X);
+  laspoint.set_Y(point.Y);
+  laspoint.set_Z(point.Z);
+  laspoint.set_intensity(point.intensity);
+  laspoint.set_scan_direction_flag(point.scan_direction_flag);
+  laspoint.set_edge_of_flight_line(point.edge_of_flight_line);
+  laspoint.set_user_data(point.user_data);
+  laspoint.set_point_source_ID(point.point_source_ID);
+  laspoint.set_synthetic_flag(point.classification_flags & 1);
+  laspoint.set_keypoint_flag(point.classification_flags & 2);
+  laspoint.set_withheld_flag(point.classification_flags & 4);
+  if (laspoint.extended_point_type)
+  {
+    laspoint.set_extended_return_number(point.return_number);
+    laspoint.set_extended_number_of_returns(point.number_of_returns);
+    laspoint.set_extended_classification(point.classification);
+    laspoint.set_extended_overlap_flag((point.classification_flags >> 3) & 1);
+    laspoint.set_extended_scanner_channel(point.scanner_channel);
+    laspoint.set_extended_scan_angle(point.scan_angle);
+  }
+  else
+  {
+    laspoint.set_return_number(point.return_number);
+    laspoint.set_number_of_returns(point.number_of_returns);
+    laspoint.set_classification(point.classification & 31);
+    laspoint.set_scan_angle_rank((I8)(point.scan_angle * 6 / 1000));
+  }
+  laspoint.set_gps_time(point.gps_time);
+  laspoint.set_RGBI(point.rgb);
+  memcpy(&laspoint.wavepacket, point.wavepacket, 29);
+  if (laspoint.extra_bytes_number) memcpy(laspoint.extra_bytes, point.extra_bytes, laspoint.extra_bytes_number);
+}
+
+// returns TRUE if the decompressed LASpoint has the attributes of the point
+static BOOL same(const LASpoint& laspoint, LASpoint& expected, const BenchPoint& point)
+{
+  fill(expected, point);
+  if (laspoint.get_X() != expected.get_X()) return FALSE;
+  if (laspoint.get_Y() != expected.get_Y()) return FALSE;
+  if (laspoint.get_Z() != expected.get_Z()) return FALSE;
+  if (laspoint.get_intensity() != expected.get_intensity()) return FALSE;
+  if (laspoint.get_scan_direction_flag() != expected.get_scan_direction_flag()) return FALSE;
+  if (laspoint.get_edge_of_flight_line() != expected.get_edge_of_flight_line()) return FALSE;
+  if (laspoint.get_user_data() != expected.get_user_data()) return FALSE;
+  if (laspoint.get_point_source_ID() != expected.get_point_source_ID()) return FALSE;
+  if (laspoint.extended_point_type)
+  {
+    if (laspoint.get_extended_return_number() != expected.get_extended_return_number()) return FALSE;
+    if (laspoint.get_extended_number_of_returns() != expected.get_extended_number_of_returns()) return FALSE;
+    if (laspoint.get_extended_classification() != expected.get_extended_classification()) return FALSE;
+    if (laspoint.extended_classification_flags != expected.extended_classification_flags) return FALSE;
+    if (laspoint.get_extended_scanner_channel() != expected.get_extended_scanner_channel()) return FALSE;
+    if (laspoint.get_extended_scan_angle() != expected.get_extended_scan_angle()) return FALSE;
+  }
+  else
+  {
+    if (laspoint.get_return_number() != expected.get_return_number()) return FALSE;
+    if (laspoint.get_number_of_returns() != expected.get_number_of_returns()) return FALSE;
+    if (laspoint.get_classification() != expected.get_classification()) return FALSE;
+    if (laspoint.get_synthetic_flag() != expected.get_synthetic_flag()) return FALSE;
+    if (laspoint.get_keypoint_flag() != expected.get_keypoint_flag()) return FALSE;
+    if (laspoint.get_withheld_flag() != expected.get_withheld_flag()) return FALSE;
+    if (laspoint.get_scan_angle_rank() != expected.get_scan_angle_rank()) return FALSE;
+  }
+  if (laspoint.have_gps_time && (laspoint.get_gps_time() != expected.get_gps_time())) return FALSE;
+  if (laspoint.have_rgb && memcmp(laspoint.rgb, expected.rgb, 3 * sizeof(U16))) return FALSE;
+  if (laspoint.have_nir && (laspoint.rgb[3] != expected.rgb[3])) return FALSE;
+  if (laspoint.have_wavepacket && memcmp(&laspoint.wavepacket, &expected.wavepacket, 29)) return FALSE;
+  if (laspoint.extra_bytes_number && memcmp(laspoint.extra_bytes, expected.extra_bytes, laspoint.extra_bytes_number)) return FALSE;
+  return TRUE;
+}
+
+//---------------------------------------------------------------------------
+// one combination of point type, compressor, item version, and chunk size
+//---------------------------------------------------------------------------
+
+struct BenchConfig
+{
+  U8 point_type;
+  U16 point_size;
+  U16 compressor;
+  U16 version;
+  U32 chunk_size;
+};
+
+struct BenchResult
+{
+  I64 compressed_bytes;
+  F64 compress_seconds;
+  F64 decompress_seconds;
+  I64 compress_peak_heap;
+  I64 decompress_peak_heap;
+  BOOL verified;
+};
+
+static const U16 point_sizes[11] = { 20, 28, 26, 34, 57, 63, 30, 36, 38, 59, 67 };
+
+static const CHAR* compressor_name(const U16 compressor)
+{
+  if (compressor == LASZIP_COMPRESSOR_POINTWISE) return "pointwise";
+  if (compressor == LASZIP_COMPRESSOR_POINTWISE_CHUNKED) return "pointwise_chunked";
+  return "layered_chunked";
+}
+
+static BOOL setup(LASzip& laszip, const BenchConfig& config)
+{
+  if (!laszip.setup(config.point_type, config.point_size, config.compressor)) return FALSE;
+  if (config.compressor != LASZIP_COMPRESSOR_POINTWISE)
+  {
+    if (!laszip.set_chunk_size(config.chunk_size)) return FALSE;
+  }
+  if (!laszip.request_version(config.version < 3 ? config.version : 2)) return FALSE;
+  if (config.version == 4)
+  {
+    // request_version() only knows up to version 3 for the LAS 1.4 items
+    for (U16 i = 0; i < laszip.num_items; i++)
+    {
+      if (laszip.items[i].version == 3) laszip.items[i].version = 4;
+    }
+  }
+  return TRUE;
+}
+
+static F64 taketime()
+{
+  return std::chrono::duration<F64>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static BOOL compress(const LASzip& laszip, const BenchConfig& config, const std::vector<BenchPoint>& points, ByteStreamOutArray*& outstream, F64& seconds, I64& peak_heap)
+{
+  outstream = new ByteStreamOutArrayLE(points.size() * config.point_size / 4 + 4096);
+  LASpoint laspoint;
+  if (!laspoint.init(0, config.point_type, config.point_size)) return FALSE;
+  heap_reset_peak();
+  I64 heap_start = heap_current.load();
+  F64 start = taketime();
+  LASwritePoint* writer = new LASwritePoint();
+  if (!writer->setup(laszip.num_items, laszip.items, &laszip)) return FALSE;
+  if (!writer->init(outstream)) return FALSE;
+  for (size_t i = 0; i < points.size(); i++)
+  {
+    fill(laspoint, points[i]);
+    if (!writer->write(laspoint.point)) return FALSE;
+  }
+  if (!writer->done()) return FALSE;
+  delete writer;
+  seconds = taketime() - start;
+  peak_heap = heap_peak.load() - heap_start;
+  return TRUE;
+}
+
+static BOOL decompress(const LASzip& laszip, const BenchConfig& config, const std::vector<BenchPoint>& points, const ByteStreamOutArray* outstream, BOOL verify, F64& seconds, I64& peak_heap)
+{
+  ByteStreamInArrayLE instream(outstream->getData(), outstream->getSize());
+  LASpoint laspoint;
+  if (!laspoint.init(0, config.point_type, config.point_size)) return FALSE;
+  LASpoint expected;
+  if (!expected.init(0, config.point_type, config.point_size)) return FALSE;
+  heap_reset_peak();
+  I64 heap_start = heap_current.load();
+  F64 start = taketime();
+  LASreadPoint* reader = new LASreadPoint();
+  if (!reader->setup(laszip.num_items, laszip.items, &laszip)) return FALSE;
+  if (!reader->init(&instream)) return FALSE;
+  for (size_t i = 0; i < points.size(); i++)
+  {
+    if (!reader->read(laspoint.point)) return FALSE;
+    if (verify && !same(laspoint, expected, points[i])) return FALSE;
+  }
+  if (!reader->done()) return FALSE;
+  delete reader;
+  seconds = taketime() - start;
+  peak_heap = heap_peak.load() - heap_start;
+  return TRUE;
+}
+
+static BOOL run(const BenchConfig& config, const std::vector<BenchPoint>& points, const U32 repeats, BenchResult& result)
+{
+  LASzip laszip;
+  if (!setup(laszip, config)) return FALSE;
+
+  result.compress_seconds = 1e30;
+  result.decompress_seconds = 1e30;
+  ByteStreamOutArray* outstream = 0;
+  for (U32 r = 0; r < repeats; r++)
+  {
+    F64 seconds;
+    if (outstream) delete outstream;
+    if (!compress(laszip, config, points, outstream, seconds, result.compress_peak_heap)) return FALSE;
+    if (seconds < result.compress_seconds) result.compress_seconds = seconds;
+  }
+  result.compressed_bytes = outstream->getSize();
+
+  // the first decompression checks all points and is not timed
+  F64 seconds;
+  result.verified = decompress(laszip, config, points, outstream, TRUE, seconds, result.decompress_peak_heap);
+  for (U32 r = 0; r < repeats; r++)
+  {
+    if (!decompress(laszip, config, points, outstream, FALSE, seconds, result.decompress_peak_heap)) result.verified = FALSE;
+    if (seconds < result.decompress_seconds) result.decompress_seconds = seconds;
+  }
+  delete outstream;
+  return TRUE;
+}
+
+//---------------------------------------------------------------------------
+
+static void usage()
+{
+  fprintf(stderr, "usage:\n");
+  fprintf(stderr, "laszipbench\n");
+  fprintf(stderr, "laszipbench -n 2000000 -r 5 -json -o results.json\n");
+  fprintf(stderr, "laszipbench -point_type 1 -point_type 6 -chunk_size 10000 -chunk_size 50000\n");
+  fprintf(stderr, "laszipbench -i lidar.laz -version 4 -extra_bytes 4\n");
+  fprintf(stderr, "laszipbench -h\n");
+  exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+  U32 n = 500000;
+  U32 repeats = 3;
+  const CHAR* file_name = 0;
+  const CHAR* output_name = 0;
+  U32 point_types = 0;
+  U32 versions = 0;
+  std::vector<U32> chunk_sizes;
+  U32 extra_bytes = 0;
+  BOOL json = FALSE;
+  for (int i = 1; i < argc; i++)
+  {
+    if ((strcmp(argv[i], "-n") == 0) && ((i+1) < argc))
+    {
+      n = (U32)atoi(argv[++i]);
+    }
+    else if ((strcmp(argv[i], "-r") == 0) && ((i+1) < argc))
+    {
+      repeats = (U32)atoi(argv[++i]);
+    }
+    else if ((strcmp(argv[i], "-seed") == 0) && ((i+1) < argc))
+    {
+      random_state = (U64)atoi(argv[++i]) | 1;
+    }
+    else if ((strcmp(argv[i], "-i") == 0) && ((i+1) < argc))
+    {
+      file_name = argv[++i];
+    }
+    else if ((strcmp(argv[i], "-o") == 0) && ((i+1) < argc))
+    {
+      output_name = argv[++i];
+    }
+    else if ((strcmp(argv[i], "-point_type") == 0) && ((i+1) < argc))
+    {
+      U32 point_type = (U32)atoi(argv[++i]);
+      if (point_type > 10) usage();
+      point_types |= (1u << point_type);
+    }
+    else if ((strcmp(argv[i], "-version") == 0) && ((i+1) < argc))
+    {
+      U32 version = (U32)atoi(argv[++i]);
+      if ((version < 1) || (version > 4)) usage();
+      versions |= (1u << version);
+    }
+    else if ((strcmp(argv[i], "-chunk_size") == 0) && ((i+1) < argc))
+    {
+      I32 chunk_size = atoi(argv[++i]);
+      if (chunk_size <= 0) usage();
+      chunk_sizes.push_back((U32)chunk_size);
+    }
+    else if ((strcmp(argv[i], "-extra_bytes") == 0) && ((i+1) < argc))
+    {
+      extra_bytes = (U32)atoi(argv[++i]);
+      if (extra_bytes > BENCH_MAX_EXTRA_BYTES) usage();
+    }
+    else if (strcmp(argv[i], "-csv") == 0)
+    {
+      json = FALSE;
+    }
+    else if (strcmp(argv[i], "-json") == 0)
+    {
+      json = TRUE;
+    }
+    else
+    {
+      usage();
+    }
+  }
+  if ((n == 0) || (repeats == 0)) usage();
+  if (point_types == 0) point_types = 0x7FF;
+  if (versions == 0) versions = 0x1E;
+  if (chunk_sizes.size() == 0)
+  {
+    chunk_sizes.push_back(5000);
+    chunk_sizes.push_back(LASZIP_CHUNK_SIZE_DEFAULT);
+    chunk_sizes.push_back(500000);
+  }
+
+  // the point cloud
+
+  std::vector<BenchPoint> points(n);
+  if (file_name)
+  {
+    n = load(file_name, points);
+    if (n == 0)
+    {
+      fprintf(stderr, "ERROR: no points in '%s'\n", file_name);
+      return 1;
+    }
+  }
+  else
+  {
+    synthesize(points);
+  }
+
+  // all combinations of point type, compressor, item version, and chunk size
+
+  std::vector<BenchConfig> configs;
+  for (U8 point_type = 0; point_type <= 10; point_type++)
+  {
+    if ((point_types & (1u << point_type)) == 0) continue;
+    U16 point_size = (U16)(point_sizes[point_type] + extra_bytes);
+    for (U16 version = 1; version <= 4; version++)
+    {
+      if ((versions & (1u << version)) == 0) continue;
+      if ((point_type <= 5) != (version <= 2)) continue;
+      if (version <= 2)
+      {
+        BenchConfig config = { point_type, point_size, LASZIP_COMPRESSOR_POINTWISE, version, 0 };
+        configs.push_back(config);
+      }
+      for (size_t c = 0; c < chunk_sizes.size(); c++)
+      {
+        BenchConfig config = { point_type, point_size, (U16)(version <= 2 ? LASZIP_COMPRESSOR_POINTWISE_CHUNKED : LASZIP_COMPRESSOR_LAYERED_CHUNKED), version, chunk_sizes[c] };
+        configs.push_back(config);
+      }
+    }
+  }
+  if (configs.size() == 0)
+  {
+    fprintf(stderr, "ERROR: no combination of point type and version selected\n");
+    return 1;
+  }
+
+  FILE* file = stdout;
+  if (output_name)
+  {
+    file = fopen(output_name, "w");
+    if (file == 0)
+    {
+      fprintf(stderr, "ERROR: cannot open '%s' for writing\n", output_name);
+      return 1;
+    }
+  }
+
+  if (json)
+  {
+    fprintf(file, "{\n  \"source\": \"%s\",\n  \"points\": %u,\n  \"repeats\": %u,\n  \"results\": [\n", (file_name ? file_name : "synthetic"), n, repeats);
+  }
+  else
+  {
+    fprintf(file, "point_type,point_size,compressor,version,chunk_size,points,compressed_bytes,bytes_per_point,compress_points_per_second,decompress_points_per_second,compress_peak_heap_bytes,decompress_peak_heap_bytes,verified\n");
+  }
+
+  U32 failed = 0;
+  for (size_t c = 0; c < configs.size(); c++)
+  {
+    const BenchConfig& config = configs[c];
+    BenchResult result;
+    if (!run(config, points, repeats, result))
+    {
+      fprintf(stderr, "ERROR: point type %d with point size %d using %s version %d and chunk size %u failed\n", config.point_type, config.point_size, compressor_name(config.compressor), config.version, config.chunk_size);
+      failed++;
+      continue;
+    }
+    if (!result.verified)
+    {
+      fprintf(stderr, "ERROR: point type %d with point size %d using %s version %d and chunk size %u decompressed different points\n", config.point_type, config.point_size, compressor_name(config.compressor), config.version, config.chunk_size);
+      failed++;
+    }
+    F64 bytes_per_point = (F64)result.compressed_bytes / n;
+    F64 compress_rate = n / result.compress_seconds;
+    F64 decompress_rate = n / result.decompress_seconds;
+    if (json)
+    {
+      fprintf(file, "    { \"point_type\": %d, \"point_size\": %d, \"compressor\": \"%s\", \"version\": %d, \"chunk_size\": %u, \"points\": %u, \"compressed_bytes\": %lld, \"bytes_per_point\": %.4f, \"compress_points_per_second\": %.0f, \"decompress_points_per_second\": %.0f, \"compress_peak_heap_bytes\": %lld, \"decompress_peak_heap_bytes\": %lld, \"verified\": %s }%s\n", config.point_type, config.point_size, compressor_name(config.compressor), config.version, config.chunk_size, n, (long long)result.compressed_bytes, bytes_per_point, compress_rate, decompress_rate, (long long)result.compress_peak_heap, (long long)result.decompress_peak_heap, (result.verified ? "true" : "false"), ((c + 1) < configs.size() ? "," : ""));
+    }
+    else
+    {
+      fprintf(file, "%d,%d,%s,%d,%u,%u,%lld,%.4f,%.0f,%.0f,%lld,%lld,%d\n", config.point_type, config.point_size, compressor_name(config.compressor), config.version, config.chunk_size, n, (long long)result.compressed_bytes, bytes_per_point, compress_rate, decompress_rate, (long long)result.compress_peak_heap, (long long)result.decompress_peak_heap, (result.verified ? 1 : 0));
+    }
+    fflush(file);
+  }
+
+  if (json)
+  {
+    fprintf(file, "  ]\n}\n");
+  }
+  if (file != stdout) fclose(file);
+
+  if (failed)
+  {
+    fprintf(stderr, "ERROR: %u of %u combinations failed\n", failed, (U32)configs.size());
+    return 1;
+  }
+  return 0;
+}
@@ -761,6 +761,30 @@ laszip_write_point
   return 1;
 };
 
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_write_points_def)
+(
+    laszip_POINTER                     pointer
+    , laszip_U32                       number
+    , const laszip_points_struct*      points
+    , laszip_U32*                      number_written
+);
+laszip_write_points_def laszip_write_points_ptr = 0;
+LASZIP_API laszip_I32
+laszip_write_points(
+    laszip_POINTER                     pointer
+    , laszip_U32                       number
+    , const laszip_points_struct*      points
+    , laszip_U32*                      number_written
+)
+{
+  if (laszip_write_points_ptr)
+  {
+    return (*laszip_write_points_ptr)(pointer, number, points, number_written);
+  }
+  return 1;
+}
+
 /*---------------------------------------------------------------------------*/
 typedef laszip_I32 (*laszip_write_indexed_point_def)
 (
@@ -860,6 +884,26 @@ laszip_decompress_selective
   return 1;
 };
 
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_set_decompress_threads_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 decompress_threads
+);
+laszip_set_decompress_threads_def laszip_set_decompress_threads_ptr = 0;
+LASZIP_API laszip_I32
+laszip_set_decompress_threads(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 decompress_threads
+)
+{
+  if (laszip_set_decompress_threads_ptr)
+  {
+    return (*laszip_set_decompress_threads_ptr)(pointer, decompress_threads);
+  }
+  return 1;
+}
+
 /*---------------------------------------------------------------------------*/
 typedef laszip_I32 (*laszip_open_reader_def)
 (
@@ -973,6 +1017,30 @@ laszip_read_point(
   return 1;
 }
 
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_read_points_def)
+(
+    laszip_POINTER                     pointer
+    , laszip_U32                       number
+    , const laszip_points_struct*      points
+    , laszip_U32*                      number_read
+);
+laszip_read_points_def laszip_read_points_ptr = 0;
+LASZIP_API laszip_I32
+laszip_read_points(
+    laszip_POINTER                     pointer
+    , laszip_U32                       number
+    , const laszip_points_struct*      points
+    , laszip_U32*                      number_read
+)
+{
+  if (laszip_read_points_ptr)
+  {
+    return (*laszip_read_points_ptr)(pointer, number, points, number_read);
+  }
+  return 1;
+}
+
 /*---------------------------------------------------------------------------*/
 typedef laszip_I32 (*laszip_read_inside_point_def)
 (
@@ -1200,6 +1268,11 @@ laszip_I32 laszip_load_dll()
      FreeLibrary(laszip_HINSTANCE);
      return 1;
   }
+  laszip_write_points_ptr = (laszip_write_points_def)GetProcAddress(laszip_HINSTANCE, "laszip_write_points");
+  if (laszip_write_points_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
   laszip_write_indexed_point_ptr = (laszip_write_indexed_point_def)GetProcAddress(laszip_HINSTANCE, "laszip_write_indexed_point");
   if (laszip_write_indexed_point_ptr == NULL) {
      FreeLibrary(laszip_HINSTANCE);
@@ -1225,6 +1298,11 @@ laszip_I32 laszip_load_dll()
      FreeLibrary(laszip_HINSTANCE);
      return 1;
   }
+  laszip_set_decompress_threads_ptr = (laszip_set_decompress_threads_def)GetProcAddress(laszip_HINSTANCE, "laszip_set_decompress_threads");
+  if (laszip_set_decompress_threads_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
   laszip_open_reader_ptr = (laszip_open_reader_def)GetProcAddress(laszip_HINSTANCE, "laszip_open_reader");
   if (laszip_open_reader_ptr == NULL) {
      FreeLibrary(laszip_HINSTANCE);
@@ -1250,6 +1328,11 @@ laszip_I32 laszip_load_dll()
      FreeLibrary(laszip_HINSTANCE);
      return 1;
   }
+  laszip_read_points_ptr = (laszip_read_points_def)GetProcAddress(laszip_HINSTANCE, "laszip_read_points");
+  if (laszip_read_points_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
   laszip_read_inside_point_ptr = (laszip_read_inside_point_def)GetProcAddress(laszip_HINSTANCE, "laszip_read_inside_point");
   if (laszip_read_inside_point_ptr == NULL) {
      FreeLibrary(laszip_HINSTANCE);
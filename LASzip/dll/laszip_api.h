@@ -24,6 +24,9 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- laszip_set_decompress_threads() decompresses chunks ahead on several threads
+    18 October 2026 -- laszip_read_points() and laszip_write_points() move entire batches of points
+    18 October 2026 -- laszip_read_points() only reads the points inside laszip_inside_rectangle()
     22 August 2017 -- Add version info.
     4 August 2017 -- 'laszip_set_point_type_and_size()' as minimal setup for ostream writer
     3 August 2017 -- new 'laszip_create_laszip_vlr()' gets VLR as C++ std::vector
@@ -225,6 +228,36 @@ typedef struct laszip_point
 
 } laszip_point_struct;
 
+/* for moving many points per call with laszip_read_points() and laszip_write_points(). */
+/* either as packed LAS point records of 'point_data_record_length' bytes each or as   */
+/* columns with one entry per point. all members that are zero are skipped. the returns */
+/* the classification, and the scan angle (in 0.006 degree increments) are the extended */
+/* LAS 1.4 values for point types 6 to 10 and the legacy values otherwise.             */
+typedef struct laszip_points
+{
+  laszip_U8* records;
+
+  laszip_I32* X;
+  laszip_I32* Y;
+  laszip_I32* Z;
+  laszip_F64* coordinates;             // three per point: scaled and offset x, y, and z
+  laszip_U16* intensity;
+  laszip_U8* return_number;
+  laszip_U8* number_of_returns;
+  laszip_U8* classification;
+  laszip_U8* classification_flags;     // synthetic, keypoint, withheld, and overlap bit
+  laszip_U8* scanner_channel;
+  laszip_U8* scan_direction_flag;
+  laszip_U8* edge_of_flight_line;
+  laszip_I16* scan_angle;
+  laszip_U8* user_data;
+  laszip_U16* point_source_ID;
+  laszip_F64* gps_time;
+  laszip_U16* rgb;                     // four per point: R, G, B, and NIR
+  laszip_U8* extra_bytes;              // as many per point as the point record has
+
+} laszip_points_struct;
+
 typedef void(*laszip_message_handler)(
   enum LAS_MESSAGE_TYPE                type
   , const char*                        msg
@@ -511,6 +544,18 @@ laszip_write_point(
     laszip_POINTER                     pointer
 );
 
+/*---------------------------------------------------------------------------*/
+// writes 'number' points from the records (or from the columns that are not zero
+// while the other attributes keep the value they have in the current point). when
+// the header has no point count the inventory is updated as by laszip_update_inventory()
+LASZIP_API laszip_I32
+laszip_write_points(
+    laszip_POINTER                     pointer
+    , laszip_U32                       number
+    , const laszip_points_struct*      points
+    , laszip_U32*                      number_written
+);
+
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
 laszip_write_indexed_point(
@@ -543,6 +588,15 @@ laszip_decompress_selective(
     , const laszip_U32                 decompress_selective
 );
 
+/*---------------------------------------------------------------------------*/
+// decompress the chunks of LAZ files ahead on this many threads. points are still
+// returned in file order (or in the order of the seeks) by laszip_read_point().
+LASZIP_API laszip_I32
+laszip_set_decompress_threads(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 decompress_threads
+);
+
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
 laszip_open_reader(
@@ -583,6 +637,19 @@ laszip_read_point(
     laszip_POINTER                     pointer
 );
 
+/*---------------------------------------------------------------------------*/
+// reads up to 'number' points into the records and the columns that are not zero.
+// fewer are read only at the end of the file. after laszip_inside_rectangle() only
+// the points inside the rectangle are read (as with laszip_read_inside_point()) and
+// fewer are read once there are no more inside.
+LASZIP_API laszip_I32
+laszip_read_points(
+    laszip_POINTER                     pointer
+    , laszip_U32                       number
+    , const laszip_points_struct*      points
+    , laszip_U32*                      number_read
+);
+
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
 laszip_read_inside_point(
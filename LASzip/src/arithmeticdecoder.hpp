@@ -25,6 +25,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- inline decoding of bits and symbols for faster reading
     22 August 2016 -- can be used as init dummy by "native LAS 1.4 compressor"
     13 November 2014 -- integrity check in readBits(), readByte(), readShort()
      6 September 2014 -- removed the (unused) inheritance from EntropyDecoder
@@ -39,9 +40,9 @@
 
 #include "mydefs.hpp"
 #include "bytestreamin.hpp"
+#include "arithmeticmodel.hpp"
 
-class ArithmeticModel;
-class ArithmeticBitModel;
+#include <cassert>
 
 class ArithmeticDecoder
 {
@@ -66,22 +67,22 @@ public:
   void destroySymbolModel(ArithmeticModel* model);
 
 /* Decode a bit with modelling                               */
-  U32 decodeBit(ArithmeticBitModel* model);
+  inline U32 decodeBit(ArithmeticBitModel* model);
 
 /* Decode a symbol with modelling                            */
-  U32 decodeSymbol(ArithmeticModel* model);
+  inline U32 decodeSymbol(ArithmeticModel* model);
 
 /* Decode a bit without modelling                            */
-  U32 readBit();
+  inline U32 readBit();
 
 /* Decode bits without modelling                             */
-  U32 readBits(U32 bits);
+  inline U32 readBits(U32 bits);
 
 /* Decode an unsigned char without modelling                 */
-  U8 readByte();
+  inline U8 readByte();
 
 /* Decode an unsigned short without modelling                */
-  U16 readShort();
+  inline U16 readShort();
 
 /* Decode an unsigned int without modelling                  */
   U32 readInt();
@@ -102,8 +103,163 @@ private:
 
   ByteStreamIn* instream;
 
-  void renorm_dec_interval();
+  inline void renorm_dec_interval();
   U32 value, length;
 };
 
+/* the decoding of bits and symbols is inlined into the item readers and the
+   integer compressor because it is called several times for every point    */
+
+inline U32 ArithmeticDecoder::decodeBit(ArithmeticBitModel* m)
+{
+  assert(m);
+
+  U32 x = m->bit_0_prob * (length >> BM__LengthShift);       // product l x p0
+  U32 sym = (value >= x);                                          // decision
+                                                    // update & shift interval
+  if (sym == 0) {
+    length  = x;
+    ++m->bit_0_count;
+  }
+  else {
+    value  -= x;                                  // shifted interval base = 0
+    length -= x;
+  }
+
+  if (length < AC__MinLength) renorm_dec_interval();        // renormalization
+  if (--m->bits_until_update == 0) m->update();       // periodic model update
+
+  return sym;                                         // return data bit value
+}
+
+inline U32 ArithmeticDecoder::decodeSymbol(ArithmeticModel* m)
+{
+  U32 n, sym, x, y = length;
+
+  if (m->decoder_table) {             // use table look-up for faster decoding
+
+    unsigned dv = value / (length >>= DM__LengthShift);
+    unsigned t = dv >> m->table_shift;
+
+    sym = m->decoder_table[t];      // initial decision based on table look-up
+    n = m->decoder_table[t+1] + 1;
+
+    while (n > sym + 1) {                      // finish with bisection search
+      U32 k = (sym + n) >> 1;
+      if (m->distribution[k] > dv) n = k; else sym = k;
+    }
+                                                           // compute products
+    x = m->distribution[sym] * length;
+    if (sym != m->last_symbol) y = m->distribution[sym+1] * length;
+  }
+
+  else {                                  // decode using only multiplications
+
+    x = sym = 0;
+    length >>= DM__LengthShift;
+    U32 k = (n = m->symbols) >> 1;
+                                                // decode via bisection search
+    do {
+      U32 z = length * m->distribution[k];
+      if (z > value) {
+        n = k;
+        y = z;                                             // value is smaller
+      }
+      else {
+        sym = k;
+        x = z;                                     // value is larger or equal
+      }
+    } while ((k = (sym + n) >> 1) != sym);
+  }
+
+  value -= x;                                               // update interval
+  length = y - x;
+
+  if (length < AC__MinLength) renorm_dec_interval();        // renormalization
+
+  ++m->symbol_count[sym];
+  if (--m->symbols_until_update == 0) m->update();    // periodic model update
+
+  assert(sym < m->symbols);
+
+  return sym;
+}
+
+inline U32 ArithmeticDecoder::readBit()
+{
+  U32 sym = value / (length >>= 1);            // decode symbol, change length
+  value -= length * sym;                                    // update interval
+
+  if (length < AC__MinLength) renorm_dec_interval();        // renormalization
+
+  if (sym >= 2)
+  {
+    throw 4711;
+  }
+
+  return sym;
+}
+
+inline U32 ArithmeticDecoder::readBits(U32 bits)
+{
+  assert(bits && (bits <= 32));
+
+  if (bits > 19)
+  {
+    U32 tmp = readShort();
+    bits = bits - 16;
+    U32 tmp1 = readBits(bits) << 16;
+    return (tmp1|tmp);
+  }
+
+  U32 sym = value / (length >>= bits);// decode symbol, change length
+  value -= length * sym;                                    // update interval
+
+  if (length < AC__MinLength) renorm_dec_interval();        // renormalization
+
+  if (sym >= (1u<<bits))
+  {
+    throw 4711;
+  }
+
+  return sym;
+}
+
+inline U8 ArithmeticDecoder::readByte()
+{
+  U32 sym = value / (length >>= 8);            // decode symbol, change length
+  value -= length * sym;                                    // update interval
+
+  if (length < AC__MinLength) renorm_dec_interval();        // renormalization
+
+  if (sym >= (1u<<8))
+  {
+    throw 4711;
+  }
+
+  return (U8)sym;
+}
+
+inline U16 ArithmeticDecoder::readShort()
+{
+  U32 sym = value / (length >>= 16);           // decode symbol, change length
+  value -= length * sym;                                    // update interval
+
+  if (length < AC__MinLength) renorm_dec_interval();        // renormalization
+
+  if (sym >= (1u<<16))
+  {
+    throw 4711;
+  }
+
+  return (U16)sym;
+}
+
+inline void ArithmeticDecoder::renorm_dec_interval()
+{
+  do {                                          // read least-significant byte
+    value = (value << 8) | instream->getByte();
+  } while ((length <<= 8) < AC__MinLength);        // length multiplied by 256
+}
+
 #endif
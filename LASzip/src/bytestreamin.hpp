@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- streams held in memory expose their bytes for zero-copy reads
      2 January 2013 -- new functions for reading a stream of groups of bits  
      1 October 2011 -- added 64 bit file support in MSVC 6.0 at McCafe at Hbf Linz
     10 January 2011 -- licensing change for LGPL release and liblas integration
@@ -78,6 +79,8 @@ public:
   virtual BOOL seek(const I64 position) = 0;
 /* seek to the end of the file                               */
   virtual BOOL seekEnd(const I64 distance=0) = 0;
+/* the bytes of a stream that is entirely in memory (or zero) */
+  virtual const U8* getData(I64* size) const { *size = 0; return 0; };
 /* seek to the end of the file                               */
   virtual BOOL skipBytes(const U32 num_bytes) { I64 curr = tell(); return seek(curr + num_bytes); };
 /* constructor                                               */
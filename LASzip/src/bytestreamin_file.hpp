@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
 
+    18 October 2026 -- read single bytes without locking the FILE every time
     22 March 2022 -- Fix fseek for gcc for las/lax file > 2Gb  
      1 October 2011 -- added 64 bit file support in MSVC 6.0 at McCafe at Hbf Linz
     10 January 2011 -- licensing change for LGPL release and liblas integration
@@ -112,7 +113,12 @@ inline ByteStreamInFile::ByteStreamInFile(FILE* file)
 
 inline U32 ByteStreamInFile::getByte()
 {
-  int byte = getc(file);
+  // only this stream reads from the file so its lock does not need to be taken for every byte
+#ifdef _WIN32
+  int byte = _getc_nolock(file);
+#else
+  int byte = getc_unlocked(file);
+#endif
   if (byte == EOF)
   {
     throw EOF;
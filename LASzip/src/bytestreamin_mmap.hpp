@@ -0,0 +1,184 @@
+/*
+===============================================================================
+
+  FILE:  bytestreamin_mmap.hpp
+
+  CONTENTS:
+
+    Reads from a file that is mapped read-only into memory. Seeks are free
+    and the bytes are served straight from the mapping so that the threads
+    decompressing LAZ chunks can access them without locking or copying.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created for random access to LAS/LAZ files on fast disks
+
+===============================================================================
+*/
+#ifndef BYTE_STREAM_IN_MMAP_H
+#define BYTE_STREAM_IN_MMAP_H
+
+#include "bytestreamin_array.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class ByteStreamInMapping
+{
+public:
+  ByteStreamInMapping();
+/* map the entire file read-only into memory                 */
+  const U8* map(const char* file_name, I64* size);
+/* unmap the file                                            */
+  void unmap();
+/* destructor                                                */
+  ~ByteStreamInMapping() { unmap(); };
+private:
+  const U8* data;
+  I64 size;
+#ifdef _WIN32
+  HANDLE file;
+  HANDLE mapping;
+#endif
+};
+
+class ByteStreamInMmapLE : public ByteStreamInArrayLE
+{
+public:
+  ByteStreamInMmapLE() {};
+/* map the file and start reading at its beginning           */
+  BOOL open(const char* file_name);
+/* destructor                                                */
+  ~ByteStreamInMmapLE() {};
+private:
+  ByteStreamInMapping mapping;
+};
+
+class ByteStreamInMmapBE : public ByteStreamInArrayBE
+{
+public:
+  ByteStreamInMmapBE() {};
+/* map the file and start reading at its beginning           */
+  BOOL open(const char* file_name);
+/* destructor                                                */
+  ~ByteStreamInMmapBE() {};
+private:
+  ByteStreamInMapping mapping;
+};
+
+inline ByteStreamInMapping::ByteStreamInMapping()
+{
+  data = 0;
+  size = 0;
+#ifdef _WIN32
+  file = INVALID_HANDLE_VALUE;
+  mapping = 0;
+#endif
+}
+
+inline const U8* ByteStreamInMapping::map(const char* file_name, I64* size)
+{
+  unmap();
+  if (file_name == 0) return 0;
+#ifdef _WIN32
+#ifdef _MSC_VER
+  wchar_t* utf16_file_name = (validate_utf8(file_name) ? UTF8toUTF16(file_name) : ANSItoUTF16(file_name));
+  if (utf16_file_name == 0) return 0;
+  file = CreateFileW(utf16_file_name, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  delete [] utf16_file_name;
+#else
+  file = CreateFileA(file_name, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+#endif
+  if (file == INVALID_HANDLE_VALUE) return 0;
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size) || (file_size.QuadPart == 0))
+  {
+    unmap();
+    return 0;
+  }
+  mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping == 0)
+  {
+    unmap();
+    return 0;
+  }
+  data = (const U8*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (data == 0)
+  {
+    unmap();
+    return 0;
+  }
+  this->size = file_size.QuadPart;
+#else
+  int fd = ::open(file_name, O_RDONLY);
+  if (fd == -1) return 0;
+  struct stat file_stat;
+  if ((fstat(fd, &file_stat) != 0) || (file_stat.st_size == 0))
+  {
+    ::close(fd);
+    return 0;
+  }
+  void* address = mmap(0, (size_t)file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  // the mapping stays valid after closing the descriptor
+  ::close(fd);
+  if (address == MAP_FAILED) return 0;
+  data = (const U8*)address;
+  this->size = (I64)file_stat.st_size;
+#endif
+  *size = this->size;
+  return data;
+}
+
+inline void ByteStreamInMapping::unmap()
+{
+#ifdef _WIN32
+  if (data) UnmapViewOfFile(data);
+  if (mapping) CloseHandle(mapping);
+  if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+  mapping = 0;
+  file = INVALID_HANDLE_VALUE;
+#else
+  if (data) munmap((void*)data, (size_t)size);
+#endif
+  data = 0;
+  size = 0;
+}
+
+inline BOOL ByteStreamInMmapLE::open(const char* file_name)
+{
+  I64 size = 0;
+  const U8* data = mapping.map(file_name, &size);
+  if (data == 0) return FALSE;
+  return init(data, size);
+}
+
+inline BOOL ByteStreamInMmapBE::open(const char* file_name)
+{
+  I64 size = 0;
+  const U8* data = mapping.map(file_name, &size);
+  if (data == 0) return FALSE;
+  return init(data, size);
+}
+
+#endif
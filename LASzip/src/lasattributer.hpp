@@ -25,6 +25,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- merging the min and max of attributes found in parallel
     24 March 2021 -- bug fix for signed long (I32) in set_value_as_float()
     13 September 2018 -- removed tuples and triple support from attributes
     19 July 2015 -- created after FOSS4GE in the train back from Lake Como
@@ -275,6 +276,11 @@ class LASLIB_DLL LASattribute {
   inline void update_max(U8* max) {
     this->max[0] = biggest(cast(max), this->max[0]);
   };
+  // merges the min and max of another copy of the same attribute
+  inline void update_min_max(const LASattribute* attribute) {
+    this->min[0] = smallest(attribute->min[0], this->min[0]);
+    this->max[0] = biggest(attribute->max[0], this->max[0]);
+  };
   inline BOOL set_max(U8 max) {
     if (0 == get_type()) {
       this->max[0].u64 = max;
@@ -247,6 +247,33 @@ BOOL LASindex::get_intervals()
   return interval->get_merged_cell();
 }
 
+U32 LASindex::get_intervals(U32** starts, U32** ends)
+{
+  U32 num_intervals = 0;
+  *starts = 0;
+  *ends = 0;
+  if (interval->get_merged_cell())
+  {
+    while (interval->has_intervals()) num_intervals++;
+    if (num_intervals)
+    {
+      *starts = new U32[num_intervals];
+      *ends = new U32[num_intervals];
+      num_intervals = 0;
+      interval->get_merged_cell();
+      while (interval->has_intervals())
+      {
+        (*starts)[num_intervals] = interval->start;
+        (*ends)[num_intervals] = interval->end;
+        num_intervals++;
+      }
+    }
+    // rewind so that seek_next() starts with the first interval
+    get_intervals();
+  }
+  return num_intervals;
+}
+
 BOOL LASindex::has_intervals()
 {
   if (interval->has_intervals())
@@ -27,6 +27,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- get all intersected intervals at once to decompress ahead
      7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
      7 January 2017 -- add read(FILE* file) for Trimble LASzip DLL improvement
      2 April 2015 -- add seek_next(LASreadPoint* reader, I64 &p_count) for DLL
@@ -82,6 +83,9 @@ public:
   BOOL get_intervals();
   BOOL has_intervals();
 
+  // all intersected intervals at once (caller deletes the arrays)
+  U32 get_intervals(U32** starts, U32** ends);
+
   U32 start;
   U32 end;
   U32 full;
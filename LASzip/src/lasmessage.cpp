@@ -174,8 +174,8 @@ void las_default_message_handler(LAS_MESSAGE_TYPE type, const char* msg, void* u
 
   if (!prefix.empty()) {
     format_message(message, (unsigned)prefix.size());
-    fprintf(stderr, "%s", prefix.c_str());
-    fprintf(stderr, "%s", message.c_str());
+    // one call so that messages from several threads do not interleave
+    fprintf(stderr, "%s%s", prefix.c_str(), message.c_str());
   } else {
     fprintf(stderr, "%s\n", message.c_str());
   }
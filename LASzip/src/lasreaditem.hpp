@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- optional interface for decompressing the layers of a chunk on several threads
     28 August 2017 -- moving 'context' from global development hack to interface  
     23 August 2016 -- layering of items for selective decompression in LAS 1.4 
     10 January 2011 -- licensing change for LGPL release and liblas integration
@@ -70,6 +71,11 @@ public:
   virtual BOOL chunk_sizes() { return FALSE; };
   virtual BOOL init(const U8* item, U32& context)=0;
 
+  // only for layered compression: decompress the layers on several threads
+  virtual BOOL set_layer_threads(const U32 num_threads) { return FALSE; };
+  // only for layered compression: the number of points in the next chunk
+  virtual void set_chunk_count(const U32 count) {};
+
   virtual ~LASreadItemCompressed(){};
 };
 
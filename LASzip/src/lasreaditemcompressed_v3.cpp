@@ -32,8 +32,11 @@
 #include "lasreaditemcompressed_v3.hpp"
 #include "lasmessage.hpp"
 
+#include <atomic>
 #include <cassert>
 #include <string.h>
+#include <thread>
+#include <vector>
 
 typedef struct LASpoint14
 {
@@ -80,6 +83,23 @@ typedef struct LASpoint14
 
 #define LASZIP_GPSTIME_MULTI_TOTAL (LASZIP_GPSTIME_MULTI - LASZIP_GPSTIME_MULTI_MINUS + 5) 
 
+/* the layers of the POINT14 item in the order in which they are decompressed */
+
+#define LASZIP_LAYER_CHANNEL_RETURNS_XY 0
+#define LASZIP_LAYER_Z                  1
+#define LASZIP_LAYER_CLASSIFICATION     2
+#define LASZIP_LAYER_FLAGS              3
+#define LASZIP_LAYER_INTENSITY          4
+#define LASZIP_LAYER_SCAN_ANGLE         5
+#define LASZIP_LAYER_USER_DATA          6
+#define LASZIP_LAYER_POINT_SOURCE       7
+#define LASZIP_LAYER_GPS_TIME           8
+#define LASZIP_LAYER_NUMBER             9
+
+/* decompressing the layers on several threads only pays off for chunks with enough points */
+
+#define LASZIP_LAYER_THREADS_MIN_POINTS 4096
+
 LASreadItemCompressed_POINT14_v3::LASreadItemCompressed_POINT14_v3(ArithmeticDecoder* dec, const U32 decompress_selective)
 {
   /* not used as a decoder. just gives access to instream */
@@ -152,6 +172,26 @@ LASreadItemCompressed_POINT14_v3::LASreadItemCompressed_POINT14_v3(ArithmeticDec
 
   bytes = 0;
   num_bytes_allocated = 0;
+
+  /* by default the layers are decompressed point by point */
+
+  num_layer_threads = 1;
+  chunk_count = 0;
+  layer_start = FALSE;
+  layer_number = 0;
+  layer_index = 0;
+  layer_allocated = 0;
+  layer_items = 0;
+  layer_points = 0;
+  layer_Z = 0;
+  layer_classification = 0;
+  layer_flags = 0;
+  layer_intensity = 0;
+  layer_scan_angle = 0;
+  layer_scan_angle_rank = 0;
+  layer_user_data = 0;
+  layer_point_source = 0;
+  layer_gps_time = 0;
 }
 
 LASreadItemCompressed_POINT14_v3::~LASreadItemCompressed_POINT14_v3()
@@ -223,6 +263,8 @@ LASreadItemCompressed_POINT14_v3::~LASreadItemCompressed_POINT14_v3()
   }
 
   if (bytes) delete [] bytes;
+
+  free_layers();
 }
 
 inline BOOL LASreadItemCompressed_POINT14_v3::createAndInitModelsAndDecompressors(U32 context, const U8* item)
@@ -703,10 +745,16 @@ BOOL LASreadItemCompressed_POINT14_v3::init(const U8* item, U32& context)
 
   createAndInitModelsAndDecompressors(current_context, item);
 
+  /* maybe decompress the layers of this chunk on several threads with the first read */
+
+  layer_start = (num_layer_threads > 1);
+  layer_number = 0;
+  layer_index = 0;
+
   return TRUE;
 }
 
-inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
+inline U8* LASreadItemCompressed_POINT14_v3::read_channel_returns_XY(U32& context, U32& n, U32& r, BOOL& gps_time_change, BOOL& scan_angle_change, BOOL& point_source_change)
 {
   // get last
 
@@ -752,9 +800,9 @@ inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
 
   // determine changed attributes
 
-  BOOL point_source_change = (changed_values & (1 << 5) ? TRUE : FALSE);
-  BOOL gps_time_change = (changed_values & (1 << 4) ? TRUE : FALSE);
-  BOOL scan_angle_change = (changed_values & (1 << 3) ? TRUE : FALSE);
+  point_source_change = (changed_values & (1 << 5) ? TRUE : FALSE);
+  gps_time_change = (changed_values & (1 << 4) ? TRUE : FALSE);
+  scan_angle_change = (changed_values & (1 << 3) ? TRUE : FALSE);
 
   // get last return counts
 
@@ -763,7 +811,6 @@ inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
 
   // if number of returns is different we decompress it
 
-  U32 n;
   if (changed_values & (1 << 2))
   {
     if (contexts[current_context].m_number_of_returns[last_n] == 0)
@@ -781,7 +828,6 @@ inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
 
   // how is the return number different
 
-  U32 r;
   if ((changed_values & 3) == 0) // same return number
   {
     r = last_r;
@@ -844,15 +890,9 @@ inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
     ((LASpoint14*)last_item)->legacy_number_of_returns = n;
   }
 
-  // get return map m and return level l context for current point
+  // get return map m context for current point
 
   U32 m = number_return_map_6ctx[n][r];
-  U32 l = number_return_level_8ctx[n][r];
-
-  // create single (3) / first (1) / last (2) / intermediate (0) return context for current point
-
-  I32 cpr = (r == 1 ? 2 : 0); // first ?
-  cpr += (r >= n ? 1 : 0); // last ?
 
   U32 k_bits;
   I32 median, diff;
@@ -870,6 +910,45 @@ inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
   ((LASpoint14*)last_item)->Y += diff;
   contexts[current_context].last_Y_diff_median5[(m<<1) | gps_time_change].add(diff);
 
+  return last_item;
+}
+
+inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
+{
+  // maybe decompress the layers of this chunk on several threads
+
+  if (layer_start)
+  {
+    layer_start = FALSE;
+    read_layers();
+  }
+
+  if (layer_number)
+  {
+    read_from_layers(item, context);
+    return;
+  }
+
+  U32 n, r;
+  BOOL gps_time_change, scan_angle_change, point_source_change;
+
+  ////////////////////////////////////////
+  // decompress returns_XY layer
+  ////////////////////////////////////////
+
+  U8* last_item = read_channel_returns_XY(context, n, r, gps_time_change, scan_angle_change, point_source_change);
+
+  // get return level l context for current point
+
+  U32 l = number_return_level_8ctx[n][r];
+
+  // create single (3) / first (1) / last (2) / intermediate (0) return context for current point
+
+  I32 cpr = (r == 1 ? 2 : 0); // first ?
+  cpr += (r >= n ? 1 : 0); // last ?
+
+  U32 k_bits;
+
   ////////////////////////////////////////
   // decompress Z layer (if changed and requested)
   ////////////////////////////////////////
@@ -986,7 +1065,7 @@ inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
   {
     if (gps_time_change) // if the GPS time has actually changed
     {
-      read_gps_time();
+      read_gps_time(current_context);
       ((LASpoint14*)last_item)->gps_time = contexts[current_context].last_gpstime[contexts[current_context].last].f64;
     }
   }
@@ -997,70 +1076,70 @@ inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
   ((LASpoint14*)last_item)->gps_time_change = gps_time_change;
 }
 
-void LASreadItemCompressed_POINT14_v3::read_gps_time()
+void LASreadItemCompressed_POINT14_v3::read_gps_time(const U32 context)
 {
   I32 multi;
-  if (contexts[current_context].last_gpstime_diff[contexts[current_context].last] == 0) // if the last integer difference was zero
+  if (contexts[context].last_gpstime_diff[contexts[context].last] == 0) // if the last integer difference was zero
   {
-    multi = dec_gps_time->decodeSymbol(contexts[current_context].m_gpstime_0diff);
+    multi = dec_gps_time->decodeSymbol(contexts[context].m_gpstime_0diff);
     if (multi == 0) // the difference can be represented with 32 bits
     {
-      contexts[current_context].last_gpstime_diff[contexts[current_context].last] = contexts[current_context].ic_gpstime->decompress(0, 0);
-      contexts[current_context].last_gpstime[contexts[current_context].last].i64 += contexts[current_context].last_gpstime_diff[contexts[current_context].last];
-      contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0; 
+      contexts[context].last_gpstime_diff[contexts[context].last] = contexts[context].ic_gpstime->decompress(0, 0);
+      contexts[context].last_gpstime[contexts[context].last].i64 += contexts[context].last_gpstime_diff[contexts[context].last];
+      contexts[context].multi_extreme_counter[contexts[context].last] = 0; 
     }
     else if (multi == 1) // the difference is huge
     {
-      contexts[current_context].next = (contexts[current_context].next+1)&3;
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 = contexts[current_context].ic_gpstime->decompress((I32)(contexts[current_context].last_gpstime[contexts[current_context].last].u64 >> 32), 8);
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 = contexts[current_context].last_gpstime[contexts[current_context].next].u64 << 32;
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 |= dec_gps_time->readInt();
-      contexts[current_context].last = contexts[current_context].next;
-      contexts[current_context].last_gpstime_diff[contexts[current_context].last] = 0;
-      contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0; 
+      contexts[context].next = (contexts[context].next+1)&3;
+      contexts[context].last_gpstime[contexts[context].next].u64 = contexts[context].ic_gpstime->decompress((I32)(contexts[context].last_gpstime[contexts[context].last].u64 >> 32), 8);
+      contexts[context].last_gpstime[contexts[context].next].u64 = contexts[context].last_gpstime[contexts[context].next].u64 << 32;
+      contexts[context].last_gpstime[contexts[context].next].u64 |= dec_gps_time->readInt();
+      contexts[context].last = contexts[context].next;
+      contexts[context].last_gpstime_diff[contexts[context].last] = 0;
+      contexts[context].multi_extreme_counter[contexts[context].last] = 0; 
     }
     else // we switch to another sequence
     {
-      contexts[current_context].last = (contexts[current_context].last+multi-1)&3;
-      read_gps_time();
+      contexts[context].last = (contexts[context].last+multi-1)&3;
+      read_gps_time(context);
     }
   }
   else
   {
-    multi = dec_gps_time->decodeSymbol(contexts[current_context].m_gpstime_multi);
+    multi = dec_gps_time->decodeSymbol(contexts[context].m_gpstime_multi);
     if (multi == 1)
     {
-      contexts[current_context].last_gpstime[contexts[current_context].last].i64 += contexts[current_context].ic_gpstime->decompress(contexts[current_context].last_gpstime_diff[contexts[current_context].last], 1);;
-      contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0;
+      contexts[context].last_gpstime[contexts[context].last].i64 += contexts[context].ic_gpstime->decompress(contexts[context].last_gpstime_diff[contexts[context].last], 1);;
+      contexts[context].multi_extreme_counter[contexts[context].last] = 0;
     }
     else if (multi < LASZIP_GPSTIME_MULTI_CODE_FULL)
     {
       I32 gpstime_diff;
       if (multi == 0)
       {
-        gpstime_diff = contexts[current_context].ic_gpstime->decompress(0, 7);
-        contexts[current_context].multi_extreme_counter[contexts[current_context].last]++;
-        if (contexts[current_context].multi_extreme_counter[contexts[current_context].last] > 3)
+        gpstime_diff = contexts[context].ic_gpstime->decompress(0, 7);
+        contexts[context].multi_extreme_counter[contexts[context].last]++;
+        if (contexts[context].multi_extreme_counter[contexts[context].last] > 3)
         {
-          contexts[current_context].last_gpstime_diff[contexts[current_context].last] = gpstime_diff;
-          contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0;
+          contexts[context].last_gpstime_diff[contexts[context].last] = gpstime_diff;
+          contexts[context].multi_extreme_counter[contexts[context].last] = 0;
         }
       }
       else if (multi < LASZIP_GPSTIME_MULTI)
       {
         if (multi < 10)
-          gpstime_diff = contexts[current_context].ic_gpstime->decompress(multi*contexts[current_context].last_gpstime_diff[contexts[current_context].last], 2);
+          gpstime_diff = contexts[context].ic_gpstime->decompress(multi*contexts[context].last_gpstime_diff[contexts[context].last], 2);
         else
-          gpstime_diff = contexts[current_context].ic_gpstime->decompress(multi*contexts[current_context].last_gpstime_diff[contexts[current_context].last], 3);
+          gpstime_diff = contexts[context].ic_gpstime->decompress(multi*contexts[context].last_gpstime_diff[contexts[context].last], 3);
       }
       else if (multi == LASZIP_GPSTIME_MULTI)
       {
-        gpstime_diff = contexts[current_context].ic_gpstime->decompress(LASZIP_GPSTIME_MULTI*contexts[current_context].last_gpstime_diff[contexts[current_context].last], 4);
-        contexts[current_context].multi_extreme_counter[contexts[current_context].last]++;
-        if (contexts[current_context].multi_extreme_counter[contexts[current_context].last] > 3)
+        gpstime_diff = contexts[context].ic_gpstime->decompress(LASZIP_GPSTIME_MULTI*contexts[context].last_gpstime_diff[contexts[context].last], 4);
+        contexts[context].multi_extreme_counter[contexts[context].last]++;
+        if (contexts[context].multi_extreme_counter[contexts[context].last] > 3)
         {
-          contexts[current_context].last_gpstime_diff[contexts[current_context].last] = gpstime_diff;
-          contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0;
+          contexts[context].last_gpstime_diff[contexts[context].last] = gpstime_diff;
+          contexts[context].multi_extreme_counter[contexts[context].last] = 0;
         }
       }
       else
@@ -1068,39 +1147,467 @@ void LASreadItemCompressed_POINT14_v3::read_gps_time()
         multi = LASZIP_GPSTIME_MULTI - multi;
         if (multi > LASZIP_GPSTIME_MULTI_MINUS)
         {
-          gpstime_diff = contexts[current_context].ic_gpstime->decompress(multi*contexts[current_context].last_gpstime_diff[contexts[current_context].last], 5);
+          gpstime_diff = contexts[context].ic_gpstime->decompress(multi*contexts[context].last_gpstime_diff[contexts[context].last], 5);
         }
         else
         {
-          gpstime_diff = contexts[current_context].ic_gpstime->decompress(LASZIP_GPSTIME_MULTI_MINUS*contexts[current_context].last_gpstime_diff[contexts[current_context].last], 6);
-          contexts[current_context].multi_extreme_counter[contexts[current_context].last]++;
-          if (contexts[current_context].multi_extreme_counter[contexts[current_context].last] > 3)
+          gpstime_diff = contexts[context].ic_gpstime->decompress(LASZIP_GPSTIME_MULTI_MINUS*contexts[context].last_gpstime_diff[contexts[context].last], 6);
+          contexts[context].multi_extreme_counter[contexts[context].last]++;
+          if (contexts[context].multi_extreme_counter[contexts[context].last] > 3)
           {
-            contexts[current_context].last_gpstime_diff[contexts[current_context].last] = gpstime_diff;
-            contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0;
+            contexts[context].last_gpstime_diff[contexts[context].last] = gpstime_diff;
+            contexts[context].multi_extreme_counter[contexts[context].last] = 0;
           }
         }
       }
-      contexts[current_context].last_gpstime[contexts[current_context].last].i64 += gpstime_diff;
+      contexts[context].last_gpstime[contexts[context].last].i64 += gpstime_diff;
     }
     else if (multi ==  LASZIP_GPSTIME_MULTI_CODE_FULL)
     {
-      contexts[current_context].next = (contexts[current_context].next+1)&3;
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 = contexts[current_context].ic_gpstime->decompress((I32)(contexts[current_context].last_gpstime[contexts[current_context].last].u64 >> 32), 8);
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 = contexts[current_context].last_gpstime[contexts[current_context].next].u64 << 32;
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 |= dec_gps_time->readInt();
-      contexts[current_context].last = contexts[current_context].next;
-      contexts[current_context].last_gpstime_diff[contexts[current_context].last] = 0;
-      contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0; 
+      contexts[context].next = (contexts[context].next+1)&3;
+      contexts[context].last_gpstime[contexts[context].next].u64 = contexts[context].ic_gpstime->decompress((I32)(contexts[context].last_gpstime[contexts[context].last].u64 >> 32), 8);
+      contexts[context].last_gpstime[contexts[context].next].u64 = contexts[context].last_gpstime[contexts[context].next].u64 << 32;
+      contexts[context].last_gpstime[contexts[context].next].u64 |= dec_gps_time->readInt();
+      contexts[context].last = contexts[context].next;
+      contexts[context].last_gpstime_diff[contexts[context].last] = 0;
+      contexts[context].multi_extreme_counter[contexts[context].last] = 0; 
     }
     else if (multi >=  LASZIP_GPSTIME_MULTI_CODE_FULL)
     {
-      contexts[current_context].last = (contexts[current_context].last+multi-LASZIP_GPSTIME_MULTI_CODE_FULL)&3;
-      read_gps_time();
+      contexts[context].last = (contexts[context].last+multi-LASZIP_GPSTIME_MULTI_CODE_FULL)&3;
+      read_gps_time(context);
     }
   }
 }
 
+BOOL LASreadItemCompressed_POINT14_v3::set_layer_threads(const U32 num_threads)
+{
+  num_layer_threads = (num_threads ? num_threads : 1);
+  return TRUE;
+}
+
+void LASreadItemCompressed_POINT14_v3::set_chunk_count(const U32 count)
+{
+  chunk_count = count;
+}
+
+BOOL LASreadItemCompressed_POINT14_v3::read_layers()
+{
+  /* the first point of the chunk was read raw */
+
+  U32 number = (chunk_count ? chunk_count - 1 : 0);
+  chunk_count = 0;
+
+  /* which layers change within this chunk (the most expensive first) */
+
+  U32 layers[8];
+  U32 num_layers = 0;
+  if (changed_gps_time) layers[num_layers++] = LASZIP_LAYER_GPS_TIME;
+  if (changed_Z) layers[num_layers++] = LASZIP_LAYER_Z;
+  if (changed_intensity) layers[num_layers++] = LASZIP_LAYER_INTENSITY;
+  if (changed_classification) layers[num_layers++] = LASZIP_LAYER_CLASSIFICATION;
+  if (changed_flags) layers[num_layers++] = LASZIP_LAYER_FLAGS;
+  if (changed_scan_angle) layers[num_layers++] = LASZIP_LAYER_SCAN_ANGLE;
+  if (changed_point_source) layers[num_layers++] = LASZIP_LAYER_POINT_SOURCE;
+  if (changed_user_data) layers[num_layers++] = LASZIP_LAYER_USER_DATA;
+
+  if ((num_layers < 2) || (number < LASZIP_LAYER_THREADS_MIN_POINTS))
+  {
+    return FALSE;
+  }
+
+  /* make sure the buffers are sufficiently large */
+
+  if (number > layer_allocated)
+  {
+    free_layers();
+    layer_items = new U8[(size_t)number*sizeof(LASpoint14)];
+    layer_points = new LayerPoint[number];
+    layer_Z = new I32[number];
+    layer_classification = new U8[number];
+    layer_flags = new U8[number];
+    layer_intensity = new U16[number];
+    layer_scan_angle = new I16[number];
+    layer_scan_angle_rank = new I8[number];
+    layer_user_data = new U8[number];
+    layer_point_source = new U16[number];
+    layer_gps_time = new F64[number];
+    layer_allocated = number;
+  }
+
+  /* decompress the channel_returns_XY layer of all points because all other layers depend on it */
+
+  U32 c, i = 0;
+  BOOL used[4];
+  for (c = 0; c < 4; c++)
+  {
+    used[c] = !contexts[c].unused;
+  }
+  for (c = 0; c < LASZIP_LAYER_NUMBER; c++)
+  {
+    layer_failed[c] = U32_MAX;
+    layer_exception[c] = 0;
+  }
+  layer_failed[LASZIP_LAYER_CHANNEL_RETURNS_XY] = number;
+  layer_exception[LASZIP_LAYER_CHANNEL_RETURNS_XY] = EOF;
+
+  try
+  {
+    for (i = 0; i < number; i++)
+    {
+      LayerPoint* point = &(layer_points[i]);
+      U32 from = current_context;
+      U32 n, r;
+      BOOL gps_time_change, scan_angle_change, point_source_change;
+      U32 unused_context;
+      U8* last_item = read_channel_returns_XY(unused_context, n, r, gps_time_change, scan_angle_change, point_source_change);
+      point->context = (U8)current_context;
+      point->switched = (current_context != from);
+      point->created = (point->switched && !used[current_context]);
+      point->from = (U8)from;
+      used[current_context] = TRUE;
+      point->n = (U8)n;
+      point->l = (U8)number_return_level_8ctx[n][r];
+      point->cpr = (U8)((r == 1 ? 2 : 0) + (r >= n ? 1 : 0));
+      point->k_bits = (U8)((contexts[current_context].ic_dX->getK() + contexts[current_context].ic_dY->getK()) / 2);
+      point->gps_time_change = (U8)gps_time_change;
+      point->scan_angle_change = (U8)scan_angle_change;
+      point->point_source_change = (U8)point_source_change;
+      memcpy(&(layer_items[(size_t)i*sizeof(LASpoint14)]), last_item, sizeof(LASpoint14));
+      ((LASpoint14*)last_item)->gps_time_change = gps_time_change;
+    }
+  }
+  catch (I32 exception)
+  {
+    layer_failed[LASZIP_LAYER_CHANNEL_RETURNS_XY] = i;
+    layer_exception[LASZIP_LAYER_CHANNEL_RETURNS_XY] = exception;
+  }
+
+  /* then decompress the other layers of these points independently on several threads */
+
+  U32 decoded = MIN2(number, layer_failed[LASZIP_LAYER_CHANNEL_RETURNS_XY]);
+  std::atomic<U32> next_layer(0);
+  U32 num_threads = MIN2(num_layer_threads, num_layers);
+  std::vector<std::thread> threads;
+  for (c = 1; c < num_threads; c++)
+  {
+    threads.push_back(std::thread([&]() {
+      U32 j;
+      while ((j = next_layer++) < num_layers)
+      {
+        read_layer(layers[j], decoded);
+      }
+    }));
+  }
+  U32 j;
+  while ((j = next_layer++) < num_layers)
+  {
+    read_layer(layers[j], decoded);
+  }
+  for (c = 0; c < threads.size(); c++)
+  {
+    threads[c].join();
+  }
+
+  layer_number = number;
+  layer_index = 0;
+  return TRUE;
+}
+
+void LASreadItemCompressed_POINT14_v3::read_layer(const U32 layer, const U32 number)
+{
+  /* each layer only depends on its own values of the previous point with the same scanner channel */
+  /* and on the context values from the channel_returns_XY layer. when a scanner channel is first */
+  /* used in the chunk its context starts with the values that the previous scanner channel had. */
+
+  U32 c, i = 0;
+  try
+  {
+    switch (layer)
+    {
+    case LASZIP_LAYER_Z:
+      {
+        I32 Z[4];
+        for (c = 0; c < 4; c++) Z[c] = ((LASpoint14*)contexts[c].last_item)->Z;
+        for (i = 0; i < number; i++)
+        {
+          const LayerPoint* point = &(layer_points[i]);
+          LAScontextPOINT14* context = &(contexts[point->context]);
+          if (point->created)
+          {
+            Z[point->context] = Z[point->from];
+            for (c = 0; c < 8; c++) context->last_Z[c] = Z[point->from];
+          }
+          U32 k_bits = point->k_bits;
+          Z[point->context] = context->ic_Z->decompress(context->last_Z[point->l], (point->n==1) + (k_bits < 18 ? U32_ZERO_BIT_0(k_bits) : 18));
+          context->last_Z[point->l] = Z[point->context];
+          layer_Z[i] = Z[point->context];
+        }
+      }
+      break;
+    case LASZIP_LAYER_CLASSIFICATION:
+      {
+        U8 classification[4];
+        for (c = 0; c < 4; c++) classification[c] = ((LASpoint14*)contexts[c].last_item)->classification;
+        for (i = 0; i < number; i++)
+        {
+          const LayerPoint* point = &(layer_points[i]);
+          LAScontextPOINT14* context = &(contexts[point->context]);
+          if (point->created)
+          {
+            classification[point->context] = classification[point->from];
+          }
+          I32 ccc = ((classification[point->context] & 0x1F) << 1) + (point->cpr == 3 ? 1 : 0);
+          if (context->m_classification[ccc] == 0)
+          {
+            context->m_classification[ccc] = dec_classification->createSymbolModel(256);
+            dec_classification->initSymbolModel(context->m_classification[ccc]);
+          }
+          classification[point->context] = dec_classification->decodeSymbol(context->m_classification[ccc]);
+          layer_classification[i] = classification[point->context];
+        }
+      }
+      break;
+    case LASZIP_LAYER_FLAGS:
+      {
+        U8 flags[4];
+        for (c = 0; c < 4; c++) flags[c] = (((LASpoint14*)contexts[c].last_item)->edge_of_flight_line << 5) | (((LASpoint14*)contexts[c].last_item)->scan_direction_flag << 4) | ((LASpoint14*)contexts[c].last_item)->classification_flags;
+        for (i = 0; i < number; i++)
+        {
+          const LayerPoint* point = &(layer_points[i]);
+          LAScontextPOINT14* context = &(contexts[point->context]);
+          if (point->created)
+          {
+            flags[point->context] = flags[point->from];
+          }
+          U32 last_flags = flags[point->context];
+          if (context->m_flags[last_flags] == 0)
+          {
+            context->m_flags[last_flags] = dec_flags->createSymbolModel(64);
+            dec_flags->initSymbolModel(context->m_flags[last_flags]);
+          }
+          flags[point->context] = dec_flags->decodeSymbol(context->m_flags[last_flags]);
+          layer_flags[i] = flags[point->context];
+        }
+      }
+      break;
+    case LASZIP_LAYER_INTENSITY:
+      {
+        U16 intensity[4];
+        for (c = 0; c < 4; c++) intensity[c] = ((LASpoint14*)contexts[c].last_item)->intensity;
+        for (i = 0; i < number; i++)
+        {
+          const LayerPoint* point = &(layer_points[i]);
+          LAScontextPOINT14* context = &(contexts[point->context]);
+          if (point->created)
+          {
+            intensity[point->context] = intensity[point->from];
+            for (c = 0; c < 8; c++) context->last_intensity[c] = intensity[point->from];
+          }
+          U32 cpr = point->cpr;
+          intensity[point->context] = context->ic_intensity->decompress(context->last_intensity[(cpr<<1) | point->gps_time_change], cpr);
+          context->last_intensity[(cpr<<1) | point->gps_time_change] = intensity[point->context];
+          layer_intensity[i] = intensity[point->context];
+        }
+      }
+      break;
+    case LASZIP_LAYER_SCAN_ANGLE:
+      {
+        I16 scan_angle[4];
+        I8 scan_angle_rank[4];
+        for (c = 0; c < 4; c++)
+        {
+          scan_angle[c] = ((LASpoint14*)contexts[c].last_item)->scan_angle;
+          scan_angle_rank[c] = ((LASpoint14*)contexts[c].last_item)->legacy_scan_angle_rank;
+        }
+        for (i = 0; i < number; i++)
+        {
+          const LayerPoint* point = &(layer_points[i]);
+          LAScontextPOINT14* context = &(contexts[point->context]);
+          if (point->created)
+          {
+            scan_angle[point->context] = scan_angle[point->from];
+            scan_angle_rank[point->context] = scan_angle_rank[point->from];
+          }
+          if (point->scan_angle_change) // if the scan angle has actually changed
+          {
+            scan_angle[point->context] = context->ic_scan_angle->decompress(scan_angle[point->context], point->gps_time_change); // if the GPS time has changed
+            scan_angle_rank[point->context] = I8_CLAMP(I16_QUANTIZE(0.006f*scan_angle[point->context]));
+          }
+          layer_scan_angle[i] = scan_angle[point->context];
+          layer_scan_angle_rank[i] = scan_angle_rank[point->context];
+        }
+      }
+      break;
+    case LASZIP_LAYER_USER_DATA:
+      {
+        U8 user_data[4];
+        for (c = 0; c < 4; c++) user_data[c] = ((LASpoint14*)contexts[c].last_item)->user_data;
+        for (i = 0; i < number; i++)
+        {
+          const LayerPoint* point = &(layer_points[i]);
+          LAScontextPOINT14* context = &(contexts[point->context]);
+          if (point->created)
+          {
+            user_data[point->context] = user_data[point->from];
+          }
+          U32 last_user_data = user_data[point->context]/4;
+          if (context->m_user_data[last_user_data] == 0)
+          {
+            context->m_user_data[last_user_data] = dec_user_data->createSymbolModel(256);
+            dec_user_data->initSymbolModel(context->m_user_data[last_user_data]);
+          }
+          user_data[point->context] = dec_user_data->decodeSymbol(context->m_user_data[last_user_data]);
+          layer_user_data[i] = user_data[point->context];
+        }
+      }
+      break;
+    case LASZIP_LAYER_POINT_SOURCE:
+      {
+        U16 point_source_ID[4];
+        for (c = 0; c < 4; c++) point_source_ID[c] = ((LASpoint14*)contexts[c].last_item)->point_source_ID;
+        for (i = 0; i < number; i++)
+        {
+          const LayerPoint* point = &(layer_points[i]);
+          if (point->created)
+          {
+            point_source_ID[point->context] = point_source_ID[point->from];
+          }
+          if (point->point_source_change) // if the point source ID has actually changed
+          {
+            point_source_ID[point->context] = contexts[point->context].ic_point_source_ID->decompress(point_source_ID[point->context]);
+          }
+          layer_point_source[i] = point_source_ID[point->context];
+        }
+      }
+      break;
+    case LASZIP_LAYER_GPS_TIME:
+      {
+        F64 gps_time[4];
+        for (c = 0; c < 4; c++) gps_time[c] = ((LASpoint14*)contexts[c].last_item)->gps_time;
+        for (i = 0; i < number; i++)
+        {
+          const LayerPoint* point = &(layer_points[i]);
+          LAScontextPOINT14* context = &(contexts[point->context]);
+          if (point->created)
+          {
+            gps_time[point->context] = gps_time[point->from];
+            context->last = 0, context->next = 0;
+            for (c = 0; c < 4; c++)
+            {
+              context->last_gpstime_diff[c] = 0;
+              context->multi_extreme_counter[c] = 0;
+              context->last_gpstime[c].u64 = 0;
+            }
+            context->last_gpstime[0].f64 = gps_time[point->from];
+          }
+          if (point->gps_time_change) // if the GPS time has actually changed
+          {
+            read_gps_time(point->context);
+            gps_time[point->context] = context->last_gpstime[context->last].f64;
+          }
+          layer_gps_time[i] = gps_time[point->context];
+        }
+      }
+      break;
+    }
+  }
+  catch (I32 exception)
+  {
+    layer_failed[layer] = i;
+    layer_exception[layer] = exception;
+  }
+}
+
+void LASreadItemCompressed_POINT14_v3::read_from_layers(U8* item, U32& context)
+{
+  U32 i = layer_index++;
+
+  /* fail where decompressing the point by point would have failed */
+
+  U32 layer;
+  for (layer = 0; layer < LASZIP_LAYER_NUMBER; layer++)
+  {
+    if (i >= layer_failed[layer]) throw layer_exception[layer];
+  }
+
+  /* the point after the channel_returns_XY layer completed with the other decompressed layers */
+
+  const LayerPoint* point = &(layer_points[i]);
+  memcpy(item, &(layer_items[(size_t)i*sizeof(LASpoint14)]), sizeof(LASpoint14));
+
+  if (changed_Z)
+  {
+    ((LASpoint14*)item)->Z = layer_Z[i];
+  }
+  if (changed_classification)
+  {
+    ((LASpoint14*)item)->classification = layer_classification[i];
+    ((LASpoint14*)item)->legacy_classification = (layer_classification[i] < 32 ? layer_classification[i] : 0);
+  }
+  if (changed_flags)
+  {
+    U32 flags = layer_flags[i];
+    ((LASpoint14*)item)->edge_of_flight_line = !!(flags & (1 << 5));
+    ((LASpoint14*)item)->scan_direction_flag = !!(flags & (1 << 4));
+    ((LASpoint14*)item)->classification_flags = (flags & 0x0F);
+    ((LASpoint14*)item)->legacy_flags = (flags & 0x07);
+  }
+  if (changed_intensity)
+  {
+    ((LASpoint14*)item)->intensity = layer_intensity[i];
+  }
+  if (changed_scan_angle)
+  {
+    ((LASpoint14*)item)->scan_angle = layer_scan_angle[i];
+    ((LASpoint14*)item)->legacy_scan_angle_rank = layer_scan_angle_rank[i];
+  }
+  if (changed_user_data)
+  {
+    ((LASpoint14*)item)->user_data = layer_user_data[i];
+  }
+  if (changed_point_source)
+  {
+    ((LASpoint14*)item)->point_source_ID = layer_point_source[i];
+  }
+  if (changed_gps_time)
+  {
+    ((LASpoint14*)item)->gps_time = layer_gps_time[i];
+  }
+
+  if (point->switched)
+  {
+    context = point->context; // the POINT14 reader sets context for all other items
+  }
+}
+
+void LASreadItemCompressed_POINT14_v3::free_layers()
+{
+  if (layer_items) delete [] layer_items;
+  if (layer_points) delete [] layer_points;
+  if (layer_Z) delete [] layer_Z;
+  if (layer_classification) delete [] layer_classification;
+  if (layer_flags) delete [] layer_flags;
+  if (layer_intensity) delete [] layer_intensity;
+  if (layer_scan_angle) delete [] layer_scan_angle;
+  if (layer_scan_angle_rank) delete [] layer_scan_angle_rank;
+  if (layer_user_data) delete [] layer_user_data;
+  if (layer_point_source) delete [] layer_point_source;
+  if (layer_gps_time) delete [] layer_gps_time;
+  layer_items = 0;
+  layer_points = 0;
+  layer_Z = 0;
+  layer_classification = 0;
+  layer_flags = 0;
+  layer_intensity = 0;
+  layer_scan_angle = 0;
+  layer_scan_angle_rank = 0;
+  layer_user_data = 0;
+  layer_point_source = 0;
+  layer_gps_time = 0;
+  layer_allocated = 0;
+}
+
 /*
 ===============================================================================
                        LASreadItemCompressed_RGB14_v3
@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- optionally decompress the layers of a chunk on several threads
     30 December 2021 -- fix small memory leak
     19 March 2019 -- set "legacy classification" to zero if "classification > 31"  
     28 August 2017 -- moving 'context' from global development hack to interface  
@@ -53,6 +54,9 @@ public:
   BOOL init(const U8* item, U32& context); // context is set
   void read(U8* item, U32& context);       // context is set
 
+  BOOL set_layer_threads(const U32 num_threads);
+  void set_chunk_count(const U32 count);
+
   ~LASreadItemCompressed_POINT14_v3();
 
 private:
@@ -116,7 +120,50 @@ private:
   LAScontextPOINT14 contexts[4];
 
   BOOL createAndInitModelsAndDecompressors(U32 context, const U8* item);
-  void read_gps_time();
+  U8* read_channel_returns_XY(U32& context, U32& n, U32& r, BOOL& gps_time_change, BOOL& scan_angle_change, BOOL& point_source_change);
+  void read_gps_time(const U32 context);
+
+  /* for decompressing the layers of a chunk on several threads */
+
+  struct LayerPoint
+  {
+    U8 context;
+    U8 switched;
+    U8 created;
+    U8 from;
+    U8 n;
+    U8 l;
+    U8 cpr;
+    U8 k_bits;
+    U8 gps_time_change;
+    U8 scan_angle_change;
+    U8 point_source_change;
+  };
+
+  U32 num_layer_threads;
+  U32 chunk_count;
+  BOOL layer_start;
+  U32 layer_number;
+  U32 layer_index;
+  U32 layer_allocated;
+  U8* layer_items;
+  LayerPoint* layer_points;
+  I32* layer_Z;
+  U8* layer_classification;
+  U8* layer_flags;
+  U16* layer_intensity;
+  I16* layer_scan_angle;
+  I8* layer_scan_angle_rank;
+  U8* layer_user_data;
+  U16* layer_point_source;
+  F64* layer_gps_time;
+  U32 layer_failed[9];
+  I32 layer_exception[9];
+
+  BOOL read_layers();
+  void read_layer(const U32 layer, const U32 number);
+  void read_from_layers(U8* item, U32& context);
+  void free_layers();
 };
 
 class LASreadItemCompressed_RGB14_v3 : public LASreadItemCompressed
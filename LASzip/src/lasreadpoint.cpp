@@ -42,6 +42,147 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// the LAS 1.4 point readers hand over the combo point struct from X up to and including rgb[4]
+#define LASZIP_POINT14_COMBO_STRUCT_SIZE 48
+
+// states of a chunk buffer used for multi-threaded decompression
+#define LASZIP_CHUNK_EMPTY   0
+#define LASZIP_CHUNK_BUSY    1
+#define LASZIP_CHUNK_READY   2
+#define LASZIP_CHUNK_CORRUPT 3
+#define LASZIP_CHUNK_EOF     4
+
+class LASreadPointChunk
+{
+public:
+  U32 index;
+  U32 number;
+  U32 generation;
+  U32 state;
+  U32 count;
+  U32 allocated;
+  U8* records;
+};
+
+class LASreadPointThreads
+{
+public:
+  std::vector<std::thread> workers;
+  std::vector<LASreadPoint*> decoders;
+  // guards the chunk buffers and the window of chunks being decompressed
+  std::mutex mutex;
+  std::condition_variable chunk_done;
+  std::condition_variable chunk_free;
+  // serializes reading the compressed chunks from the shared stream
+  std::mutex io;
+  BOOL stop;
+  U32 num_chunks;
+  LASreadPointChunk* chunks;
+  // the chunk that is currently handed out is 'first' and the workers
+  // decompress ahead up to 'num_chunks' chunks in the window that follows
+  U32 first;
+  LASreadPointChunk* current;
+  U32 current_point;
+  // the increasing list of chunks overlapped by the intervals that will be
+  // read. if it is not empty then 'first' and the chunk 'index' are positions
+  // in this list rather than chunk numbers.
+  std::vector<U32> scheduled;
+  BOOL reschedule;
+  // changes whenever the meaning of the positions changes
+  U32 generation;
+  // layout of one decompressed point inside the chunk buffers
+  U32 record_size;
+  U32* item_offsets;
+  U32* item_bytes;
+};
+
+// the decompressed chunks of all readers that were given a cache key. the
+// least recently used chunks are evicted once the byte budget is exceeded.
+class LASreadPointCache
+{
+public:
+  class Entry
+  {
+  public:
+    std::string key;
+    U32 count;
+    U32 record_size;
+    U8* records;
+  };
+  std::mutex mutex;
+  I64 size;
+  I64 used;
+  std::list<Entry> entries; // most recently used first
+  std::unordered_map<std::string, std::list<Entry>::iterator> lookup;
+
+  void evict(const I64 budget)
+  {
+    while ((used > budget) && entries.size())
+    {
+      Entry& entry = entries.back();
+      used -= (I64)entry.count*entry.record_size;
+      free(entry.records);
+      lookup.erase(entry.key);
+      entries.pop_back();
+    }
+  };
+
+  BOOL get(const std::string& key, const U32 count, const U32 record_size, U8* records)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<std::string, std::list<Entry>::iterator>::iterator it = lookup.find(key);
+    if (it == lookup.end()) return FALSE;
+    Entry& entry = *(it->second);
+    if ((entry.count != count) || (entry.record_size != record_size)) return FALSE;
+    memcpy(records, entry.records, (size_t)count*record_size);
+    entries.splice(entries.begin(), entries, it->second);
+    return TRUE;
+  };
+
+  void put(const std::string& key, const U32 count, const U32 record_size, const U8* records)
+  {
+    I64 bytes = (I64)count*record_size;
+    std::lock_guard<std::mutex> lock(mutex);
+    if ((bytes == 0) || (bytes > size) || lookup.count(key)) return;
+    evict(size - bytes);
+    Entry entry;
+    entry.key = key;
+    entry.count = count;
+    entry.record_size = record_size;
+    entry.records = (U8*)malloc((size_t)bytes);
+    if (entry.records == 0) return;
+    memcpy(entry.records, records, (size_t)bytes);
+    entries.push_front(entry);
+    lookup[key] = entries.begin();
+    used += bytes;
+  };
+
+  LASreadPointCache() { size = 0; used = 0; };
+  ~LASreadPointCache() { evict(0); };
+};
+
+static LASreadPointCache& chunk_cache()
+{
+  static LASreadPointCache cache;
+  return cache;
+}
+
+void LASreadPoint::set_cache_size(const I64 cache_size)
+{
+  LASreadPointCache& cache = chunk_cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.size = (cache_size > 0 ? cache_size : 0);
+  cache.evict(cache.size);
+}
+
 LASreadPoint::LASreadPoint(U32 decompress_selective)
 {
   point_size = 0;
@@ -65,6 +206,16 @@ LASreadPoint::LASreadPoint(U32 decompress_selective)
   // used for seeking
   point_start = 0;
   seek_point = 0;
+  // used for multi-threaded decompression
+  items = 0;
+  laszip = 0;
+  num_threads = 0;
+  num_points = 0;
+  num_layer_threads = 1;
+  threads = 0;
+  num_intervals = 0;
+  intervals = 0;
+  cache_key = 0;
   // used for error and warning reporting
   last_error = 0;
   last_warning = 0;
@@ -111,6 +262,8 @@ BOOL LASreadPoint::setup(U32 num_items, const LASitem* items, const LASzip* lasz
   // initizalize the readers
   readers = 0;
   num_readers = num_items;
+  this->items = items;
+  this->laszip = laszip;
 
   // disable chunking
   chunk_size = U32_MAX;
@@ -299,6 +452,60 @@ BOOL LASreadPoint::setup(U32 num_items, const LASitem* items, const LASzip* lasz
   return TRUE;
 }
 
+BOOL LASreadPoint::set_threads(const U32 num_threads, const I64 num_points)
+{
+  if (instream) return FALSE;
+  this->num_threads = num_threads;
+  this->num_points = num_points;
+  return TRUE;
+}
+
+BOOL LASreadPoint::set_layer_threads(const U32 num_threads)
+{
+  if (instream || !layered_las14_compression || (readers_compressed == 0)) return FALSE;
+  U32 i;
+  BOOL layered = FALSE;
+  for (i = 0; i < num_readers; i++)
+  {
+    if (((LASreadItemCompressed*)(readers_compressed[i]))->set_layer_threads(num_threads)) layered = TRUE;
+  }
+  if (layered) num_layer_threads = num_threads;
+  return layered;
+}
+
+BOOL LASreadPoint::set_intervals(const U32 num_intervals, const U32* starts, const U32* ends)
+{
+  U32 i;
+  if (intervals) delete [] intervals;
+  this->num_intervals = 0;
+  intervals = 0;
+  if (num_intervals)
+  {
+    intervals = new U32[2*num_intervals];
+    for (i = 0; i < num_intervals; i++)
+    {
+      intervals[2*i] = starts[i];
+      intervals[2*i+1] = ends[i];
+    }
+    this->num_intervals = num_intervals;
+  }
+  if (threads)
+  {
+    // the new schedule takes effect with the next seek
+    std::lock_guard<std::mutex> lock(threads->mutex);
+    threads->reschedule = TRUE;
+  }
+  return TRUE;
+}
+
+BOOL LASreadPoint::set_cache_key(const CHAR* cache_key)
+{
+  if (instream) return FALSE;
+  if (this->cache_key) free(this->cache_key);
+  this->cache_key = (cache_key ? LASCopyString(cache_key) : 0);
+  return TRUE;
+}
+
 BOOL LASreadPoint::init(ByteStreamIn* instream)
 {
   if (!instream) return FALSE;
@@ -335,6 +542,11 @@ BOOL LASreadPoint::seek(const U32 current, const U32 target)
     {
       init_dec();
       chunk_count = 0;
+      if ((num_threads > 1) || cache_key) start_threads();
+    }
+    if (threads)
+    {
+      return seek_threaded(target);
     }
     if (chunk_starts)
     {
@@ -410,6 +622,20 @@ BOOL LASreadPoint::read(U8* const * point)
   U32 i;
   U32 context = 0;
 
+  if (((num_threads > 1) || cache_key) && dec)
+  {
+    if (point_start == 0)
+    {
+      init_dec();
+      chunk_count = 0;
+      start_threads();
+    }
+    if (threads)
+    {
+      return read_threaded(point);
+    }
+  }
+
   try
   {
     if (dec)
@@ -460,37 +686,7 @@ BOOL LASreadPoint::read(U8* const * point)
       }
       else
       {
-        for (i = 0; i < num_readers; i++)
-        {
-          readers_raw[i]->read(point[i], context);
-        }
-        if (layered_las14_compression)
-        {
-          // for layered compression 'dec' only hands over the stream
-          dec->init(instream, FALSE);
-          // read how many points are in the chunk
-          U32 count;
-          instream->get32bitsLE((U8*)&count);
-          // read the sizes of all layers
-          for (i = 0; i < num_readers; i++)
-          {
-            ((LASreadItemCompressed*)(readers_compressed[i]))->chunk_sizes();
-          }
-          for (i = 0; i < num_readers; i++)
-          {
-            ((LASreadItemCompressed*)(readers_compressed[i]))->init(point[i], context);
-          }
-          if (DEBUG_OUTPUT_NUM_BYTES_DETAILS) fprintf(stderr, "\n");
-        }
-        else
-        {
-          for (i = 0; i < num_readers; i++)
-          {
-            ((LASreadItemCompressed*)(readers_compressed[i]))->init(point[i], context);
-          }
-          dec->init(instream);
-        }
-        readers = readers_compressed;
+        start_chunk(point, context);
       }
     }
     else
@@ -538,6 +734,11 @@ BOOL LASreadPoint::read(U8* const * point)
 
 BOOL LASreadPoint::check_end()
 {
+  if (threads)
+  {
+    // integrity of each chunk was already checked by the worker that decompressed it
+    return TRUE;
+  }
   if (readers == readers_compressed)
   {
     if (dec)
@@ -564,10 +765,55 @@ BOOL LASreadPoint::check_end()
 
 BOOL LASreadPoint::done()
 {
+  stop_threads();
   instream = 0;
   return TRUE;
 }
 
+void LASreadPoint::start_chunk(U8* const * point, U32& context)
+{
+  U32 i;
+  for (i = 0; i < num_readers; i++)
+  {
+    readers_raw[i]->read(point[i], context);
+  }
+  if (layered_las14_compression)
+  {
+    // for layered compression 'dec' only hands over the stream
+    dec->init(instream, FALSE);
+    // read how many points are in the chunk
+    U32 count;
+    instream->get32bitsLE((U8*)&count);
+    // read the sizes of all layers
+    for (i = 0; i < num_readers; i++)
+    {
+      ((LASreadItemCompressed*)(readers_compressed[i]))->chunk_sizes();
+    }
+    // the layers of large chunks may be decompressed on several threads
+    if (num_layer_threads > 1)
+    {
+      for (i = 0; i < num_readers; i++)
+      {
+        ((LASreadItemCompressed*)(readers_compressed[i]))->set_chunk_count(count <= chunk_size ? count : 0);
+      }
+    }
+    for (i = 0; i < num_readers; i++)
+    {
+      ((LASreadItemCompressed*)(readers_compressed[i]))->init(point[i], context);
+    }
+    if (DEBUG_OUTPUT_NUM_BYTES_DETAILS) fprintf(stderr, "\n");
+  }
+  else
+  {
+    for (i = 0; i < num_readers; i++)
+    {
+      ((LASreadItemCompressed*)(readers_compressed[i]))->init(point[i], context);
+    }
+    dec->init(instream);
+  }
+  readers = readers_compressed;
+}
+
 BOOL LASreadPoint::init_dec()
 {
   // maybe read chunk table (only if chunking enabled)
@@ -795,10 +1041,525 @@ U32 LASreadPoint::search_chunk_table(const U32 index, const U32 lower, const U32
     return search_chunk_table(index, lower, mid);
 }
 
+BOOL LASreadPoint::start_threads()
+{
+  U32 i;
+
+  // chunks can only be decompressed independently with a complete and intact chunk table
+  if ((number_chunks == 0) || (number_chunks == U32_MAX) || (tabled_chunks != (number_chunks+1)) || last_warning || !instream->isSeekable())
+  {
+    num_threads = 0;
+    return FALSE;
+  }
+
+  // without variable chunk sizes we need the number of points to know how many are in the last chunk
+  if ((chunk_totals == 0) && (num_points <= 0))
+  {
+    num_threads = 0;
+    return FALSE;
+  }
+
+  // the combo point struct of the LAS 1.4 readers only fits into padded layered records
+  for (i = 0; i < num_readers; i++)
+  {
+    if ((items[i].type == LASitem::POINT14) && !layered_las14_compression)
+    {
+      num_threads = 0;
+      return FALSE;
+    }
+  }
+
+  // the cache also works with the chunk buffers and needs at least one worker
+  if (num_threads == 0) num_threads = 1;
+
+  threads = new LASreadPointThreads();
+  threads->stop = FALSE;
+  threads->num_chunks = 2*num_threads;
+  threads->chunks = new LASreadPointChunk[threads->num_chunks];
+  for (i = 0; i < threads->num_chunks; i++)
+  {
+    threads->chunks[i].index = U32_MAX;
+    threads->chunks[i].number = U32_MAX;
+    threads->chunks[i].generation = 0;
+    threads->chunks[i].state = LASZIP_CHUNK_EMPTY;
+    threads->chunks[i].count = 0;
+    threads->chunks[i].allocated = 0;
+    threads->chunks[i].records = 0;
+  }
+  threads->first = current_chunk;
+  threads->current = 0;
+  threads->current_point = 0;
+  // scheduled chunks are only used after the first seek
+  threads->reschedule = (num_intervals != 0);
+  threads->generation = 0;
+
+  // decompressed points are stored with the same layout as the seek point
+  threads->record_size = (layered_las14_compression ? 2*point_size : point_size);
+  threads->item_offsets = new U32[num_readers];
+  threads->item_bytes = new U32[num_readers];
+  for (i = 0; i < num_readers; i++)
+  {
+    threads->item_offsets[i] = (U32)(seek_point[i] - seek_point[0]);
+    threads->item_bytes[i] = (items[i].type == LASitem::POINT14 ? LASZIP_POINT14_COMBO_STRUCT_SIZE : items[i].size);
+  }
+
+  // each worker has its own entropy decoder and its own set of readers
+  for (i = 0; i < num_threads; i++)
+  {
+    LASreadPoint* decoder = new LASreadPoint(decompress_selective);
+    if (!decoder->setup(num_readers, items, laszip))
+    {
+      delete decoder;
+      break;
+    }
+    threads->decoders.push_back(decoder);
+    threads->workers.push_back(std::thread(&LASreadPoint::decompress_chunks, this, decoder));
+  }
+
+  if (threads->workers.size() == 0)
+  {
+    stop_threads();
+    num_threads = 0;
+    return FALSE;
+  }
+  return TRUE;
+}
+
+void LASreadPoint::stop_threads()
+{
+  if (threads == 0) return;
+
+  U32 i;
+  {
+    std::lock_guard<std::mutex> lock(threads->mutex);
+    threads->stop = TRUE;
+  }
+  threads->chunk_free.notify_all();
+  for (i = 0; i < threads->workers.size(); i++)
+  {
+    threads->workers[i].join();
+  }
+  for (i = 0; i < threads->decoders.size(); i++)
+  {
+    delete threads->decoders[i];
+  }
+  for (i = 0; i < threads->num_chunks; i++)
+  {
+    if (threads->chunks[i].records) free(threads->chunks[i].records);
+  }
+  delete [] threads->chunks;
+  delete [] threads->item_offsets;
+  delete [] threads->item_bytes;
+  delete threads;
+  threads = 0;
+}
+
+BOOL LASreadPoint::read_threaded(U8* const * point)
+{
+  U32 i;
+  LASreadPointChunk* chunk = threads->current;
+
+  while ((chunk == 0) || (threads->current_point >= chunk->count))
+  {
+    std::unique_lock<std::mutex> lock(threads->mutex);
+    if (chunk)
+    {
+      U32 state = chunk->state;
+      U32 number = chunk->number;
+      // hand back the exhausted chunk and move on to the next one
+      chunk->state = LASZIP_CHUNK_EMPTY;
+      chunk->index = U32_MAX;
+      threads->first++;
+      threads->current = 0;
+      threads->current_point = 0;
+      threads->chunk_free.notify_all();
+      // maybe the chunk was cut short by an error
+      if (state != LASZIP_CHUNK_READY)
+      {
+        // create error string
+        if (last_error == 0) last_error = new CHAR[128];
+        // report error
+        if (state == LASZIP_CHUNK_EOF)
+        {
+          snprintf(last_error, 128, "end-of-file during chunk with index %u", number);
+        }
+        else
+        {
+          snprintf(last_error, 128, "chunk with index %u of %u is corrupt", number, tabled_chunks);
+        }
+        return FALSE;
+      }
+      // reading on into a chunk that was not scheduled
+      if (threads->scheduled.size() && ((threads->first >= threads->scheduled.size()) || (threads->scheduled[threads->first] != (number+1))))
+      {
+        unschedule_chunks();
+        threads->first = number+1;
+      }
+    }
+    if (threads->first >= (threads->scheduled.size() ? (U32)threads->scheduled.size() : number_chunks))
+    {
+      // create error string
+      if (last_error == 0) last_error = new CHAR[128];
+      // report error
+      snprintf(last_error, 128, "end-of-file after last chunk with index %u", number_chunks-1);
+      return FALSE;
+    }
+    // wait until a worker has decompressed the next chunk
+    chunk = &(threads->chunks[threads->first % threads->num_chunks]);
+    while ((chunk->index != threads->first) || (chunk->state == LASZIP_CHUNK_EMPTY) || (chunk->state == LASZIP_CHUNK_BUSY))
+    {
+      threads->chunk_done.wait(lock);
+    }
+    threads->current = chunk;
+  }
+
+  U8* record = chunk->records + (size_t)threads->current_point*threads->record_size;
+  for (i = 0; i < num_readers; i++)
+  {
+    memcpy(point[i], record + threads->item_offsets[i], threads->item_bytes[i]);
+  }
+  threads->current_point++;
+  return TRUE;
+}
+
+BOOL LASreadPoint::seek_threaded(const U32 target)
+{
+  U32 i;
+  U32 target_chunk;
+  U32 delta;
+
+  if (chunk_totals)
+  {
+    target_chunk = search_chunk_table(target, 0, number_chunks);
+    delta = target - chunk_totals[target_chunk];
+  }
+  else
+  {
+    target_chunk = target/chunk_size;
+    delta = target%chunk_size;
+  }
+  if (target_chunk >= number_chunks)
+  {
+    return FALSE;
+  }
+
+  std::lock_guard<std::mutex> lock(threads->mutex);
+  if (threads->reschedule)
+  {
+    threads->reschedule = FALSE;
+    schedule_chunks();
+  }
+  U32 position = locate_chunk(target_chunk);
+  if (position != threads->first)
+  {
+    threads->first = position;
+    // drop decompressed chunks that are no longer inside the window
+    for (i = 0; i < threads->num_chunks; i++)
+    {
+      LASreadPointChunk* chunk = &(threads->chunks[i]);
+      if ((chunk->state != LASZIP_CHUNK_EMPTY) && (chunk->state != LASZIP_CHUNK_BUSY))
+      {
+        if ((chunk->index < threads->first) || (chunk->index >= (threads->first + threads->num_chunks)))
+        {
+          chunk->state = LASZIP_CHUNK_EMPTY;
+          chunk->index = U32_MAX;
+        }
+      }
+    }
+    threads->chunk_free.notify_all();
+  }
+  threads->current = 0;
+  threads->current_point = delta;
+  return TRUE;
+}
+
+void LASreadPoint::schedule_chunks()
+{
+  U32 i, chunk, first_chunk, last_chunk;
+  unschedule_chunks();
+  for (i = 0; i < num_intervals; i++)
+  {
+    if (chunk_totals)
+    {
+      first_chunk = search_chunk_table(intervals[2*i], 0, number_chunks);
+      last_chunk = search_chunk_table(intervals[2*i+1], 0, number_chunks);
+    }
+    else
+    {
+      first_chunk = intervals[2*i]/chunk_size;
+      last_chunk = intervals[2*i+1]/chunk_size;
+    }
+    if (last_chunk >= number_chunks) last_chunk = number_chunks-1;
+    for (chunk = first_chunk; chunk <= last_chunk; chunk++)
+    {
+      if (threads->scheduled.size() && (threads->scheduled.back() == chunk)) continue;
+      threads->scheduled.push_back(chunk);
+    }
+  }
+}
+
+void LASreadPoint::unschedule_chunks()
+{
+  U32 i;
+  threads->scheduled.clear();
+  // positions now mean something else so everything decompressed so far goes
+  threads->generation++;
+  for (i = 0; i < threads->num_chunks; i++)
+  {
+    LASreadPointChunk* chunk = &(threads->chunks[i]);
+    if (chunk->state != LASZIP_CHUNK_BUSY)
+    {
+      chunk->state = LASZIP_CHUNK_EMPTY;
+      chunk->index = U32_MAX;
+    }
+  }
+  threads->current = 0;
+  threads->current_point = 0;
+  threads->chunk_free.notify_all();
+}
+
+U32 LASreadPoint::locate_chunk(const U32 chunk)
+{
+  U32 position;
+  U32 size = (U32)threads->scheduled.size();
+  if (size == 0) return chunk;
+  // usually the chunk is at or a little after the current position
+  for (position = threads->first; position < size; position++)
+  {
+    if (threads->scheduled[position] == chunk) return position;
+  }
+  for (position = 0; (position < threads->first) && (position < size); position++)
+  {
+    if (threads->scheduled[position] == chunk) return position;
+  }
+  // not a scheduled chunk so we go back to decompressing all chunks in order
+  unschedule_chunks();
+  return chunk;
+}
+
+void LASreadPoint::decompress_chunks(LASreadPoint* worker)
+{
+  ByteStreamInArray* stream;
+  if (IS_LITTLE_ENDIAN())
+    stream = new ByteStreamInArrayLE();
+  else
+    stream = new ByteStreamInArrayBE();
+  U8* bytes = 0;
+  I64 bytes_allocated = 0;
+  // the chunks of a stream held in memory (e.g. a mapped file) need no copies
+  I64 data_size = 0;
+  const U8* data = instream->getData(&data_size);
+
+  std::unique_lock<std::mutex> lock(threads->mutex);
+  while (!threads->stop)
+  {
+    // find the first chunk inside the window that nobody has claimed yet
+    U32 index;
+    U32 end = threads->first + threads->num_chunks;
+    U32 last = (threads->scheduled.size() ? (U32)threads->scheduled.size() : number_chunks);
+    if (end > last) end = last;
+    LASreadPointChunk* chunk = 0;
+    for (index = threads->first; index < end; index++)
+    {
+      LASreadPointChunk* candidate = &(threads->chunks[index % threads->num_chunks]);
+      if (candidate->index == index) continue;
+      if (candidate->state == LASZIP_CHUNK_EMPTY)
+      {
+        chunk = candidate;
+        break;
+      }
+    }
+    if (chunk == 0)
+    {
+      threads->chunk_free.wait(lock);
+      continue;
+    }
+    chunk->index = index;
+    chunk->number = (threads->scheduled.size() ? threads->scheduled[index] : index);
+    chunk->generation = threads->generation;
+    chunk->state = LASZIP_CHUNK_BUSY;
+    chunk->count = 0;
+    U32 number = chunk->number;
+    U32 generation = chunk->generation;
+    lock.unlock();
+
+    // how many points are in this chunk
+    U32 count;
+    if (chunk_totals)
+    {
+      count = chunk_totals[number+1] - chunk_totals[number];
+    }
+    else if ((number+1) < number_chunks)
+    {
+      count = chunk_size;
+    }
+    else if (num_points > (I64)chunk_size*number)
+    {
+      count = ((num_points - (I64)chunk_size*number) < chunk_size ? (U32)(num_points - (I64)chunk_size*number) : chunk_size);
+    }
+    else
+    {
+      count = 0;
+    }
+
+    U32 state = LASZIP_CHUNK_READY;
+    if (chunk->allocated < count)
+    {
+      if (chunk->records) free(chunk->records);
+      chunk->records = (U8*)malloc((size_t)count*threads->record_size);
+      chunk->allocated = (chunk->records ? count : 0);
+      if (chunk->records == 0) state = LASZIP_CHUNK_CORRUPT;
+    }
+
+    // maybe another seek or another reader has decompressed this chunk before
+    std::string key;
+    BOOL cached = FALSE;
+    if (cache_key && (state == LASZIP_CHUNK_READY))
+    {
+      CHAR suffix[64];
+      snprintf(suffix, 64, "|%u|%u|%u|%lld", decompress_selective, threads->record_size, number, chunk_starts[number]);
+      key = std::string(cache_key) + suffix;
+      if (chunk_cache().get(key, count, threads->record_size, chunk->records))
+      {
+        chunk->count = count;
+        cached = TRUE;
+      }
+    }
+
+    // fetch the compressed bytes of this chunk
+    I64 num_bytes = chunk_starts[number+1] - chunk_starts[number];
+    if (cached)
+    {
+      // nothing to fetch
+    }
+    else if (data)
+    {
+      if ((chunk_starts[number] + num_bytes) > data_size) state = LASZIP_CHUNK_EOF;
+    }
+    else if (bytes_allocated < num_bytes)
+    {
+      if (bytes) free(bytes);
+      bytes = (U8*)malloc((size_t)num_bytes);
+      bytes_allocated = (bytes ? num_bytes : 0);
+      if (bytes == 0) state = LASZIP_CHUNK_CORRUPT;
+    }
+    if ((state == LASZIP_CHUNK_READY) && !cached && (data == 0))
+    {
+      std::lock_guard<std::mutex> io_lock(threads->io);
+      try
+      {
+        instream->seek(chunk_starts[number]);
+        instream->getBytes(bytes, (U32)num_bytes);
+      }
+      catch (...)
+      {
+        state = LASZIP_CHUNK_EOF;
+      }
+    }
+
+    // decompress the chunk with our own decoder
+    if ((state == LASZIP_CHUNK_READY) && !cached)
+    {
+      stream->init((data ? data + chunk_starts[number] : bytes), num_bytes);
+      state = worker->decompress_chunk(stream, count, chunk->records, threads->record_size, &(chunk->count));
+      if (cache_key && (state == LASZIP_CHUNK_READY))
+      {
+        chunk_cache().put(key, count, threads->record_size, chunk->records);
+      }
+    }
+
+    lock.lock();
+    if ((generation != threads->generation) || (index < threads->first) || (index >= (threads->first + threads->num_chunks)))
+    {
+      // a seek has moved the window elsewhere
+      chunk->state = LASZIP_CHUNK_EMPTY;
+      chunk->index = U32_MAX;
+      threads->chunk_free.notify_all();
+    }
+    else
+    {
+      chunk->state = state;
+      threads->chunk_done.notify_all();
+    }
+  }
+  lock.unlock();
+
+  delete stream;
+  if (bytes) free(bytes);
+}
+
+I32 LASreadPoint::decompress_chunk(ByteStreamIn* stream, const U32 count, U8* records, const U32 record_size, U32* decompressed)
+{
+  U32 i, j;
+  U32 context = 0;
+  I32 state = LASZIP_CHUNK_READY;
+  U8** point = new U8*[num_readers];
+
+  instream = stream;
+  for (i = 0; i < num_readers; i++)
+  {
+    ((LASreadItemRaw*)(readers_raw[i]))->init(stream);
+  }
+
+  try
+  {
+    for (j = 0; j < count; j++)
+    {
+      U8* record = records + (size_t)j*record_size;
+      for (i = 0; i < num_readers; i++)
+      {
+        point[i] = record + (seek_point[i] - seek_point[0]);
+      }
+      if (j == 0)
+      {
+        memset(record, 0, record_size);
+        // because extended_point_type must be set
+        if (layered_las14_compression) record[22] = 1;
+        start_chunk(point, context);
+      }
+      else
+      {
+        for (i = 0; i < num_readers; i++)
+        {
+          readers[i]->read(point[i], context);
+        }
+      }
+      (*decompressed)++;
+    }
+    if (count)
+    {
+      dec->done();
+      // check integrity
+      I64 here = stream->tell();
+      stream->seekEnd();
+      if (stream->tell() != here)
+      {
+        state = LASZIP_CHUNK_CORRUPT;
+      }
+    }
+  }
+  catch (I32 exception)
+  {
+    state = (exception == EOF ? LASZIP_CHUNK_EOF : LASZIP_CHUNK_CORRUPT);
+  }
+  catch (...)
+  {
+    state = LASZIP_CHUNK_CORRUPT;
+  }
+
+  delete [] point;
+  instream = 0;
+  return state;
+}
+
 LASreadPoint::~LASreadPoint()
 {
   U32 i;
 
+  stop_threads();
+  if (intervals) delete [] intervals;
+  if (cache_key) free(cache_key);
+
   if (readers_raw)
   {
     for (i = 0; i < num_readers; i++)
@@ -24,6 +24,10 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- optional multi-threaded decompression of the layers of LAS 1.4 chunks
+    18 October 2026 -- optional process-wide cache of decompressed chunks
+    18 October 2026 -- decompress only chunks overlapped by spatial index intervals ahead
+    18 October 2026 -- optional multi-threaded decompression of independent chunks
     23 September 2020 -- rare fix for bit-corrupted LAZ files where chunk table is zeroed
     28 August 2017 -- moving 'context' from global development hack to interface  
     18 July 2017 -- bug fix for spatial-indexed reading of native compressed LAS 1.4 
@@ -52,6 +56,7 @@
 
 class LASreadItem;
 class ArithmeticDecoder;
+class LASreadPointThreads;
 
 class LASreadPoint
 {
@@ -62,6 +67,25 @@ public:
   // should only be called *once*
   BOOL setup(const U32 num_items, const LASitem* items, const LASzip* laszip=0);
 
+  // optional: decompress chunks ahead on several threads (call before init)
+  BOOL set_threads(const U32 num_threads, const I64 num_points);
+
+  // optional: decompress the layers of LAS 1.4 chunks on several threads
+  // so that even files with few but large chunks are decoded in parallel
+  // (call after setup and before init)
+  BOOL set_layer_threads(const U32 num_threads);
+
+  // optional: the increasing point intervals (with inclusive ends) that will
+  // be read next so that the threads only decompress the chunks they overlap
+  BOOL set_intervals(const U32 num_intervals, const U32* starts, const U32* ends);
+
+  // optional: share decompressed chunks with other readers of the same file
+  // (e.g. the file name) through the process-wide cache (call before init)
+  BOOL set_cache_key(const CHAR* cache_key);
+
+  // the byte budget of the process-wide cache of decompressed chunks
+  static void set_cache_size(const I64 cache_size);
+
   BOOL init(ByteStreamIn* instream);
   BOOL seek(const U32 current, const U32 target);
   BOOL read(U8* const * point);
@@ -90,6 +114,26 @@ private:
   BOOL init_dec();
   BOOL read_chunk_table();
   U32 search_chunk_table(const U32 index, const U32 lower, const U32 upper);
+  void start_chunk(U8* const * point, U32& context);
+  // used for multi-threaded decompression
+  const LASitem* items;
+  const LASzip* laszip;
+  U32 num_threads;
+  I64 num_points;
+  U32 num_layer_threads;
+  LASreadPointThreads* threads;
+  BOOL start_threads();
+  void stop_threads();
+  BOOL read_threaded(U8* const * point);
+  BOOL seek_threaded(const U32 target);
+  void decompress_chunks(LASreadPoint* worker);
+  U32 num_intervals;
+  U32* intervals;
+  void schedule_chunks();
+  void unschedule_chunks();
+  U32 locate_chunk(const U32 chunk);
+  CHAR* cache_key;
+  I32 decompress_chunk(ByteStreamIn* stream, const U32 count, U8* records, const U32 record_size, U32* decompressed);
   // used for selective decompression (new LAS 1.4 point types only)
   U32 decompress_selective;
   // used for seeking
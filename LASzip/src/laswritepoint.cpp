@@ -32,6 +32,7 @@
 #include "laswritepoint.hpp"
 
 #include "arithmeticencoder.hpp"
+#include "bytestreamout_array.hpp"
 #include "laswriteitemraw.hpp"
 #include "laswriteitemcompressed_v1.hpp"
 #include "laswriteitemcompressed_v2.hpp"
@@ -42,6 +43,56 @@
 #include <stdlib.h>
 #include <stdio.h>
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// the LAS 1.4 point writers take the combo point struct from X up to and including rgb[4]
+#define LASZIP_POINT14_COMBO_STRUCT_SIZE 48
+
+// states of a chunk buffer used for multi-threaded compression
+#define LASZIP_CHUNK_EMPTY      0
+#define LASZIP_CHUNK_FILLED     1
+#define LASZIP_CHUNK_BUSY       2
+#define LASZIP_CHUNK_COMPRESSED 3
+#define LASZIP_CHUNK_FAILED     4
+
+class LASwritePointChunk
+{
+public:
+  U32 index;
+  U32 state;
+  U32 count;
+  U32 allocated;
+  U8* records;
+  ByteStreamOutArray* stream;
+};
+
+class LASwritePointThreads
+{
+public:
+  std::vector<std::thread> workers;
+  std::vector<LASwritePoint*> encoders;
+  // guards the states of the chunk buffers
+  std::mutex mutex;
+  std::condition_variable chunk_filled;
+  std::condition_variable chunk_done;
+  BOOL stop;
+  U32 num_chunks;
+  LASwritePointChunk* chunks;
+  // chunks are compressed in any order but written in the order they
+  // were filled. 'first' is the oldest chunk that is not yet written and
+  // 'next' is the chunk that is currently being filled with points.
+  U32 first;
+  U32 next;
+  LASwritePointChunk* current;
+  // layout of one uncompressed point inside the chunk buffers
+  U32 record_size;
+  U32* item_offsets;
+  U32* item_bytes;
+};
+
 LASwritePoint::LASwritePoint()
 {
   outstream = 0;
@@ -60,6 +111,11 @@ LASwritePoint::LASwritePoint()
   chunk_bytes = 0;
   chunk_table_start_position = 0;
   chunk_start_position = 0;
+  // used for multi-threaded compression
+  items = 0;
+  laszip = 0;
+  num_threads = 0;
+  threads = 0;
 }
 
 BOOL LASwritePoint::setup(const U32 num_items, const LASitem* items, const LASzip* laszip)
@@ -75,6 +131,10 @@ BOOL LASwritePoint::setup(const U32 num_items, const LASitem* items, const LASzi
     if (items != laszip->items) return FALSE;
   }
 
+  // remember the items in case we need to create more writers
+  this->items = items;
+  this->laszip = laszip;
+
   // create entropy encoder (if requested)
   enc = 0;
   if (laszip && laszip->compressor)
@@ -254,6 +314,13 @@ BOOL LASwritePoint::setup(const U32 num_items, const LASitem* items, const LASzi
   return TRUE;
 }
 
+BOOL LASwritePoint::set_threads(const U32 num_threads)
+{
+  if (outstream) return FALSE;
+  this->num_threads = num_threads;
+  return TRUE;
+}
+
 BOOL LASwritePoint::init(ByteStreamOut* outstream)
 {
   if (!outstream) return FALSE;
@@ -290,6 +357,12 @@ BOOL LASwritePoint::init(ByteStreamOut* outstream)
     writers = writers_raw;
   }
 
+  // maybe compress the chunks on multiple threads
+  if ((num_threads > 1) && (threads == 0) && chunk_start_position)
+  {
+    start_threads();
+  }
+
   return TRUE;
 }
 
@@ -298,29 +371,17 @@ BOOL LASwritePoint::write(const U8 * const * point)
   U32 i;
   U32 context = 0;
 
+  if (threads)
+  {
+    return write_threaded(point);
+  }
+
   if (chunk_count == chunk_size)
   {
     if (enc)
     {
-      if (layered_las14_compression)
-      {
-        // write how many points are in the chunk
-        outstream->put32bitsLE((U8*)&chunk_count);
-        // write all layers 
-        for (i = 0; i < num_writers; i++)
-        {
-          ((LASwriteItemCompressed*)writers[i])->chunk_sizes();
-        }
-        for (i = 0; i < num_writers; i++)
-        {
-          ((LASwriteItemCompressed*)writers[i])->chunk_bytes();
-        }
-      }
-      else
-      {
-        enc->done();
-      }
-      add_chunk_to_table();
+      finish_chunk();
+      add_chunk_to_table(chunk_count);
       init(outstream);
     }
     else
@@ -364,26 +425,14 @@ BOOL LASwritePoint::chunk()
   {
     return FALSE;
   }
-  if (layered_las14_compression)
+  if (threads)
   {
-    U32 i;
-    // write how many points are in the chunk
-    outstream->put32bitsLE((U8*)&chunk_count);
-    // write all layers 
-    for (i = 0; i < num_writers; i++)
-    {
-      ((LASwriteItemCompressed*)writers[i])->chunk_sizes();
-    }
-    for (i = 0; i < num_writers; i++)
-    {
-      ((LASwriteItemCompressed*)writers[i])->chunk_bytes();
-    }
+    // hand the points collected so far to the workers
+    if (chunk_count == 0) return TRUE;
+    return submit_chunk();
   }
-  else
-  {
-    enc->done();
-  }
-  add_chunk_to_table();
+  finish_chunk();
+  add_chunk_to_table(chunk_count);
   init(outstream);
   chunk_count = 0;
   return TRUE;
@@ -391,30 +440,22 @@ BOOL LASwritePoint::chunk()
 
 BOOL LASwritePoint::done()
 {
+  if (threads)
+  {
+    // compress the last chunk and write all outstanding chunks in order
+    BOOL success = TRUE;
+    if (chunk_count) success = submit_chunk();
+    if (success) success = write_chunks(threads->next);
+    stop_threads();
+    if (!success) return FALSE;
+    return write_chunk_table();
+  }
   if (writers == writers_compressed)
   {
-    if (layered_las14_compression)
-    {
-      U32 i;
-      // write how many points are in the chunk
-      outstream->put32bitsLE((U8*)&chunk_count);
-      // write all layers 
-      for (i = 0; i < num_writers; i++)
-      {
-        ((LASwriteItemCompressed*)writers[i])->chunk_sizes();
-      }
-      for (i = 0; i < num_writers; i++)
-      {
-        ((LASwriteItemCompressed*)writers[i])->chunk_bytes();
-      }
-    }
-    else
-    {
-      enc->done();
-    }
+    finish_chunk();
     if (chunk_start_position)
     {
-      if (chunk_count) add_chunk_to_table();
+      if (chunk_count) add_chunk_to_table(chunk_count);
       return write_chunk_table();
     }
   }
@@ -429,7 +470,45 @@ BOOL LASwritePoint::done()
   return TRUE;
 }
 
-BOOL LASwritePoint::add_chunk_to_table()
+BOOL LASwritePoint::get_chunk_table(U32* number_chunks, const U32** chunk_bytes)
+{
+  if (chunk_start_position == 0)
+  {
+    return FALSE;
+  }
+  if (threads)
+  {
+    if (!write_chunks(threads->next)) return FALSE;
+  }
+  *number_chunks = (this->number_chunks == U32_MAX ? 0 : this->number_chunks);
+  *chunk_bytes = this->chunk_bytes;
+  return TRUE;
+}
+
+void LASwritePoint::finish_chunk()
+{
+  if (layered_las14_compression)
+  {
+    U32 i;
+    // write how many points are in the chunk
+    outstream->put32bitsLE((U8*)&chunk_count);
+    // write all layers 
+    for (i = 0; i < num_writers; i++)
+    {
+      ((LASwriteItemCompressed*)writers[i])->chunk_sizes();
+    }
+    for (i = 0; i < num_writers; i++)
+    {
+      ((LASwriteItemCompressed*)writers[i])->chunk_bytes();
+    }
+  }
+  else
+  {
+    enc->done();
+  }
+}
+
+BOOL LASwritePoint::add_chunk_to_table(const U32 count)
 {
   if (number_chunks == alloced_chunks)
   {
@@ -449,7 +528,7 @@ BOOL LASwritePoint::add_chunk_to_table()
     if (chunk_bytes == 0) return FALSE;
   }
   I64 position = outstream->tell();
-  if (chunk_size == U32_MAX) chunk_sizes[number_chunks] = chunk_count;
+  if (chunk_size == U32_MAX) chunk_sizes[number_chunks] = count;
   chunk_bytes[number_chunks] = (U32)(position - chunk_start_position);
   chunk_start_position = position;
   number_chunks++;
@@ -506,10 +585,284 @@ BOOL LASwritePoint::write_chunk_table()
   return TRUE;
 }
 
+BOOL LASwritePoint::start_threads()
+{
+  U32 i;
+
+  threads = new LASwritePointThreads();
+  threads->stop = FALSE;
+  threads->num_chunks = 2*num_threads;
+  threads->chunks = new LASwritePointChunk[threads->num_chunks];
+  for (i = 0; i < threads->num_chunks; i++)
+  {
+    threads->chunks[i].index = U32_MAX;
+    threads->chunks[i].state = LASZIP_CHUNK_EMPTY;
+    threads->chunks[i].count = 0;
+    threads->chunks[i].allocated = 0;
+    threads->chunks[i].records = 0;
+    if (IS_LITTLE_ENDIAN())
+      threads->chunks[i].stream = new ByteStreamOutArrayLE();
+    else
+      threads->chunks[i].stream = new ByteStreamOutArrayBE();
+  }
+  threads->first = 0;
+  threads->next = 0;
+  threads->current = 0;
+
+  // uncompressed points are stored back to back in the chunk buffers
+  threads->record_size = 0;
+  threads->item_offsets = new U32[num_writers];
+  threads->item_bytes = new U32[num_writers];
+  for (i = 0; i < num_writers; i++)
+  {
+    threads->item_offsets[i] = threads->record_size;
+    threads->item_bytes[i] = (items[i].type == LASitem::POINT14 ? LASZIP_POINT14_COMBO_STRUCT_SIZE : items[i].size);
+    threads->record_size += threads->item_bytes[i];
+  }
+
+  // each worker has its own entropy encoder and its own set of writers
+  for (i = 0; i < num_threads; i++)
+  {
+    LASwritePoint* encoder = new LASwritePoint();
+    if (!encoder->setup(num_writers, items, laszip))
+    {
+      delete encoder;
+      break;
+    }
+    threads->encoders.push_back(encoder);
+    threads->workers.push_back(std::thread(&LASwritePoint::compress_chunks, this, encoder));
+  }
+
+  if (threads->workers.size() == 0)
+  {
+    stop_threads();
+    num_threads = 0;
+    return FALSE;
+  }
+  return TRUE;
+}
+
+void LASwritePoint::stop_threads()
+{
+  if (threads == 0) return;
+
+  U32 i;
+  {
+    std::lock_guard<std::mutex> lock(threads->mutex);
+    threads->stop = TRUE;
+  }
+  threads->chunk_filled.notify_all();
+  for (i = 0; i < threads->workers.size(); i++)
+  {
+    threads->workers[i].join();
+  }
+  for (i = 0; i < threads->encoders.size(); i++)
+  {
+    delete threads->encoders[i];
+  }
+  for (i = 0; i < threads->num_chunks; i++)
+  {
+    if (threads->chunks[i].records) free(threads->chunks[i].records);
+    delete threads->chunks[i].stream;
+  }
+  delete [] threads->chunks;
+  delete [] threads->item_offsets;
+  delete [] threads->item_bytes;
+  delete threads;
+  threads = 0;
+}
+
+BOOL LASwritePoint::write_threaded(const U8 * const * point)
+{
+  U32 i;
+
+  if (chunk_count == chunk_size)
+  {
+    if (!submit_chunk()) return FALSE;
+  }
+
+  LASwritePointChunk* chunk = threads->current;
+  if (chunk == 0)
+  {
+    // all buffers are in use. wait for the oldest chunk and write it.
+    if (threads->next >= (threads->first + threads->num_chunks))
+    {
+      if (!write_chunks(threads->next - threads->num_chunks + 1)) return FALSE;
+    }
+    chunk = &(threads->chunks[threads->next % threads->num_chunks]);
+    chunk->index = threads->next;
+    chunk->count = 0;
+    threads->current = chunk;
+  }
+
+  if (chunk->count == chunk->allocated)
+  {
+    U32 allocated = (chunk->allocated ? 2*chunk->allocated : 4096);
+    if (allocated > chunk_size) allocated = chunk_size;
+    U8* records = (U8*)realloc(chunk->records, (size_t)allocated*threads->record_size);
+    if (records == 0) return FALSE;
+    chunk->records = records;
+    chunk->allocated = allocated;
+  }
+
+  U8* record = chunk->records + (size_t)chunk->count*threads->record_size;
+  for (i = 0; i < num_writers; i++)
+  {
+    memcpy(record + threads->item_offsets[i], point[i], threads->item_bytes[i]);
+  }
+  chunk->count++;
+  chunk_count++;
+  return TRUE;
+}
+
+BOOL LASwritePoint::submit_chunk()
+{
+  LASwritePointChunk* chunk = threads->current;
+  if (chunk == 0) return FALSE;
+  {
+    std::lock_guard<std::mutex> lock(threads->mutex);
+    chunk->state = LASZIP_CHUNK_FILLED;
+    threads->next++;
+    threads->current = 0;
+  }
+  threads->chunk_filled.notify_one();
+  chunk_count = 0;
+  return TRUE;
+}
+
+BOOL LASwritePoint::write_chunks(const U32 until)
+{
+  while (threads->first < until)
+  {
+    LASwritePointChunk* chunk = &(threads->chunks[threads->first % threads->num_chunks]);
+    {
+      std::unique_lock<std::mutex> lock(threads->mutex);
+      while ((chunk->state == LASZIP_CHUNK_FILLED) || (chunk->state == LASZIP_CHUNK_BUSY))
+      {
+        threads->chunk_done.wait(lock);
+      }
+    }
+    if (chunk->state != LASZIP_CHUNK_COMPRESSED)
+    {
+      return FALSE;
+    }
+    if (!outstream->putBytes(chunk->stream->getData(), (U32)chunk->stream->getCurr()))
+    {
+      return FALSE;
+    }
+    if (!add_chunk_to_table(chunk->count))
+    {
+      return FALSE;
+    }
+    {
+      std::lock_guard<std::mutex> lock(threads->mutex);
+      chunk->state = LASZIP_CHUNK_EMPTY;
+      chunk->index = U32_MAX;
+      chunk->count = 0;
+      threads->first++;
+    }
+  }
+  return TRUE;
+}
+
+void LASwritePoint::compress_chunks(LASwritePoint* worker)
+{
+  std::unique_lock<std::mutex> lock(threads->mutex);
+  while (TRUE)
+  {
+    // pick the oldest chunk that is waiting to be compressed
+    U32 i;
+    LASwritePointChunk* chunk = 0;
+    for (i = 0; i < threads->num_chunks; i++)
+    {
+      LASwritePointChunk* candidate = &(threads->chunks[i]);
+      if (candidate->state != LASZIP_CHUNK_FILLED) continue;
+      if ((chunk == 0) || (candidate->index < chunk->index)) chunk = candidate;
+    }
+    if (chunk == 0)
+    {
+      if (threads->stop) break;
+      threads->chunk_filled.wait(lock);
+      continue;
+    }
+    chunk->state = LASZIP_CHUNK_BUSY;
+    lock.unlock();
+
+    // compress the chunk with our own encoder
+    chunk->stream->seek(0);
+    BOOL success = worker->compress_chunk(chunk->stream, chunk->count, chunk->records, threads->record_size, threads->item_offsets);
+
+    lock.lock();
+    chunk->state = (success ? LASZIP_CHUNK_COMPRESSED : LASZIP_CHUNK_FAILED);
+    threads->chunk_done.notify_all();
+  }
+}
+
+BOOL LASwritePoint::compress_chunk(ByteStreamOut* stream, const U32 count, const U8* records, const U32 record_size, const U32* item_offsets)
+{
+  U32 i, j;
+  U32 context = 0;
+  BOOL success = TRUE;
+  const U8** point = new const U8*[num_writers];
+
+  outstream = stream;
+  for (i = 0; i < num_writers; i++)
+  {
+    ((LASwriteItemRaw*)(writers_raw[i]))->init(stream);
+  }
+
+  for (j = 0; (j < count) && success; j++)
+  {
+    const U8* record = records + (size_t)j*record_size;
+    for (i = 0; i < num_writers; i++)
+    {
+      point[i] = record + item_offsets[i];
+    }
+    if (j == 0)
+    {
+      // the first point of a chunk is stored raw
+      for (i = 0; i < num_writers; i++)
+      {
+        if (!writers_raw[i]->write(point[i], context))
+        {
+          success = FALSE;
+          break;
+        }
+        ((LASwriteItemCompressed*)(writers_compressed[i]))->init(point[i], context);
+      }
+      writers = writers_compressed;
+      enc->init(stream);
+    }
+    else
+    {
+      for (i = 0; i < num_writers; i++)
+      {
+        if (!writers[i]->write(point[i], context))
+        {
+          success = FALSE;
+          break;
+        }
+      }
+    }
+  }
+  if (success && count)
+  {
+    chunk_count = count;
+    finish_chunk();
+  }
+
+  delete [] point;
+  writers = 0;
+  outstream = 0;
+  return success;
+}
+
 LASwritePoint::~LASwritePoint()
 {
   U32 i;
 
+  stop_threads();
+
   if (writers_raw)
   {
     for (i = 0; i < num_writers; i++)
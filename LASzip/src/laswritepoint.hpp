@@ -24,6 +24,8 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- access to the byte sizes of the chunks written so far
+    18 October 2026 -- optional multi-threaded compression of independent chunks
     21 February 2019 -- fix for writing 4294967295+ points uncompressed to LAS
     28 August 2017 -- moving 'context' from global development hack to interface  
     23 August 2016 -- layering of items for selective decompression in LAS 1.4 
@@ -48,6 +50,7 @@
 
 class LASwriteItem;
 class ArithmeticEncoder;
+class LASwritePointThreads;
 
 class LASwritePoint
 {
@@ -58,11 +61,17 @@ public:
   // should only be called *once*
   BOOL setup(const U32 num_items, const LASitem* items, const LASzip* laszip=0);
 
+  // compress chunks on 'num_threads' threads (must be called before init)
+  BOOL set_threads(const U32 num_threads);
+
   BOOL init(ByteStreamOut* outstream);
   BOOL write(const U8 * const * point);
   BOOL chunk();
   BOOL done();
 
+  // the byte sizes of all chunks completed so far (waits until the workers wrote theirs)
+  BOOL get_chunk_table(U32* number_chunks, const U32** chunk_bytes);
+
 private:
   ByteStreamOut* outstream;
   U32 num_writers;
@@ -80,8 +89,21 @@ private:
   U32* chunk_bytes;
   I64 chunk_start_position;
   I64 chunk_table_start_position;
-  BOOL add_chunk_to_table();
+  void finish_chunk();
+  BOOL add_chunk_to_table(const U32 count);
   BOOL write_chunk_table();
+  // used for multi-threaded compression
+  const LASitem* items;
+  const LASzip* laszip;
+  U32 num_threads;
+  LASwritePointThreads* threads;
+  BOOL start_threads();
+  void stop_threads();
+  BOOL write_threaded(const U8 * const * point);
+  BOOL submit_chunk();
+  BOOL write_chunks(const U32 until);
+  void compress_chunks(LASwritePoint* worker);
+  BOOL compress_chunk(ByteStreamOut* stream, const U32 count, const U8* records, const U32 record_size, const U32* item_offsets);
 };
 
 #endif
@@ -24,6 +24,8 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- laszip_set_decompress_threads() decompresses chunks ahead on several threads
+    18 October 2026 -- laszip_read_points() and laszip_write_points() move entire batches of points
     24 March 2021 -- fix small memory leak
     15 October 2019 -- support reading from and writing to unicode file names under Windows
     20 March 2019 -- check consistent legacy and extended classification in laszip_write_point()
@@ -159,7 +161,9 @@ typedef struct laszip_dll
   BOOL lax_create;
   BOOL lax_append;
   BOOL lax_exploit;
+  BOOL lax_inside;
   U32 las14_decompress_selective;
+  U32 decompress_threads;
   BOOL preserve_generating_software;
   BOOL request_native_extension;
   BOOL request_compatibility_mode;
@@ -204,7 +208,9 @@ typedef struct laszip_dll
     lax_create = FALSE;
     lax_append = FALSE;
     lax_exploit = FALSE;
+    lax_inside = FALSE;
     las14_decompress_selective = 0;
+    decompress_threads = 0;
     preserve_generating_software = FALSE;
     request_native_extension = FALSE;
     request_compatibility_mode = FALSE;
@@ -3308,6 +3314,289 @@ laszip_write_point(
   return 0;
 }
 
+/*---------------------------------------------------------------------------*/
+static U32
+laszip_point_core_size(
+    const U8                           point_data_format
+)
+{
+  switch (point_data_format)
+  {
+  case 0: return 20;
+  case 1: return 28;
+  case 2: return 26;
+  case 3: return 34;
+  case 4: return 57;
+  case 5: return 63;
+  case 6: return 30;
+  case 7: return 36;
+  case 8: return 38;
+  case 9: return 59;
+  case 10: return 67;
+  }
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static U32
+laszip_point_extra_bytes(
+    const laszip_dll_struct*           laszip_dll
+)
+{
+  U32 core_size = laszip_point_core_size(laszip_dll->header.point_data_format);
+  if (laszip_dll->header.point_data_record_length <= core_size) return 0;
+  return laszip_dll->header.point_data_record_length - core_size;
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+laszip_unpack_point(
+    laszip_dll_struct*                 laszip_dll
+    , const U8*                        record
+)
+{
+  laszip_point_struct* point = &laszip_dll->point;
+  U8 format = laszip_dll->header.point_data_format;
+  U32 size;
+
+  if (format < 6)
+  {
+    memcpy(&point->X, record, 20);
+    size = 20;
+    if ((format == 1) || (format >= 3))
+    {
+      memcpy(&point->gps_time, record + size, 8);
+      size += 8;
+    }
+    if ((format == 2) || (format == 3) || (format == 5))
+    {
+      memcpy(point->rgb, record + size, 6);
+      size += 6;
+    }
+    if (format >= 4)
+    {
+      memcpy(point->wave_packet, record + size, 29);
+      size += 29;
+    }
+  }
+  else
+  {
+    memcpy(&point->X, record, 14);
+    point->extended_return_number = record[14] & 0x0F;
+    point->extended_number_of_returns = record[14] >> 4;
+    point->return_number = (point->extended_return_number > 7 ? 7 : point->extended_return_number);
+    point->number_of_returns = (point->extended_number_of_returns > 7 ? 7 : point->extended_number_of_returns);
+    point->extended_classification_flags = record[15] & 0x0F;
+    point->synthetic_flag = record[15] & 0x01;
+    point->keypoint_flag = (record[15] >> 1) & 0x01;
+    point->withheld_flag = (record[15] >> 2) & 0x01;
+    point->extended_scanner_channel = (record[15] >> 4) & 0x03;
+    point->scan_direction_flag = (record[15] >> 6) & 0x01;
+    point->edge_of_flight_line = record[15] >> 7;
+    point->extended_classification = record[16];
+    point->classification = (record[16] < 32 ? record[16] : 0);
+    point->user_data = record[17];
+    memcpy(&point->extended_scan_angle, record + 18, 2);
+    point->scan_angle_rank = I8_CLAMP(I16_QUANTIZE(0.006f*point->extended_scan_angle));
+    memcpy(&point->point_source_ID, record + 20, 2);
+    memcpy(&point->gps_time, record + 22, 8);
+    size = 30;
+    if ((format == 7) || (format == 8) || (format == 10))
+    {
+      U32 bytes = (format == 7 ? 6 : 8);
+      memcpy(point->rgb, record + size, bytes);
+      size += bytes;
+    }
+    if (format >= 9)
+    {
+      memcpy(point->wave_packet, record + size, 29);
+      size += 29;
+    }
+  }
+
+  if (point->num_extra_bytes > 0)
+  {
+    U32 number = laszip_point_extra_bytes(laszip_dll);
+    if (number > (U32)point->num_extra_bytes) number = point->num_extra_bytes;
+    memcpy(point->extra_bytes, record + size, number);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+laszip_set_point_from_columns(
+    laszip_dll_struct*                 laszip_dll
+    , const laszip_points_struct*      points
+    , const U32                        i
+)
+{
+  laszip_point_struct* point = &laszip_dll->point;
+  const laszip_header_struct* header = &laszip_dll->header;
+  BOOL extended = (header->point_data_format > 5);
+
+  if (points->X && points->Y && points->Z)
+  {
+    point->X = points->X[i];
+    point->Y = points->Y[i];
+    point->Z = points->Z[i];
+  }
+  else if (points->coordinates)
+  {
+    const F64* coordinates = points->coordinates + 3 * (size_t)i;
+    point->X = I32_QUANTIZE((coordinates[0]-header->x_offset)/header->x_scale_factor);
+    point->Y = I32_QUANTIZE((coordinates[1]-header->y_offset)/header->y_scale_factor);
+    point->Z = I32_QUANTIZE((coordinates[2]-header->z_offset)/header->z_scale_factor);
+  }
+  if (points->intensity) point->intensity = points->intensity[i];
+  if (points->return_number)
+  {
+    U8 return_number = points->return_number[i];
+    if (extended) point->extended_return_number = return_number;
+    point->return_number = (return_number > 7 ? 7 : return_number);
+  }
+  if (points->number_of_returns)
+  {
+    U8 number_of_returns = points->number_of_returns[i];
+    if (extended) point->extended_number_of_returns = number_of_returns;
+    point->number_of_returns = (number_of_returns > 7 ? 7 : number_of_returns);
+  }
+  if (points->classification)
+  {
+    U8 classification = points->classification[i];
+    if (extended)
+    {
+      point->extended_classification = classification;
+      point->classification = (classification < 32 ? classification : 0);
+    }
+    else
+    {
+      point->classification = classification;
+    }
+  }
+  if (points->classification_flags)
+  {
+    U8 flags = points->classification_flags[i];
+    point->synthetic_flag = flags & 0x01;
+    point->keypoint_flag = (flags >> 1) & 0x01;
+    point->withheld_flag = (flags >> 2) & 0x01;
+    if (extended) point->extended_classification_flags = flags & 0x0F;
+  }
+  if (points->scanner_channel && extended) point->extended_scanner_channel = points->scanner_channel[i];
+  if (points->scan_direction_flag) point->scan_direction_flag = points->scan_direction_flag[i];
+  if (points->edge_of_flight_line) point->edge_of_flight_line = points->edge_of_flight_line[i];
+  if (points->scan_angle)
+  {
+    if (extended)
+    {
+      point->extended_scan_angle = points->scan_angle[i];
+      point->scan_angle_rank = I8_CLAMP(I16_QUANTIZE(0.006f*point->extended_scan_angle));
+    }
+    else
+    {
+      point->scan_angle_rank = I8_CLAMP(points->scan_angle[i]);
+    }
+  }
+  if (points->user_data) point->user_data = points->user_data[i];
+  if (points->point_source_ID) point->point_source_ID = points->point_source_ID[i];
+  if (points->gps_time) point->gps_time = points->gps_time[i];
+  if (points->rgb) memcpy(point->rgb, points->rgb + 4 * (size_t)i, 8);
+  if (points->extra_bytes && (point->num_extra_bytes > 0))
+  {
+    U32 number = laszip_point_extra_bytes(laszip_dll);
+    if (number > (U32)point->num_extra_bytes)
+    {
+      memcpy(point->extra_bytes, points->extra_bytes + (size_t)number * i, point->num_extra_bytes);
+    }
+    else
+    {
+      memcpy(point->extra_bytes, points->extra_bytes + (size_t)number * i, number);
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_write_points(
+    laszip_POINTER                     pointer
+    , laszip_U32                       number
+    , const laszip_points_struct*      points
+    , laszip_U32*                      number_written
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (number_written == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_U32 pointer 'number_written' is zero");
+      return 1;
+    }
+
+    *number_written = 0;
+
+    if (points == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_points_struct pointer 'points' is zero");
+      return 1;
+    }
+
+    if (laszip_dll->writer == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "writing points before writer was opened");
+      return 1;
+    }
+
+    // without a point count in the header the inventory provides it when closing
+
+    if ((laszip_dll->inventory == 0) && (laszip_dll->npoints == 0))
+    {
+      laszip_dll->inventory = new laszip_dll_inventory;
+    }
+
+    U32 record_length = laszip_dll->header.point_data_record_length;
+
+    for (U32 i = 0; i < number; i++)
+    {
+      if (points->records)
+      {
+        laszip_unpack_point(laszip_dll, points->records + (size_t)record_length * i);
+      }
+      else
+      {
+        laszip_set_point_from_columns(laszip_dll, points, i);
+      }
+
+      // the error message was already set
+
+      if (laszip_dll->lax_index)
+      {
+        if (laszip_write_indexed_point(pointer)) return 1;
+      }
+      else
+      {
+        if (laszip_write_point(pointer)) return 1;
+      }
+
+      if (laszip_dll->inventory)
+      {
+        laszip_dll->inventory->add(&laszip_dll->point);
+      }
+
+      (*number_written)++;
+    }
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_write_points");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
 laszip_write_indexed_point(
@@ -3591,6 +3880,42 @@ laszip_decompress_selective(
   return 0;
 }
 
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_set_decompress_threads(
+    laszip_POINTER                     pointer
+    , const laszip_U32                 decompress_threads
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (laszip_dll->reader)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is already open");
+      return 1;
+    }
+
+    if (laszip_dll->writer)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "writer is already open");
+      return 1;
+    }
+
+    laszip_dll->decompress_threads = decompress_threads;
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_set_decompress_threads");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
 /*---------------------------------------------------------------------------*/
 static I32
 laszip_read_header(
@@ -4410,6 +4735,13 @@ laszip_read_header(
     return 1;
   }
 
+  // maybe decompress chunks ahead on several threads
+
+  if (laszip_dll->decompress_threads > 1)
+  {
+    laszip_dll->reader->set_threads(laszip_dll->decompress_threads, (laszip_dll->header.number_of_point_records ? laszip_dll->header.number_of_point_records : laszip_dll->header.extended_number_of_point_records));
+  }
+
   if (!laszip_dll->reader->init(laszip_dll->streamin))
   {
     snprintf(laszip_dll->error, sizeof(laszip_dll->error), "init of LASreadPoint failed");
@@ -4624,12 +4956,23 @@ laszip_inside_rectangle(
     laszip_dll->lax_r_min_y = r_min_y;
     laszip_dll->lax_r_max_x = r_max_x;
     laszip_dll->lax_r_max_y = r_max_y;
+    laszip_dll->lax_inside = TRUE;
 
     if (laszip_dll->lax_index)
     {
       if (laszip_dll->lax_index->intersect_rectangle(r_min_x, r_min_y, r_max_x, r_max_y))
       {
         *is_empty = 0;
+        if (laszip_dll->decompress_threads > 1)
+        {
+          // the threads only decompress the chunks of the intersected intervals ahead
+          U32* starts;
+          U32* ends;
+          U32 num_intervals = laszip_dll->lax_index->get_intervals(&starts, &ends);
+          laszip_dll->reader->set_intervals(num_intervals, starts, ends);
+          if (starts) delete [] starts;
+          if (ends) delete [] ends;
+        }
       }
       else
       {
@@ -4768,6 +5111,218 @@ laszip_read_point(
   return 0;
 }
 
+/*---------------------------------------------------------------------------*/
+static void
+laszip_pack_point(
+    const laszip_dll_struct*           laszip_dll
+    , U8*                              record
+)
+{
+  const laszip_point_struct* point = &laszip_dll->point;
+  U8 format = laszip_dll->header.point_data_format;
+  U32 size;
+
+  if (format < 6)
+  {
+    memcpy(record, &point->X, 20);
+    size = 20;
+    if ((format == 1) || (format >= 3))
+    {
+      memcpy(record + size, &point->gps_time, 8);
+      size += 8;
+    }
+    if ((format == 2) || (format == 3) || (format == 5))
+    {
+      memcpy(record + size, point->rgb, 6);
+      size += 6;
+    }
+    if (format >= 4)
+    {
+      memcpy(record + size, point->wave_packet, 29);
+      size += 29;
+    }
+  }
+  else
+  {
+    memcpy(record, &point->X, 14);
+    record[14] = (U8)((point->extended_number_of_returns << 4) | point->extended_return_number);
+    record[15] = (U8)((point->edge_of_flight_line << 7) | (point->scan_direction_flag << 6) | (point->extended_scanner_channel << 4) | point->extended_classification_flags);
+    record[16] = point->extended_classification;
+    record[17] = point->user_data;
+    memcpy(record + 18, &point->extended_scan_angle, 2);
+    memcpy(record + 20, &point->point_source_ID, 2);
+    memcpy(record + 22, &point->gps_time, 8);
+    size = 30;
+    if ((format == 7) || (format == 8) || (format == 10))
+    {
+      U32 bytes = (format == 7 ? 6 : 8);
+      memcpy(record + size, point->rgb, bytes);
+      size += bytes;
+    }
+    if (format >= 9)
+    {
+      memcpy(record + size, point->wave_packet, 29);
+      size += 29;
+    }
+  }
+
+  U32 number = laszip_point_extra_bytes(laszip_dll);
+  if (number)
+  {
+    if (number > (U32)point->num_extra_bytes)
+    {
+      memcpy(record + size, point->extra_bytes, point->num_extra_bytes);
+      memset(record + size + point->num_extra_bytes, 0, number - point->num_extra_bytes);
+    }
+    else
+    {
+      memcpy(record + size, point->extra_bytes, number);
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+static void
+laszip_get_point_into_columns(
+    const laszip_dll_struct*           laszip_dll
+    , const laszip_points_struct*      points
+    , const U32                        i
+)
+{
+  const laszip_point_struct* point = &laszip_dll->point;
+  const laszip_header_struct* header = &laszip_dll->header;
+  BOOL extended = (header->point_data_format > 5);
+
+  if (points->X) points->X[i] = point->X;
+  if (points->Y) points->Y[i] = point->Y;
+  if (points->Z) points->Z[i] = point->Z;
+  if (points->coordinates)
+  {
+    F64* coordinates = points->coordinates + 3 * (size_t)i;
+    coordinates[0] = header->x_scale_factor*point->X+header->x_offset;
+    coordinates[1] = header->y_scale_factor*point->Y+header->y_offset;
+    coordinates[2] = header->z_scale_factor*point->Z+header->z_offset;
+  }
+  if (points->intensity) points->intensity[i] = point->intensity;
+  if (points->return_number) points->return_number[i] = (extended ? point->extended_return_number : point->return_number);
+  if (points->number_of_returns) points->number_of_returns[i] = (extended ? point->extended_number_of_returns : point->number_of_returns);
+  if (points->classification) points->classification[i] = (extended ? point->extended_classification : point->classification);
+  if (points->classification_flags)
+  {
+    if (extended)
+    {
+      points->classification_flags[i] = point->extended_classification_flags;
+    }
+    else
+    {
+      points->classification_flags[i] = (U8)((point->withheld_flag << 2) | (point->keypoint_flag << 1) | point->synthetic_flag);
+    }
+  }
+  if (points->scanner_channel) points->scanner_channel[i] = (extended ? point->extended_scanner_channel : 0);
+  if (points->scan_direction_flag) points->scan_direction_flag[i] = point->scan_direction_flag;
+  if (points->edge_of_flight_line) points->edge_of_flight_line[i] = point->edge_of_flight_line;
+  if (points->scan_angle) points->scan_angle[i] = (extended ? point->extended_scan_angle : point->scan_angle_rank);
+  if (points->user_data) points->user_data[i] = point->user_data;
+  if (points->point_source_ID) points->point_source_ID[i] = point->point_source_ID;
+  if (points->gps_time) points->gps_time[i] = point->gps_time;
+  if (points->rgb) memcpy(points->rgb + 4 * (size_t)i, point->rgb, 8);
+  if (points->extra_bytes)
+  {
+    U32 number = laszip_point_extra_bytes(laszip_dll);
+    if (number)
+    {
+      U8* extra_bytes = points->extra_bytes + (size_t)number * i;
+      if (number > (U32)point->num_extra_bytes)
+      {
+        memcpy(extra_bytes, point->extra_bytes, point->num_extra_bytes);
+        memset(extra_bytes + point->num_extra_bytes, 0, number - point->num_extra_bytes);
+      }
+      else
+      {
+        memcpy(extra_bytes, point->extra_bytes, number);
+      }
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_read_points(
+    laszip_POINTER                     pointer
+    , laszip_U32                       number
+    , const laszip_points_struct*      points
+    , laszip_U32*                      number_read
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (number_read == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_U32 pointer 'number_read' is zero");
+      return 1;
+    }
+
+    *number_read = 0;
+
+    if (points == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_points_struct pointer 'points' is zero");
+      return 1;
+    }
+
+    if (laszip_dll->reader == 0)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading points before reader was opened");
+      return 1;
+    }
+
+    // only as many as are left
+
+    if ((I64)number > (laszip_dll->npoints - laszip_dll->p_count))
+    {
+      number = (laszip_dll->p_count < laszip_dll->npoints ? (U32)(laszip_dll->npoints - laszip_dll->p_count) : 0);
+    }
+
+    U32 record_length = laszip_dll->header.point_data_record_length;
+
+    for (U32 i = 0; i < number; i++)
+    {
+      // the error message was already set
+
+      if (laszip_dll->lax_inside)
+      {
+        // only the points inside the rectangle of laszip_inside_rectangle()
+        laszip_BOOL is_done;
+        if (laszip_read_inside_point(pointer, &is_done)) return 1;
+        if (is_done) break;
+      }
+      else if (laszip_read_point(pointer))
+      {
+        return 1;
+      }
+
+      if (points->records)
+      {
+        laszip_pack_point(laszip_dll, points->records + (size_t)record_length * i);
+      }
+      laszip_get_point_into_columns(laszip_dll, points, i);
+
+      (*number_read)++;
+    }
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_read_points");
+    return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
 laszip_read_inside_point(
@@ -4869,6 +5424,7 @@ laszip_close_reader(
       delete laszip_dll->lax_index;
       laszip_dll->lax_index = 0;
     }
+    laszip_dll->lax_inside = FALSE;
 
     if (laszip_dll->file)
     {
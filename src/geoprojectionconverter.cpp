@@ -848,6 +848,13 @@ ProjParameters::~ProjParameters() {
     proj_destroy(proj_transform_crs);
     proj_transform_crs = nullptr;
   }
+  // Free the transformations and contexts of the threads
+  for (size_t i = 0; i < proj_thread_transform.size(); i++) {
+    if (proj_thread_transform[i]) proj_destroy(proj_thread_transform[i]);
+    if (proj_thread_ctx[i]) proj_context_destroy(proj_thread_ctx[i]);
+  }
+  proj_thread_transform.clear();
+  proj_thread_ctx.clear();
   // Release memory if proj_info_args
   if (proj_info_args) {
     for (int i = 0; i < arg_count; ++i) {
@@ -7918,6 +7925,192 @@ bool GeoProjectionConverter::to_target(const double* point, double& x, double& y
   return false;
 }
 
+// converts 'number' points stored as x, y, elevation, x, y, elevation, ... in place. the
+// projection types are looked at once per batch and not once per point and the PROJ
+// library transforms the entire batch with one call when it offers proj_trans_generic().
+// the results are identical to calling to_target() for each point that can be converted.
+
+bool GeoProjectionConverter::to_target(double* points, const unsigned int number) const {
+  if (source_projection && target_projection) {
+    if ((source_projection->type == GEO_PROJECTION_ECEF) || (target_projection->type == GEO_PROJECTION_ECEF)) {
+      for (unsigned int i = 0; i < number; i++) to_target(points + 3 * i);
+      return true;
+    }
+    double* point = points;
+    double* end = points + 3 * (size_t)number;
+    // the first point decides the zone when the target UTM zone was not specified
+    if ((target_projection->type == GEO_PROJECTION_UTM) && (((GeoProjectionParametersUTM*)target_projection)->utm_zone_number == -1)) {
+      if (point == end) return true;
+      to_target(point);
+      point += 3;
+    }
+    double* start = point;
+    double longitude;
+    double latitude;
+
+    // from the source projection to latitude and longitude stored in place of x and y
+
+    switch (source_projection->type) {
+      case GEO_PROJECTION_UTM:
+        for (point = start; point < end; point += 3) {
+          UTMtoLL(
+              coordinates2meter * point[0], coordinates2meter * point[1], latitude, longitude, ellipsoid,
+              (const GeoProjectionParametersUTM*)source_projection);
+          point[0] = latitude;
+          point[1] = longitude;
+        }
+        break;
+      case GEO_PROJECTION_LCC:
+        for (point = start; point < end; point += 3) {
+          LCCtoLL(
+              coordinates2meter * point[0], coordinates2meter * point[1], latitude, longitude, ellipsoid,
+              (const GeoProjectionParametersLCC*)source_projection);
+          point[0] = latitude;
+          point[1] = longitude;
+        }
+        break;
+      case GEO_PROJECTION_TM:
+        for (point = start; point < end; point += 3) {
+          TMtoLL(
+              coordinates2meter * point[0], coordinates2meter * point[1], latitude, longitude, ellipsoid,
+              (const GeoProjectionParametersTM*)source_projection);
+          point[0] = latitude;
+          point[1] = longitude;
+        }
+        break;
+      case GEO_PROJECTION_LONG_LAT:
+        for (point = start; point < end; point += 3) {
+          longitude = point[0];
+          point[0] = point[1];
+          point[1] = longitude;
+        }
+        break;
+      case GEO_PROJECTION_LAT_LONG:
+        break;
+      case GEO_PROJECTION_AEAC:
+        for (point = start; point < end; point += 3) {
+          AEACtoLL(
+              coordinates2meter * point[0], coordinates2meter * point[1], latitude, longitude, ellipsoid,
+              (const GeoProjectionParametersAEAC*)source_projection);
+          point[0] = latitude;
+          point[1] = longitude;
+        }
+        break;
+      case GEO_PROJECTION_OS:
+        for (point = start; point < end; point += 3) {
+          OStoLL(
+              coordinates2meter * point[0], coordinates2meter * point[1], latitude, longitude, ellipsoid,
+              (const GeoProjectionParametersOS*)source_projection);
+          point[0] = latitude;
+          point[1] = longitude;
+        }
+        break;
+      case GEO_PROJECTION_HOM:
+        for (point = start; point < end; point += 3) {
+          HOMtoLL(
+              coordinates2meter * point[0], coordinates2meter * point[1], latitude, longitude, ellipsoid,
+              (const GeoProjectionParametersHOM*)source_projection);
+          point[0] = latitude;
+          point[1] = longitude;
+        }
+        break;
+      default:
+        for (point = start; point < end; point += 3) {
+          point[0] = 0.0;
+          point[1] = 0.0;
+        }
+        break;
+    }
+
+    // from latitude and longitude to the target projection
+
+    switch (target_projection->type) {
+      case GEO_PROJECTION_UTM:
+        for (point = start; point < end; point += 3) {
+          LLtoUTM(point[0], point[1], point[0], point[1], ellipsoid, (const GeoProjectionParametersUTM*)target_projection);
+          point[0] = meter2coordinates * point[0];
+          point[1] = meter2coordinates * point[1];
+        }
+        break;
+      case GEO_PROJECTION_LCC:
+        for (point = start; point < end; point += 3) {
+          LLtoLCC(point[0], point[1], point[0], point[1], ellipsoid, (const GeoProjectionParametersLCC*)target_projection);
+          point[0] = meter2coordinates * point[0];
+          point[1] = meter2coordinates * point[1];
+        }
+        break;
+      case GEO_PROJECTION_TM:
+        for (point = start; point < end; point += 3) {
+          LLtoTM(point[0], point[1], point[0], point[1], ellipsoid, (const GeoProjectionParametersTM*)target_projection);
+          point[0] = meter2coordinates * point[0];
+          point[1] = meter2coordinates * point[1];
+        }
+        break;
+      case GEO_PROJECTION_LONG_LAT:
+        for (point = start; point < end; point += 3) {
+          latitude = point[0];
+          point[0] = point[1];
+          point[1] = latitude;
+        }
+        break;
+      case GEO_PROJECTION_LAT_LONG:
+        break;
+      case GEO_PROJECTION_AEAC:
+        for (point = start; point < end; point += 3) {
+          LLtoAEAC(point[0], point[1], point[0], point[1], ellipsoid, (const GeoProjectionParametersAEAC*)target_projection);
+          point[0] = meter2coordinates * point[0];
+          point[1] = meter2coordinates * point[1];
+        }
+        break;
+      case GEO_PROJECTION_OS:
+        for (point = start; point < end; point += 3) {
+          LLtoOS(point[0], point[1], point[0], point[1], ellipsoid, (const GeoProjectionParametersOS*)target_projection);
+          point[0] = meter2coordinates * point[0];
+          point[1] = meter2coordinates * point[1];
+        }
+        break;
+      case GEO_PROJECTION_HOM:
+        for (point = start; point < end; point += 3) {
+          LLtoHOM(point[0], point[1], point[0], point[1], ellipsoid, (const GeoProjectionParametersHOM*)target_projection);
+          point[0] = meter2coordinates * point[0];
+          point[1] = meter2coordinates * point[1];
+        }
+        break;
+    }
+    for (point = start; point < end; point += 3) {
+      point[2] = meter2elevation * (elevation2meter * point[2] + elevation_offset_in_meter);
+    }
+    return true;
+  } else if (projParameters.proj_target_crs) {
+    return do_proj_crs_transformation(points, number);
+  }
+  return false;
+}
+
+// makes room for the PROJ transformations of 'number_of_threads' threads. this must be
+// called before the threads start because they only fill in their own entry later.
+
+void GeoProjectionConverter::set_number_of_threads(const unsigned int number_of_threads) {
+  std::lock_guard<std::mutex> lock(projParameters.proj_thread_mutex);
+  if (number_of_threads > projParameters.proj_thread_transform.size()) {
+    projParameters.proj_thread_ctx.resize(number_of_threads, nullptr);
+    projParameters.proj_thread_transform.resize(number_of_threads, nullptr);
+  }
+}
+
+// same as to_target() for a batch but safe to call concurrently with different 'thread'
+// indices. the built-in projections only read the converter once an unspecified target
+// UTM zone has been decided, so the caller should convert the first batch on its own.
+
+bool GeoProjectionConverter::to_target(double* points, const unsigned int number, const unsigned int thread) const {
+  if (source_projection && target_projection) {
+    return to_target(points, number);
+  } else if (projParameters.proj_target_crs) {
+    return do_proj_crs_transformation(points, number, thread);
+  }
+  return false;
+}
+
 bool GeoProjectionConverter::has_target_precision() const {
   return target_precision;
 }
@@ -9050,4 +9243,53 @@ bool GeoProjectionConverter::do_proj_crs_transformation(double& x, double& y, do
   elevation = result.xyzt.z;
 
   return true;
-}
\ No newline at end of file
+}
+/// Executing the CRS transformation for 'number' points stored as x, y, elevation, x, y, elevation, ...
+/// with a single call into the PROJ library if it is recent enough to offer proj_trans_generic().
+/// Threads other than the first one use their own PROJ context and transformation object.
+bool GeoProjectionConverter::do_proj_crs_transformation(double* points, const unsigned int number, const unsigned int thread) const {
+  if (!projParameters.proj_transform_crs) return false;
+
+  PJ* proj_transform_crs = (thread ? get_proj_thread_transform(thread) : projParameters.proj_transform_crs);
+  if (!proj_transform_crs) return false;
+
+  if (proj_trans_generic_ptr) {
+    // the same time of zero for all points as in proj_coord(x, y, elevation, 0)
+    double time = 0.0;
+    size_t stride = 3 * sizeof(double);
+    proj_trans_generic(proj_transform_crs, PJ_FWD, points, stride, number, points + 1, stride, number, points + 2, stride, number, &time, 0, 1);
+  } else {
+    for (unsigned int i = 0; i < number; i++) {
+      PJ_COORD result = proj_trans(proj_transform_crs, PJ_FWD, proj_coord(points[3 * i], points[3 * i + 1], points[3 * i + 2], 0));
+      points[3 * i] = result.xyzt.x;
+      points[3 * i + 1] = result.xyzt.y;
+      points[3 * i + 2] = result.xyzt.z;
+    }
+  }
+  return true;
+}
+
+/// Returns the PROJ transformation object of this thread and creates it (together with a
+/// context of its own) the first time the thread asks for it
+PJ* GeoProjectionConverter::get_proj_thread_transform(const unsigned int thread) const {
+  if (thread >= projParameters.proj_thread_transform.size()) {
+    laserror("PROJ transformation for thread %u requested but only %u threads were set", thread, (unsigned int)projParameters.proj_thread_transform.size());
+  }
+  if (projParameters.proj_thread_transform[thread] == nullptr) {
+    // the shared source and target CRS objects are only used by one thread at a time
+    std::lock_guard<std::mutex> lock(projParameters.proj_thread_mutex);
+    PJ_CONTEXT* proj_ctx = proj_context_create();
+    PJ* proj_transform_crs = nullptr;
+    if (proj_ctx) {
+      proj_transform_crs = proj_create_crs_to_crs_from_pj(proj_ctx, projParameters.proj_source_crs, projParameters.proj_target_crs, nullptr, nullptr);
+    }
+    if (!proj_transform_crs) {
+      if (proj_ctx) proj_context_destroy(proj_ctx);
+      laserror("Failed to create PROJ object for the transformation of thread %u", thread);
+    }
+    projParameters.proj_thread_ctx[thread] = proj_ctx;
+    projParameters.proj_thread_transform[thread] = proj_transform_crs;
+    LASMessage(LAS_VERY_VERBOSE, "the PROJ transformations object of thread %u was successfully created", thread);
+  }
+  return projParameters.proj_thread_transform[thread];
+}
@@ -51,6 +51,8 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- to_target() for batches of points on several threads at once
+    18 October 2026 -- to_target() for batches of points with few calls into PROJ
      1 September 2024 -- integration of the PROJ Library for CRS transformations 
      1 November 2018 -- changes requested by Kirk Waters including GEO_GCS_NAD83_CORS96
      7 September 2018 -- introduced the LASCopyString macro to replace _strdup
@@ -74,6 +76,8 @@
 #include <stdio.h>
 #include <string>
 #include <algorithm>
+#include <mutex>
+#include <vector>
 #include "lasdefinitions.hpp"
 #include "wktparser.h"
 
@@ -300,6 +304,12 @@ class ProjParameters
   PJ* proj_source_crs;
   PJ* proj_target_crs;
   PJ* proj_transform_crs;
+
+  // PROJ objects must not be used by several threads at once. every additional thread
+  // gets its own context and transformation that are created when it first needs them
+  mutable std::vector<PJ_CONTEXT*> proj_thread_ctx;
+  mutable std::vector<PJ*> proj_thread_transform;
+  mutable std::mutex proj_thread_mutex;
   
   ProjParameters();
   ~ProjParameters();
@@ -473,6 +483,13 @@ public:
 
   bool to_target(double* point) const;
   bool to_target(const double* point, double& x, double& y, double& elevation) const;
+  bool to_target(double* points, const unsigned int number) const;
+
+  // batches may be converted concurrently when each thread uses its own 'thread' index
+  // that is smaller than the number of threads set before starting them
+
+  void set_number_of_threads(const unsigned int number_of_threads);
+  bool to_target(double* points, const unsigned int number, const unsigned int thread) const;
 
   bool has_target_precision() const;
   double get_target_precision(double header_precision = 0.0) const;
@@ -560,5 +577,7 @@ private:
   void set_proj_param_for_transformation_with_json(const char* source_filename, const char* target_filename);
   void set_proj_param_for_transformation_with_wkt(const char* source_filename, const char* target_filename);
   bool do_proj_crs_transformation(double& x, double& y, double& elevation) const;
+  bool do_proj_crs_transformation(double* points, const unsigned int number, const unsigned int thread = 0) const;
+  PJ* get_proj_thread_transform(const unsigned int thread) const;
 };
 #pragma warning(pop)
\ No newline at end of file
@@ -33,6 +33,9 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- with '-set_point_type' skip decompressing what the new point type does not store
+    18 October 2026 -- '-threads 8' reprojects the batches of points on 8 threads
+    18 October 2026 -- reproject points in batches with few calls into PROJ
     30 October 2020 -- fail / exit with error code when input file is corrupt
      9 September 2019 -- warn if modifying x or y coordinates for tiles with VLR
     30 November 2017 -- set OGC WKT with '-set_ogc_wkt "PROJCS[\"WGS84\",GEOGCS[\"GCS_ ..."
@@ -67,6 +70,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <cstdint> 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "mydefs.hpp"
 #include "lastool.hpp"
@@ -611,9 +618,198 @@ const U8 convert_point_type_from_to[11][11] =
 extern int las2las_gui(int argc, char* argv[], LASreadOpener* lasreadopener);
 #endif
 
-#ifdef COMPILE_WITH_MULTI_CORE
-extern void las2las_multi_core(int argc, char* argv[], GeoProjectionConverter* geoprojectionconverter, LASreadOpener* lasreadopener, LASwriteOpener* laswriteopener, int cores, BOOL cpu64);
-#endif
+// collects the surviving points that are reprojected together so that their coordinates
+// are converted by GeoProjectionConverter with one call per batch instead of per point.
+// with several threads each of them converts its own slice of the batch. the threads
+// are started once by init() and then wait for the slices of every following batch.
+
+#define LAS2LAS_REPROJECT_BATCH 4096
+
+class LASreprojectBatch
+{
+public:
+  U32 count;
+  U32 capacity;
+  U32 num_threads;
+  BOOL zone_decided;
+  LASpoint* points;
+  F64* coordinates;
+
+  BOOL init(const LASpoint* point, const U32 num_threads = 1)
+  {
+    clean();
+    this->num_threads = (num_threads ? num_threads : 1);
+    capacity = LAS2LAS_REPROJECT_BATCH * this->num_threads;
+    points = new LASpoint[capacity];
+    coordinates = new F64[3 * capacity];
+    for (U32 i = 0; i < capacity; i++)
+    {
+      if (!points[i].init(point->quantizer, point->num_items, point->items, point->attributer)) return FALSE;
+    }
+    for (U32 t = 1; t < this->num_threads; t++)
+    {
+      workers.push_back(std::thread(&LASreprojectBatch::work, this, t));
+    }
+    return TRUE;
+  };
+
+  // copies the point and its coordinates. returns TRUE once the batch is full.
+  BOOL add(const LASpoint* point)
+  {
+    points[count] = *point;
+    coordinates[3 * count] = point->get_x();
+    coordinates[3 * count + 1] = point->get_y();
+    coordinates[3 * count + 2] = point->get_z();
+    count++;
+    return (count == capacity);
+  };
+
+  void reproject(const GeoProjectionConverter* geoprojectionconverter, const LASquantizer* reproject_quantizer)
+  {
+    // the first batch is converted by one thread because its first point may decide the target UTM zone
+    if ((num_threads == 1) || !zone_decided || (count < 2 * LAS2LAS_REPROJECT_BATCH))
+    {
+      reproject_slice(geoprojectionconverter, reproject_quantizer, 0, count, 0);
+      zone_decided = TRUE;
+      return;
+    }
+    // hand the other slices to the waiting workers and convert the first one here
+    std::unique_lock<std::mutex> lock(mutex);
+    converter = geoprojectionconverter;
+    quantizer = reproject_quantizer;
+    slice = (count + num_threads - 1) / num_threads;
+    pending = (U32)workers.size();
+    round++;
+    lock.unlock();
+    work_ready.notify_all();
+    reproject_slice(geoprojectionconverter, reproject_quantizer, 0, slice, 0);
+    lock.lock();
+    while (pending)
+    {
+      work_done.wait(lock);
+    }
+  };
+
+  // a worker converts slice 't' of every batch until clean() stops it
+  void work(U32 t)
+  {
+    U32 done = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+      while (!stop && (round == done))
+      {
+        work_ready.wait(lock);
+      }
+      if (stop) return;
+      done = round;
+      U32 start = MIN2(count, t * slice);
+      U32 end = MIN2(count, (t + 1) * slice);
+      lock.unlock();
+      if (start < end) reproject_slice(converter, quantizer, start, end, t);
+      lock.lock();
+      if (--pending == 0) work_done.notify_one();
+    }
+  };
+
+  void reproject_slice(const GeoProjectionConverter* geoprojectionconverter, const LASquantizer* reproject_quantizer, U32 start, U32 end, U32 thread)
+  {
+    geoprojectionconverter->to_target(coordinates + 3 * start, end - start, thread);
+    for (U32 i = start; i < end; i++)
+    {
+      points[i].coordinates[0] = coordinates[3 * i];
+      points[i].coordinates[1] = coordinates[3 * i + 1];
+      points[i].coordinates[2] = coordinates[3 * i + 2];
+      points[i].compute_XYZ(reproject_quantizer);
+    }
+  };
+
+  // writes the reprojected points (after copying them into 'point' if it is given) and empties the batch
+  void write(LASwriter* laswriter, LASpoint* point, BOOL update_inventory)
+  {
+    for (U32 i = 0; i < count; i++)
+    {
+      LASpoint* p = &points[i];
+      if (point)
+      {
+        *point = points[i];
+        p = point;
+      }
+      laswriter->write_point(p);
+      if (update_inventory) laswriter->update_inventory(p);
+    }
+    count = 0;
+  };
+
+  // adds the reprojected points to the inventory and empties the batch
+  void inventory(LASinventory* lasinventory)
+  {
+    for (U32 i = 0; i < count; i++)
+    {
+      lasinventory->add(&points[i]);
+    }
+    count = 0;
+  };
+
+  void clean()
+  {
+    if (workers.size())
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = TRUE;
+      }
+      work_ready.notify_all();
+      for (size_t t = 0; t < workers.size(); t++)
+      {
+        workers[t].join();
+      }
+      workers.clear();
+      stop = FALSE;
+    }
+    round = 0;
+    if (points) delete [] points;
+    if (coordinates) delete [] coordinates;
+    points = 0;
+    coordinates = 0;
+    count = 0;
+    capacity = 0;
+  };
+
+  LASreprojectBatch()
+  {
+    count = 0;
+    capacity = 0;
+    num_threads = 1;
+    zone_decided = FALSE;
+    points = 0;
+    coordinates = 0;
+    stop = FALSE;
+    round = 0;
+    pending = 0;
+    slice = 0;
+    converter = 0;
+    quantizer = 0;
+  };
+
+  ~LASreprojectBatch()
+  {
+    clean();
+  };
+
+private:
+  std::vector<std::thread> workers;
+  // guards the batch that is handed to the workers in numbered rounds
+  std::mutex mutex;
+  std::condition_variable work_ready;
+  std::condition_variable work_done;
+  BOOL stop;
+  U32 round;
+  U32 pending;
+  U32 slice;
+  const GeoProjectionConverter* converter;
+  const LASquantizer* quantizer;
+};
 
 int main(int argc, char* argv[])
 {
@@ -669,6 +865,7 @@ int main(int argc, char* argv[])
   // extract a subsequence
   I64 subsequence_start = 0;
   I64 subsequence_stop = I64_MAX;
+  U32 num_threads = 1;
   // fix files with corrupt points
   bool clip_to_bounding_box = false;
   double start_time = 0;
@@ -726,6 +923,15 @@ int main(int argc, char* argv[])
       }
       i += 2;
     }
+    else if (strcmp(argv[i], "-threads") == 0)
+    {
+      lastool.parse_arg_cnt_check(i, 1, "number");
+      if ((sscanf_las(argv[i + 1], "%u", &num_threads) != 1) || (num_threads == 0))
+      {
+        lastool.error_parse_arg_n_invalid(i, 1);
+      }
+      i += 1;
+    }
     else if (strcmp(argv[i], "-start_at_point") == 0)
     {
       lastool.parse_arg_cnt_check(i, 1, "index of start point");
@@ -1172,13 +1378,9 @@ int main(int argc, char* argv[])
     }
     else
     {
-      las2las_multi_core(argc, argv, &geoprojectionconverter, &lasreadopener, &laswriteopener, lastool.cores, lastool.cpu64);
+      lastool.multi_core(&lasreadopener, &laswriteopener);
     }
   }
-  if (lastool.cpu64)
-  {
-    las2las_multi_core(argc, argv, &geoprojectionconverter, &lasreadopener, &laswriteopener, 1, TRUE);
-  }
 #endif
 
   // check input
@@ -1229,6 +1431,17 @@ int main(int argc, char* argv[])
     laserror("cannot load a single VLR and multiple VLRs at the same time");
   }
 
+  // the PROJ library needs separate objects for every thread
+
+  if (num_threads > 1) geoprojectionconverter.set_number_of_threads(num_threads);
+
+  // no need to decompress the LAZ layers that the new point type does not store
+
+  if ((set_point_data_format >= 0) && (set_point_data_format <= 10) && (laswriteopener.get_format() <= LAS_TOOLS_FORMAT_LAZ))
+  {
+    lasreadopener.set_decompress_selective(LASreadOpener::get_decompress_selective_for_point_type((U8)set_point_data_format));
+  }
+
   // possibly loop over multiple input files
   while (lasreadopener.active())
   {
@@ -1253,6 +1466,10 @@ int main(int argc, char* argv[])
 
       LASpoint* point = 0;
 
+      // the points that are reprojected together
+
+      LASreprojectBatch reproject_batch;
+
       // prepare the header for output
 
       if (set_global_encoding_gps_bit != -1)
@@ -2173,6 +2390,7 @@ int main(int argc, char* argv[])
           LASMessage(LAS_VERBOSE, "extra pass required: reading %lld points ...", lasreader->npoints);
           // maybe seek to start position
           if (subsequence_start) lasreader->seek(subsequence_start);
+          if (reproject_quantizer) reproject_batch.init(&lasreader->point, num_threads);
           while (lasreader->read_point())
           {
             if (lasreader->p_cnt > subsequence_stop) break;
@@ -2187,11 +2405,16 @@ int main(int argc, char* argv[])
         
             if (reproject_quantizer)
             {
-              lasreader->point.compute_coordinates();
-              geoprojectionconverter.to_target(lasreader->point.coordinates);
-              lasreader->point.compute_XYZ(reproject_quantizer);
+              if (reproject_batch.add(&lasreader->point))
+              {
+                reproject_batch.reproject(&geoprojectionconverter, reproject_quantizer);
+                reproject_batch.inventory(&lasinventory);
+              }
+            }
+            else
+            {
+              lasinventory.add(&lasreader->point);
             }
-            lasinventory.add(&lasreader->point);
 
             if (doIntensityRangeGet)
             {
@@ -2200,6 +2423,11 @@ int main(int argc, char* argv[])
               intensityMax = MAX2(ints, intensityMax);
             }
           }
+          if (reproject_quantizer)
+          {
+            reproject_batch.reproject(&geoprojectionconverter, reproject_quantizer);
+            reproject_batch.inventory(&lasinventory);
+          }
           lasreader->close();
 
           if (doIntensityRangeGet)
@@ -2287,6 +2515,8 @@ int main(int argc, char* argv[])
 
         if (subsequence_start) lasreader->seek(subsequence_start);
 
+        if (reproject_quantizer) reproject_batch.init(&lasreader->point, num_threads);
+
         // loop over points
 
         if (point) // full rewrite: point copy
@@ -2305,15 +2535,23 @@ int main(int argc, char* argv[])
 
             if (reproject_quantizer)
             {
-              lasreader->point.compute_coordinates();
-              geoprojectionconverter.to_target(lasreader->point.coordinates);
-              lasreader->point.compute_XYZ(reproject_quantizer);
+              if (reproject_batch.add(&lasreader->point))
+              {
+                reproject_batch.reproject(&geoprojectionconverter, reproject_quantizer);
+                reproject_batch.write(laswriter, point, !extra_pass);
+              }
+              continue;
             }
             *point = lasreader->point;
             laswriter->write_point(point);
             // without extra pass we need inventory of surviving points
             if (!extra_pass) laswriter->update_inventory(point);
           }
+          if (reproject_quantizer)
+          {
+            reproject_batch.reproject(&geoprojectionconverter, reproject_quantizer);
+            reproject_batch.write(laswriter, point, !extra_pass);
+          }
           delete point;
           point = 0;
         }
@@ -2333,14 +2571,22 @@ int main(int argc, char* argv[])
 
             if (reproject_quantizer)
             {
-              lasreader->point.compute_coordinates();
-              geoprojectionconverter.to_target(lasreader->point.coordinates);
-              lasreader->point.compute_XYZ(reproject_quantizer);
+              if (reproject_batch.add(&lasreader->point))
+              {
+                reproject_batch.reproject(&geoprojectionconverter, reproject_quantizer);
+                reproject_batch.write(laswriter, 0, !extra_pass);
+              }
+              continue;
             }
             laswriter->write_point(&lasreader->point);
             // without extra pass we need inventory of surviving points
             if (!extra_pass) laswriter->update_inventory(&lasreader->point);
           }
+          if (reproject_quantizer)
+          {
+            reproject_batch.reproject(&geoprojectionconverter, reproject_quantizer);
+            reproject_batch.write(laswriter, 0, !extra_pass);
+          }
         }
 
         // without the extra pass we need to fix the header now
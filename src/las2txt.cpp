@@ -28,6 +28,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- format points into a large buffer instead of calling fprintf() per field
     19 September 2023 -- added support of custom extented -parse flags. Support of (hsl) and (hsv) flags
     18 September 2023 -- added -coldesc argument to add column description
      7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
@@ -54,6 +55,7 @@
 ===============================================================================
 */
 #include "lasreader.hpp"
+#include "lasformatter.hpp"
 #include "lastool.hpp"
 #include "laswaveform13reader.hpp"
 #include "laswriter.hpp"
@@ -125,74 +127,39 @@ static void lidardouble2string(CHAR* string, double value) {
 }
 
 static void lidardouble2string(CHAR* string, double value, double precision) {
-  if (precision == 0.01)
-    sprintf(string, "%.2f", value);
-  else if (precision == 0.001)
-    sprintf(string, "%.3f", value);
-  else if (precision == 0.0001)
-    sprintf(string, "%.4f", value);
-  else if (precision == 0.1)
-    sprintf(string, "%.1f", value);
-  else if (precision == 0.00001)
-    sprintf(string, "%.5f", value);
-  else if (precision == 0.000001)
-    sprintf(string, "%.6f", value);
-  else if (precision == 0.0000001)
-    sprintf(string, "%.7f", value);
-  else if (precision == 0.00000001)
-    sprintf(string, "%.8f", value);
-  else if (precision == 0.000000001)
-    sprintf(string, "%.9f", value);
-  else if (precision == 0.0025)
-    sprintf(string, "%.4f", value);
-  else if (precision == 0.00025)
-    sprintf(string, "%.5f", value);
-  else if (precision == 0.000025)
-    sprintf(string, "%.6f", value);
-  else if (precision == 0.005)
-    sprintf(string, "%.3f", value);
-  else if (precision == 0.0005)
-    sprintf(string, "%.4f", value);
-  else if (precision == 0.00005)
-    sprintf(string, "%.5f", value);
-  else if (precision == 0.0000000001)
-    sprintf(string, "%.10f", value);
-  else if (precision == 0.00000000001)
-    sprintf(string, "%.11f", value);
-  else if (precision == 0.000000000001)
-    sprintf(string, "%.12f", value);
-  else if (precision == 0.0000000000001)
-    sprintf(string, "%.13f", value);
-  else if (precision == 0.00000000000001)
-    sprintf(string, "%.14f", value);
-  else if (precision == 0.000000000000001)
-    sprintf(string, "%.15f", value);
-  else
+  I32 decimals = lidarprecision2decimals(precision);
+  if (decimals < 0)
     lidardouble2string(string, value);
+  else
+    sprintf(string, "%.*f", decimals, value);
 }
 
-static void output_waveform(FILE* file_out, CHAR separator_sign, LASwaveform13reader* laswaveform13reader) {
+static void output_waveform(LASformatter* formatter, CHAR separator_sign, LASwaveform13reader* laswaveform13reader) {
   U32 i;
-  fprintf(file_out, "%d", laswaveform13reader->nbits);
-  fprintf(file_out, "%c%d", separator_sign, laswaveform13reader->nsamples);
+  formatter->put_int(laswaveform13reader->nbits);
+  formatter->put(separator_sign);
+  formatter->put_int(laswaveform13reader->nsamples);
   if (laswaveform13reader->nbits == 8) {
     for (i = 0; i < laswaveform13reader->nsamples; i++) {
-      fprintf(file_out, "%c%d", separator_sign, laswaveform13reader->samples[i]);
+      formatter->put(separator_sign);
+      formatter->put_int(laswaveform13reader->samples[i]);
     }
   } else if (laswaveform13reader->nbits == 16) {
     for (i = 0; i < laswaveform13reader->nsamples; i++) {
-      fprintf(file_out, "%c%d", separator_sign, ((U16*)laswaveform13reader->samples)[i]);
+      formatter->put(separator_sign);
+      formatter->put_int(((U16*)laswaveform13reader->samples)[i]);
     }
   } else if (laswaveform13reader->nbits == 32) {
     for (i = 0; i < laswaveform13reader->nsamples; i++) {
-      fprintf(file_out, "%c%d", separator_sign, ((I32*)laswaveform13reader->samples)[i]);
+      formatter->put(separator_sign);
+      formatter->put_int(((I32*)laswaveform13reader->samples)[i]);
     }
   }
 }
 
 static I32 attribute_starts[32];
 
-static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint* point, I32 index, CHAR* printstring) {
+static BOOL print_attribute(LASformatter* formatter, const LASheader* header, const LASpoint* point, I32 index) {
   if (index >= header->number_attributes) {
     return FALSE;
   }
@@ -202,20 +169,17 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, -1);
       } else {
-        fprintf(file, "%d", (I32)value);
+        formatter->put_int((I32)value);
       }
     }
   } else if (header->attributes[index].data_type == 2) {
@@ -224,20 +188,17 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, -1);
       } else {
-        fprintf(file, "%d", (I32)value);
+        formatter->put_int((I32)value);
       }
     }
   } else if (header->attributes[index].data_type == 3) {
@@ -246,20 +207,17 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, -1);
       } else {
-        fprintf(file, "%d", (I32)value);
+        formatter->put_int((I32)value);
       }
     }
   } else if (header->attributes[index].data_type == 4) {
@@ -268,20 +226,17 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, -1);
       } else {
-        fprintf(file, "%d", (I32)value);
+        formatter->put_int((I32)value);
       }
     }
   } else if (header->attributes[index].data_type == 5) {
@@ -290,20 +245,17 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, -1);
       } else {
-        fprintf(file, "%u", value);
+        formatter->put_int(value);
       }
     }
   } else if (header->attributes[index].data_type == 6) {
@@ -312,20 +264,17 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, -1);
       } else {
-        fprintf(file, "%d", value);
+        formatter->put_int(value);
       }
     }
   } else if (header->attributes[index].data_type == 7) {
@@ -334,23 +283,20 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * ((I64)value) + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       } else {
         F64 temp_d = header->attributes[index].scale[0] * ((I64)value);
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + ((I64)value);
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, -1);
       } else {
 #ifdef _WIN32
-        fprintf(file, "%I64u", value);
+        formatter->printf("%I64u", value);
 #else
-        fprintf(file, "%llu", value);
+        formatter->printf("%llu", value);
 #endif
       }
     }
@@ -360,20 +306,17 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, -1);
       } else {
-        fprintf(file, "%lld", value);
+        formatter->put_int(value);
       }
     }
   } else if (header->attributes[index].data_type == 9) {
@@ -382,20 +325,17 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, -1);
       } else {
-        fprintf(file, "%g", value);
+        formatter->put_g(value);
       }
     }
   } else if (header->attributes[index].data_type == 10) {
@@ -404,24 +344,21 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, lidarprecision2decimals(header->attributes[index].scale[0]));
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        formatter->put_double(temp_d, -1);
       } else {
-        fprintf(file, "%g", value);
+        formatter->put_g(value);
       }
     }
   } else {
-    fprintf(file, "-");
+    formatter->put('-');
     LASMessage(LAS_WARNING, "data type %d of attribute %d not implemented.", header->attributes[index].data_type, index);
     return FALSE;
   }
@@ -452,10 +389,6 @@ static void parse_extended_flags(char* parse_string) {
 extern int las2txt_gui(int argc, char* argv[], LASreadOpener* lasreadopener);
 #endif
 
-#ifdef COMPILE_WITH_MULTI_CORE
-extern void las2txt_multi_core(int argc, char* argv[], LASreadOpener* lasreadopener, LASwriteOpener* laswriteopener, int cores, BOOL cpu64);
-#endif
-
 int main(int argc, char* argv[]) {
   LasTool_las2txt lastool;
   lastool.init(argc, argv, "las2txt");
@@ -470,6 +403,7 @@ int main(int argc, char* argv[]) {
   CHAR* parse_string = 0;
   CHAR* extra_string = 0;
   CHAR printstring[512];
+  LASformatter formatter;
   double start_time = 0.0;
   bool coldesc = false;
 
@@ -600,12 +534,9 @@ int main(int argc, char* argv[]) {
     } else if (lasreadopener.is_merged()) {
       LASMessage(LAS_WARNING, "input files merged on-the-fly. ignoring '-cores %d' ...", lastool.cores);
     } else {
-      las2txt_multi_core(argc, argv, &lasreadopener, &laswriteopener, lastool.cores, lastool.cpu64);
+      lastool.multi_core(&lasreadopener, &laswriteopener);
     }
   }
-  if (lastool.cpu64) {
-    las2txt_multi_core(argc, argv, &lasreadopener, &laswriteopener, 1, TRUE);
-  }
 #endif
 
   // check input
@@ -1195,199 +1126,202 @@ int main(int argc, char* argv[]) {
       }
     }
 
+    // the precision of the coordinates is resolved once and not for every point
+    I32 x_decimals = lidarprecision2decimals(lasreader->header.x_scale_factor);
+    I32 y_decimals = lidarprecision2decimals(lasreader->header.y_scale_factor);
+    I32 z_decimals = lidarprecision2decimals(lasreader->header.z_scale_factor);
+    if (!formatter.open(file_out)) {
+      laserror("allocating output buffer");
+    }
     while (lasreader->read_point()) {
       i = 0;
       while (true) {
         switch (parse_string[i]) {
           case 'x':  // the x coordinate
-            lidardouble2string(printstring, lasreader->point.get_x(), lasreader->header.x_scale_factor);
-            fprintf(file_out, "%s", printstring);
+            formatter.put_double(lasreader->point.get_x(), x_decimals);
             break;
           case 'y':  // the y coordinate
-            lidardouble2string(printstring, lasreader->point.get_y(), lasreader->header.y_scale_factor);
-            fprintf(file_out, "%s", printstring);
+            formatter.put_double(lasreader->point.get_y(), y_decimals);
             break;
           case 'z':  // the z coordinate
-            lidardouble2string(printstring, lasreader->point.get_z(), lasreader->header.z_scale_factor);
-            fprintf(file_out, "%s", printstring);
+            formatter.put_double(lasreader->point.get_z(), z_decimals);
             break;
           case 'X':  // the unscaled raw integer X coordinate
-            fprintf(file_out, "%d", lasreader->point.get_X());
+            formatter.put_int(lasreader->point.get_X());
             break;
           case 'Y':  // the unscaled raw integer Y coordinate
-            fprintf(file_out, "%d", lasreader->point.get_Y());
+            formatter.put_int(lasreader->point.get_Y());
             break;
           case 'Z':  // the unscaled raw integer Z coordinate
-            fprintf(file_out, "%d", lasreader->point.get_Z());
+            formatter.put_int(lasreader->point.get_Z());
             break;
           case 't':  // the gps-time
-            fprintf(file_out, "%.6f", lasreader->point.get_gps_time());
+            formatter.put_double(lasreader->point.get_gps_time(), 6);
             break;
           case 'i':  // the intensity
             if (opts)
-              fprintf(file_out, "%d", -2048 + lasreader->point.get_intensity());
+              formatter.put_int(-2048 + lasreader->point.get_intensity());
             else if (optx) {
               int len;
               len = sprintf(printstring, "%.3f", 1.0f / 4095.0f * lasreader->point.get_intensity()) - 1;
               while (printstring[len] == '0') len--;
               if (printstring[len] != '.') len++;
               printstring[len] = '\0';
-              fprintf(file_out, "%s", printstring);
+              formatter.put(printstring);
             } else
-              fprintf(file_out, "%d", lasreader->point.get_intensity());
+              formatter.put_int(lasreader->point.get_intensity());
             break;
           case 'a':  // the scan angle
-            fprintf(file_out, "%g", lasreader->point.get_scan_angle());
+            formatter.put_g(lasreader->point.get_scan_angle());
             break;
           case 'r':  // the number of the return
             if (header->point_data_format > 5) {
-              fprintf(file_out, "%d", lasreader->point.get_extended_return_number());
+              formatter.put_int(lasreader->point.get_extended_return_number());
             } else {
-              fprintf(file_out, "%d", lasreader->point.get_return_number());
+              formatter.put_int(lasreader->point.get_return_number());
             }
             break;
           case 'c':  // the classification
             if (header->point_data_format > 5) {
               if (lasreader->point.get_extended_classification()) {
-                fprintf(file_out, "%d", lasreader->point.get_extended_classification());
+                formatter.put_int(lasreader->point.get_extended_classification());
               } else {
-                fprintf(file_out, "%d", lasreader->point.get_classification());
+                formatter.put_int(lasreader->point.get_classification());
               }
             } else {
-              fprintf(file_out, "%d", lasreader->point.get_classification());
+              formatter.put_int(lasreader->point.get_classification());
             }
             break;
           case 'u':  // the user data
-            fprintf(file_out, "%d", lasreader->point.get_user_data());
+            formatter.put_int(lasreader->point.get_user_data());
             break;
           case 'n':  // the number of returns of given pulse
             if (header->point_data_format > 5) {
-              fprintf(file_out, "%d", lasreader->point.get_extended_number_of_returns());
+              formatter.put_int(lasreader->point.get_extended_number_of_returns());
             } else {
-              fprintf(file_out, "%d", lasreader->point.get_number_of_returns());
+              formatter.put_int(lasreader->point.get_number_of_returns());
             }
             break;
           case 'p':  // the point source ID
-            fprintf(file_out, "%d", lasreader->point.get_point_source_ID());
+            formatter.put_int(lasreader->point.get_point_source_ID());
             break;
           case 'e':  // the edge of flight line flag
-            fprintf(file_out, "%d", lasreader->point.get_edge_of_flight_line());
+            formatter.put_int(lasreader->point.get_edge_of_flight_line());
             break;
           case 'd':  // the direction of scan flag
-            fprintf(file_out, "%d", lasreader->point.get_scan_direction_flag());
+            formatter.put_int(lasreader->point.get_scan_direction_flag());
             break;
           case 'h':  // the withheld flag
-            fprintf(file_out, "%d", lasreader->point.get_withheld_flag());
+            formatter.put_int(lasreader->point.get_withheld_flag());
             break;
           case 'k':  // the keypoint flag
-            fprintf(file_out, "%d", lasreader->point.get_keypoint_flag());
+            formatter.put_int(lasreader->point.get_keypoint_flag());
             break;
           case 'g':  // the synthetic flag
-            fprintf(file_out, "%d", lasreader->point.get_synthetic_flag());
+            formatter.put_int(lasreader->point.get_synthetic_flag());
             break;
           case 'o':  // the (extended) overlap flag
-            fprintf(file_out, "%d", lasreader->point.get_extended_overlap_flag());
+            formatter.put_int(lasreader->point.get_extended_overlap_flag());
             break;
           case 'l':  // the (extended) scanner channel
-            fprintf(file_out, "%d", lasreader->point.get_extended_scanner_channel());
+            formatter.put_int(lasreader->point.get_extended_scanner_channel());
             break;
           case 'R':  // the red channel of the RGB field
-            fprintf(file_out, "%d", lasreader->point.rgb[0]);
+            formatter.put_int(lasreader->point.rgb[0]);
             break;
           case 'G':  // the green channel of the RGB field
-            fprintf(file_out, "%d", lasreader->point.rgb[1]);
+            formatter.put_int(lasreader->point.rgb[1]);
             break;
           case 'B':  // the blue channel of the RGB field
-            fprintf(file_out, "%d", lasreader->point.rgb[2]);
+            formatter.put_int(lasreader->point.rgb[2]);
             break;
           case 'I':  // the near-infrared channel of the RGBI field
-            fprintf(file_out, "%d", lasreader->point.rgb[3]);
+            formatter.put_int(lasreader->point.rgb[3]);
             break;
           case 'm':  // the index of the point (count starts at 0)
-            fprintf(file_out, "%lld", lasreader->p_idx - 1);
+            formatter.put_int(lasreader->p_idx - 1);
             break;
           case 'M':  // the index of the point  (count starts at 1)
-            fprintf(file_out, "%lld", lasreader->p_idx);
+            formatter.put_int(lasreader->p_idx);
             break;
           case '_':  // the raw integer X difference to the last point
-            fprintf(file_out, "%d", lasreader->point.get_X() - last_XYZ[0]);
+            formatter.put_int(lasreader->point.get_X() - last_XYZ[0]);
             break;
           case '!':  // the raw integer Y difference to the last point
-            fprintf(file_out, "%d", lasreader->point.get_Y() - last_XYZ[1]);
+            formatter.put_int(lasreader->point.get_Y() - last_XYZ[1]);
             break;
           case '@':  // the raw integer Z difference to the last point
-            fprintf(file_out, "%d", lasreader->point.get_Z() - last_XYZ[2]);
+            formatter.put_int(lasreader->point.get_Z() - last_XYZ[2]);
             break;
           case '#':  // the gps-time difference to the last point
-            lidardouble2string(printstring, lasreader->point.gps_time - last_GPSTIME);
-            fprintf(file_out, "%s", printstring);
+            formatter.put_double(lasreader->point.gps_time - last_GPSTIME, -1);
             break;
           case '$':  // the R difference to the last point
-            fprintf(file_out, "%d", lasreader->point.rgb[0] - last_RGB[0]);
+            formatter.put_int(lasreader->point.rgb[0] - last_RGB[0]);
             break;
           case '%':  // the G difference to the last point
-            fprintf(file_out, "%d", lasreader->point.rgb[1] - last_RGB[1]);
+            formatter.put_int(lasreader->point.rgb[1] - last_RGB[1]);
             break;
           case '^':  // the B difference to the last point
-            fprintf(file_out, "%d", lasreader->point.rgb[2] - last_RGB[2]);
+            formatter.put_int(lasreader->point.rgb[2] - last_RGB[2]);
             break;
           case '&':  // the byte-wise R difference to the last point
-            fprintf(
-                file_out, "%d%c%d", (lasreader->point.rgb[0] >> 8) - (last_RGB[0] >> 8), separator_sign,
+            formatter.printf(
+                "%d%c%d", (lasreader->point.rgb[0] >> 8) - (last_RGB[0] >> 8), separator_sign,
                 (lasreader->point.rgb[0] & 255) - (last_RGB[0] & 255));
             break;
           case '*':  // the byte-wise G difference to the last point
-            fprintf(
-                file_out, "%d%c%d", (lasreader->point.rgb[1] >> 8) - (last_RGB[1] >> 8), separator_sign,
+            formatter.printf(
+                "%d%c%d", (lasreader->point.rgb[1] >> 8) - (last_RGB[1] >> 8), separator_sign,
                 (lasreader->point.rgb[1] & 255) - (last_RGB[1] & 255));
             break;
           case '+':  // the byte-wise B difference to the last point
-            fprintf(
-                file_out, "%d%c%d", (lasreader->point.rgb[2] >> 8) - (last_RGB[2] >> 8), separator_sign,
+            formatter.printf(
+                "%d%c%d", (lasreader->point.rgb[2] >> 8) - (last_RGB[2] >> 8), separator_sign,
                 (lasreader->point.rgb[2] & 255) - (last_RGB[2] & 255));
             break;
           case 'w':  // the wavepacket index
-            fprintf(file_out, "%d", lasreader->point.wavepacket.getIndex());
+            formatter.put_int(lasreader->point.wavepacket.getIndex());
             break;
           case 'W':  // all wavepacket attributes
-            fprintf(
-                file_out, "%d%c%d%c%d%c%g%c%g%c%g%c%g", lasreader->point.wavepacket.getIndex(), separator_sign,
+            formatter.printf(
+                "%d%c%d%c%d%c%g%c%g%c%g%c%g", lasreader->point.wavepacket.getIndex(), separator_sign,
                 (U32)lasreader->point.wavepacket.getOffset(), separator_sign, lasreader->point.wavepacket.getSize(), separator_sign,
                 lasreader->point.wavepacket.getLocation(), separator_sign, lasreader->point.wavepacket.getXt(), separator_sign,
                 lasreader->point.wavepacket.getYt(), separator_sign, lasreader->point.wavepacket.getZt());
             break;
           case 'V':  // the waVeform
             if (laswaveform13reader && laswaveform13reader->read_waveform(&lasreader->point)) {
-              output_waveform(file_out, separator_sign, laswaveform13reader);
+              output_waveform(&formatter, separator_sign, laswaveform13reader);
             } else {
-              fprintf(file_out, "no_waveform");
+              formatter.put("no_waveform");
             }
             break;
           case 'E':  // the extra string
-            fprintf(file_out, "%s", extra_string);
+            formatter.put(extra_string);
             break;
           case HSV255: {  // the HSV representation of RGB
             F32 hsv[3];
             lasreader->point.get_hsv(hsv);
-            fprintf(file_out, "%d%c%d%c%d", (U16)(hsv[0] * 360), separator_sign, (U8)(hsv[1] * 100), separator_sign, (U8)(hsv[2] * 100));
+            formatter.printf("%d%c%d%c%d", (U16)(hsv[0] * 360), separator_sign, (U8)(hsv[1] * 100), separator_sign, (U8)(hsv[2] * 100));
             break;
           }
           case HSV: {  // the HSV representation of RGB
             F32 hsv[3];
             lasreader->point.get_hsv(hsv);
-            fprintf(file_out, "%.3f%c%.3f%c%.3f", hsv[0], separator_sign, hsv[1], separator_sign, hsv[2]);
+            formatter.printf("%.3f%c%.3f%c%.3f", hsv[0], separator_sign, hsv[1], separator_sign, hsv[2]);
             break;
           }
           case HSL255: {  // the HSL representation of RGB
             F32 hsl[3];
             lasreader->point.get_hsl(hsl);
-            fprintf(file_out, "%d%c%d%c%d", (U16)(hsl[0] * 360), separator_sign, (U8)(hsl[1] * 100), separator_sign, (U8)(hsl[2] * 100));
+            formatter.printf("%d%c%d%c%d", (U16)(hsl[0] * 360), separator_sign, (U8)(hsl[1] * 100), separator_sign, (U8)(hsl[2] * 100));
             break;
           }
           case HSL: {  // the HSL representation of RGB
             F32 hsl[3];
             lasreader->point.get_hsl(hsl);
-            fprintf(file_out, "%.3f%c%.3f%c%.3f", hsl[0], separator_sign, hsl[1], separator_sign, hsl[2]);
+            formatter.printf("%.3f%c%.3f%c%.3f", hsl[0], separator_sign, hsl[1], separator_sign, hsl[2]);
             break;
           }
           case '0':  // the extra attributes
@@ -1400,7 +1334,7 @@ int main(int argc, char* argv[]) {
           case '7':  // the extra attributes
           case '8':  // the extra attributes
           case '9':  // the extra attributes
-            print_attribute(file_out, &lasreader->header, &lasreader->point, (I32)(parse_string[i] - '0'), printstring);
+            print_attribute(&formatter, &lasreader->header, &lasreader->point, (I32)(parse_string[i] - '0'));
             break;
           default:
             index = 0;
@@ -1409,13 +1343,13 @@ int main(int argc, char* argv[]) {
               index = 10 * index + (parse_string[i] - '0');
               i++;
             }
-            print_attribute(file_out, &lasreader->header, &lasreader->point, index, printstring);
+            print_attribute(&formatter, &lasreader->header, &lasreader->point, index);
         }
         i++;
         if (parse_string[i]) {
-          fprintf(file_out, "%c", separator_sign);
+          formatter.put(separator_sign);
         } else {
-          fprintf(file_out, "\012");
+          formatter.put('\012');
           break;
         }
       }
@@ -1429,6 +1363,7 @@ int main(int argc, char* argv[]) {
         last_RGB[2] = lasreader->point.rgb[2];
       }
     }
+    formatter.close();
     LASMessage(
         LAS_VERBOSE, "converting %lld points of '%s' took %g sec.", lasreader->p_cnt, lasreadopener.get_file_name(), taketime() - start_time);
     // close the reader
@@ -49,6 +49,7 @@
 
  CHANGE HISTORY:
 
+ 18 October 2026 -- '-threads 8' sorts and compresses finalized octants on 8 threads
  24 May 2023 -- created after planting vegetable in the garden
 
  ===============================================================================
@@ -58,10 +59,13 @@
 #include <errno.h>
 #include <stdlib.h>
 #include <time.h>
+#include <atomic>
 #include <cmath>
 #include <memory>
 #include <stdexcept>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "lasreadpoint.hpp"
 #include "lasreader.hpp"
@@ -99,6 +103,7 @@ public:
     fprintf(stderr, "lascopcindex -merged -i *.las -o out.copc.laz -root_light\n");
     fprintf(stderr, "lascopcindex tls.laz -tls\n");
     fprintf(stderr, "lascopcindex -merged -i *.las -o out.copc.laz -ondisk -verbose\n");
+    fprintf(stderr, "lascopcindex -merged -i *.las -o out.copc.laz -threads 8\n");
     fprintf(stderr, "lascopcindex -h\n");
   };
 };
@@ -256,9 +261,9 @@ struct Octant
   };
   ~Octant() {};
 
+  // The points must have been load()ed
   void sort()
   {
-    load();
     qsort((void*)point_buffer, point_count, point_size, compare_buffers);
   };
   I32 npoints() const { return point_count; };
@@ -573,6 +578,21 @@ I32 OctantOnDisk::num_connexions = 0;
 
 typedef std::unordered_map<EPTkey, std::unique_ptr<Octant>, EPTKeyHasher> Registry;
 
+// Sorts the octants [first, last) with num_threads threads. Each thread picks the next unsorted octant.
+static void sort_octants(std::vector<std::unique_ptr<Octant>>& octants, const size_t first, const size_t last, const U32 num_threads)
+{
+  std::atomic<size_t> next(first);
+  auto sort_next = [&]() {
+    size_t k;
+    while ((k = next++) < last) octants[k]->sort();
+  };
+
+  std::vector<std::thread> workers;
+  for (U32 t = 1; t < num_threads && t < last - first; t++) workers.push_back(std::thread(sort_next));
+  sort_next();
+  for (auto& worker : workers) worker.join();
+}
+
 int main(int argc, char* argv[])
 {
   LasTool_lascopcindex lastool;
@@ -590,6 +610,7 @@ int main(int argc, char* argv[])
   BOOL unordered = FALSE;
   BOOL units = FALSE;
   U32  root_grid_size = 256;
+  U32  num_threads = 1;
 
   // Internal variables
   I32 i = 0;
@@ -743,6 +764,18 @@ int main(int argc, char* argv[])
       max_files_opened = (I32)(0.5 * MAX_FOPEN);
       i += 1;
     }
+    else if (strcmp(argv[i], "-threads") == 0)
+    {
+      if ((i + 1) >= argc)
+      {
+        laserror("'%s' needs 1 argument: number", argv[i]);
+      }
+      if (sscanf_las(argv[i + 1], "%u", &num_threads) != 1 || num_threads == 0)
+      {
+        laserror("cannot understand argument '%s' for '%s'", argv[i + 1], argv[i]);
+      }
+      i += 1;
+    }
     else if (strcmp(argv[i], "-seed") == 0)
     {
       if ((i + 1) >= argc)
@@ -779,6 +812,9 @@ int main(int argc, char* argv[])
 
   lastool.parse(arg_local);
 
+  // The finalized octants are compressed by the writer. Use the same number of threads unless '-othreads' was given.
+  if (num_threads > 1 && laswriteopener.get_compress_threads() <= 1) laswriteopener.set_compress_threads(num_threads);
+
   // if (verbose) progress = FALSE; -- why?
 
   /*#ifdef COMPILE_WITH_GUI
@@ -1141,6 +1177,9 @@ int main(int argc, char* argv[])
         laserror("could not open laswriter");
       }
 
+      // The first LAZ chunk starts here. The hierarchy needs the offsets of all chunks.
+      I64 chunk_offset = laswriter->tell();
+
       // =============================================================================================
       // PASS 2: This pass reads the points in a buffer of size n = num_points_buffer and shuffles the buffer.
       // Then it builds the octree and writes LAZ chunks as soon as a region of the finalizer is finalized
@@ -1164,6 +1203,10 @@ int main(int argc, char* argv[])
       // EPT hierarchy
       std::vector<LASvlr_copc_entry> entries;
 
+      // Octants that are finalized and can be sorted and written
+      std::vector<std::unique_ptr<Octant>> finalized;
+      std::vector<EPTkey> finalized_keys;
+
       // For -unordered optimization
       EPTkey current_unordered_key = unordered_keys[0];
       bool skip = false;
@@ -1355,40 +1398,60 @@ int main(int argc, char* argv[])
                   if (moved) continue;
                 }
 
-                // The octant is finalized: we can write the chunk and free up the memory
+                // The octant is finalized: it is written with all the other octants finalized now
                 LASvlr_copc_entry entry;
                 entry.key.depth = it->first.d;
                 entry.key.x = it->first.x;
                 entry.key.y = it->first.y;
                 entry.key.z = it->first.z;
                 entry.point_count = it->second->npoints();
-                entry.offset = laswriter->tell();
+                entry.offset = 0;    // resolved once all chunks are written
+                entry.byte_size = 0; // resolved once all chunks are written
+                entries.push_back(entry);
+
+                finalized_keys.push_back(it->first);
+                finalized.push_back(std::move(it->second));
+                it = registry.erase(it);
+              }
+
+              // Write the chunks and free up the memory. The octants are sorted in groups on all threads while the
+              // writer compresses the previous chunks. Groups also keep few '-ondisk' octants in memory at once.
+              for (size_t first = 0; first < finalized.size(); first += 2 * num_threads)
+              {
+                size_t last = MIN2(first + 2 * num_threads, finalized.size());
+
+                // Loading from disk is not thread safe
+                for (size_t k = first; k < last; k++) finalized[k]->load();
 
                 // The points *MUST* be sorted (to optimize compression)
-                if (sort) it->second->sort();
+                if (sort) sort_octants(finalized, first, last, num_threads);
 
-                // Write the chunk
-                for (I32 k = 0; k < it->second->npoints(); k++)
+                for (size_t k = first; k < last; k++)
                 {
-                  laspoint->copy_from(it->second->point_buffer + k * elem_size);
-                  laswriter->write_point(laspoint);
-                  laswriter->update_inventory(laspoint);
+                  const EPTkey& finalized_key = finalized_keys[k];
+                  Octant* octant = finalized[k].get();
 
-                  progressbar++;
-                  progressbar.print();
-                }
-                laswriter->chunk();
+                  // Write the chunk
+                  for (I32 j = 0; j < octant->npoints(); j++)
+                  {
+                    laspoint->copy_from(octant->point_buffer + j * elem_size);
+                    laswriter->write_point(laspoint);
+                    laswriter->update_inventory(laspoint);
 
-                LASMessage(LAS_VERY_VERBOSE, "[%.0lf%%] Octant %d-%d-%d-%d written in COPC file", progressbar.get_progress(), it->first.d, it->first.x, it->first.y, it->first.z);
+                    progressbar++;
+                    progressbar.print();
+                  }
+                  laswriter->chunk();
 
-                // Record the VLR entry
-                entry.byte_size = (I32)(laswriter->tell() - entry.offset);
-                entries.push_back(entry);
+                  LASMessage(LAS_VERY_VERBOSE, "[%.0lf%%] Octant %d-%d-%d-%d written in COPC file", progressbar.get_progress(), finalized_key.d, finalized_key.x, finalized_key.y, finalized_key.z);
 
-                // We will never see this octant again. Goodbye.
-                it->second->clean();
-                it = registry.erase(it);
+                  // We will never see this octant again. Goodbye.
+                  octant->clean();
+                  finalized[k].reset();
+                }
               }
+              finalized.clear();
+              finalized_keys.clear();
             }
 
             progressbar++;
@@ -1422,6 +1485,25 @@ int main(int argc, char* argv[])
 
       progressbar.done();
 
+      // Resolve where the chunks are in the file. The writer might still have been compressing
+      // some of them on other threads, so this is only known once all chunks were written.
+      U32 number_chunks = 0;
+      const U32* chunk_bytes = 0;
+      if (!laswriter->get_chunk_table(&number_chunks, &chunk_bytes))
+      {
+        throw std::runtime_error("cannot access the LAZ chunk table. Please report.");
+      }
+      U32 chunk = 0;
+      for (auto& entry : entries)
+      {
+        if (entry.point_count == 0) continue;
+        if (chunk == number_chunks) throw std::runtime_error("more octants than LAZ chunks. Please report.");
+        entry.offset = chunk_offset;
+        entry.byte_size = (I32)chunk_bytes[chunk];
+        chunk_offset += chunk_bytes[chunk];
+        chunk++;
+      }
+
       // Construct the EPT hierarchy eVLR
       LASvlr_copc_entry* hierarchy = new LASvlr_copc_entry[entries.size()];
       std::copy(entries.begin(), entries.end(), hierarchy);
@@ -26,6 +26,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- '-threads 8' compares large LAS/LAZ files in chunk-aligned segments on 8 threads
     4 November 2019 -- new option '-idir' takes two input directories and compares
     7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
     13 July 2017 -- added missing checks for LAS 1.4 EVLR size and payloads
@@ -42,12 +43,18 @@
 */
 
 #include "lasreader.hpp"
+#include "lasreader_las.hpp"
+#include "bytestreamin.hpp"
 #include "laswriter.hpp"
 
 #include <time.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <atomic>
+#include <thread>
+#include <typeinfo>
+#include <vector>
 #include "lastool.hpp"
 
 class LasTool_lasdiff : public LasTool
@@ -63,6 +70,7 @@ public:
     fprintf(stderr, "lasdiff lidar1.txt lidar2.txt -iparse xyzti\n");
     fprintf(stderr, "lasdiff lidar1.las lidar1.laz\n");
     fprintf(stderr, "lasdiff lidar1.las lidar1.laz -random_seeks\n");
+    fprintf(stderr, "lasdiff lidar1.laz lidar2.laz -threads 8\n");
     fprintf(stderr, "lasdiff -i lidar1.las -i lidar2.las -o diff.las\n");
     fprintf(stderr, "lasdiff -wildcards folder1 folder2\n");
     fprintf(stderr, "lasdiff -h\n");
@@ -444,344 +452,537 @@ static int check_header(LASreader* lasreader1, LASreader* lasreader2)
 static int shutup = 5;
 static int different_scaled_offset_coordinates;
 
-static int check_points(const CHAR* file_name1, LASreader* lasreader1, const CHAR* file_name2, LASreader* lasreader2, LASwriter* laswriter, I32 random_seeks)
-{
-  int seeking = random_seeks;
+// compares the current points of both readers and returns whether they differ. the
+// differences are reported unless 'quiet' is set or 'shutup' points were already
+// different. coordinates that differ only after scaling and offsetting are counted
+// (and reported for the first 9) but do not make the points different.
 
-  int different_points = 0;
+static bool check_point(const LASreader* lasreader1, const LASreader* lasreader2, bool quiet, int different_points, int* different_scaled_offset_coordinates, double* max_diff)
+{
+  bool verbose = (!quiet && (different_points < shutup));
+  bool difference = false;
   double diff;
-  double max_diff_x = 0.0;
-  double max_diff_y = 0.0;
-  double max_diff_z = 0.0;
-
-  different_scaled_offset_coordinates = 0;
 
-  while (true)
+  if (memcmp((const void*)&(lasreader1->point), (const void*)&(lasreader2->point), 20))
   {
-    bool difference = false;
-    if (seeking)
+    if (scaled_offset_difference)
     {
-      if (lasreader1->p_idx%100000 == 25000)
+      if (lasreader1->get_x() != lasreader2->get_x())
       {
-        I64 s = (rand()*rand())%lasreader1->npoints;
-        fprintf(stderr, "at p_idx %u seeking to %u\n", (U32)lasreader1->p_idx, (U32)s);
-        lasreader1->seek(s);
-        lasreader2->seek(s);
-        seeking--;
+        diff = lasreader1->get_x() - lasreader2->get_x();
+        if (diff < 0) diff = -diff;
+        if (diff > max_diff[0]) max_diff[0] = diff;
+        if (!quiet && (*different_scaled_offset_coordinates < 9)) fprintf(stderr, "  x: %d %d scaled offset x %g %g\n", lasreader1->point.get_X(), lasreader2->point.get_X(), lasreader1->get_x(), lasreader2->get_x());
+        (*different_scaled_offset_coordinates)++;
       }
-    }
-    if (lasreader1->read_point())
-    {
-      if (lasreader2->read_point())
+      if (lasreader1->get_y() != lasreader2->get_y())
+      {
+        diff = lasreader1->get_y() - lasreader2->get_y();
+        if (diff < 0) diff = -diff;
+        if (diff > max_diff[1]) max_diff[1] = diff;
+        if (!quiet && (*different_scaled_offset_coordinates < 9)) fprintf(stderr, "  y: %d %d scaled offset y %g %g\n", lasreader1->point.get_Y(), lasreader2->point.get_Y(), lasreader1->get_y(), lasreader2->get_y());
+        (*different_scaled_offset_coordinates)++;
+      }
+      if (lasreader1->get_z() != lasreader2->get_z())
       {
-        if (memcmp((const void*)&(lasreader1->point), (const void*)&(lasreader2->point), 20))
+        diff = lasreader1->get_z() - lasreader2->get_z();
+        if (diff < 0) diff = -diff;
+        if (diff > max_diff[2])
         {
-          if (scaled_offset_difference)
+          max_diff[2] = diff;
+          if (max_diff[2] > 0.001)
           {
-            if (lasreader1->get_x() != lasreader2->get_x())
-            {
-              diff = lasreader1->get_x() - lasreader2->get_x();
-              if (diff < 0) diff = -diff;
-              if (diff > max_diff_x) max_diff_x = diff;
-              if (different_scaled_offset_coordinates < 9) fprintf(stderr, "  x: %d %d scaled offset x %g %g\n", lasreader1->point.get_X(), lasreader2->point.get_X(), lasreader1->get_x(), lasreader2->get_x());
-              different_scaled_offset_coordinates++;
-            }
-            if (lasreader1->get_y() != lasreader2->get_y())
-            {
-              diff = lasreader1->get_y() - lasreader2->get_y();
-              if (diff < 0) diff = -diff;
-              if (diff > max_diff_y) max_diff_y = diff;
-              if (different_scaled_offset_coordinates < 9) fprintf(stderr, "  y: %d %d scaled offset y %g %g\n", lasreader1->point.get_Y(), lasreader2->point.get_Y(), lasreader1->get_y(), lasreader2->get_y());
-              different_scaled_offset_coordinates++;
-            }
-            if (lasreader1->get_z() != lasreader2->get_z())
-            {
-              diff = lasreader1->get_z() - lasreader2->get_z();
-              if (diff < 0) diff = -diff;
-              if (diff > max_diff_z)
-              {
-                max_diff_z = diff;
-                if (max_diff_z > 0.001)
-                {
-                  max_diff_z = diff;
-                }
-              }
-              if (different_scaled_offset_coordinates < 9) fprintf(stderr, "  z: %d %d scaled offset z %g %g\n", lasreader1->point.get_Z(), lasreader2->point.get_Z(), lasreader1->get_z(), lasreader2->get_z());
-              different_scaled_offset_coordinates++;
-            }
+            max_diff[2] = diff;
           }
-          else
-          {
-            if (lasreader1->point.get_X() != lasreader2->point.get_X())
-            {
-              if (different_points < shutup) fprintf(stderr, "  x: %d %d\n", lasreader1->point.get_X(), lasreader2->point.get_X());
-              difference = true;
-            }
-            if (lasreader1->point.get_Y() != lasreader2->point.get_Y())
-            {
-              if (different_points < shutup) fprintf(stderr, "  y: %d %d\n", lasreader1->point.get_Y(), lasreader2->point.get_Y());
-              difference = true;
-            }
-            if (lasreader1->point.get_Z() != lasreader2->point.get_Z())
-            {
-              if (different_points < shutup) fprintf(stderr, "  z: %d %d\n", lasreader1->point.get_Z(), lasreader2->point.get_Z());
-              difference = true;
-            }
-          }
-          if (lasreader1->point.intensity != lasreader2->point.intensity)
-          {
-            if (different_points < shutup) fprintf(stderr, "  intensity: %d %d\n", lasreader1->point.intensity, lasreader2->point.intensity);
-            difference = true;
-          }
-          if (lasreader1->point.return_number != lasreader2->point.return_number)
-          {
-            if (different_points < shutup) fprintf(stderr, "  return_number: %d %d\n", lasreader1->point.return_number, lasreader2->point.return_number);
-            difference = true;
-          }
-          if (lasreader1->point.number_of_returns != lasreader2->point.number_of_returns)
-          {
-            if (different_points < shutup) fprintf(stderr, "  number_of_returns: %d %d\n", lasreader1->point.number_of_returns, lasreader2->point.number_of_returns);
-            difference = true;
-          }
-          if (lasreader1->point.scan_direction_flag != lasreader2->point.scan_direction_flag)
-          {
-            if (different_points < shutup) fprintf(stderr, "  scan_direction_flag: %d %d\n", lasreader1->point.scan_direction_flag, lasreader2->point.scan_direction_flag);
-            difference = true;
-          }
-          if (lasreader1->point.edge_of_flight_line != lasreader2->point.edge_of_flight_line)
-          {
-            if (different_points < shutup) fprintf(stderr, "  edge_of_flight_line: %d %d\n", lasreader1->point.edge_of_flight_line, lasreader2->point.edge_of_flight_line);
-            difference = true;
-          }
-          if (lasreader1->point.get_classification() != lasreader2->point.get_classification())
-          {
-            if (different_points < shutup) fprintf(stderr, "  classification: %d %d\n", lasreader1->point.get_classification(), lasreader2->point.get_classification());
-            difference = true;
-          }
-          if (lasreader1->point.get_synthetic_flag() != lasreader2->point.get_synthetic_flag())
-          {
-            if (different_points < shutup) fprintf(stderr, "  synthetic_flag: %d %d\n", lasreader1->point.get_synthetic_flag(), lasreader2->point.get_synthetic_flag());
-            difference = true;
-          }
-          if (lasreader1->point.get_keypoint_flag() != lasreader2->point.get_keypoint_flag())
-          {
-            if (different_points < shutup) fprintf(stderr, "  keypoint_flag: %d %d\n", lasreader1->point.get_keypoint_flag(), lasreader2->point.get_keypoint_flag());
-            difference = true;
-          }
-          if (lasreader1->point.get_withheld_flag() != lasreader2->point.get_withheld_flag())
-          {
-            if (different_points < shutup) fprintf(stderr, "  withheld_flag: %d %d\n", lasreader1->point.get_withheld_flag(), lasreader2->point.get_withheld_flag());
-            difference = true;
-          }
-          if (lasreader1->point.scan_angle_rank != lasreader2->point.scan_angle_rank)
-          {
-            if (different_points < shutup) fprintf(stderr, "  scan_angle_rank: %d %d\n", lasreader1->point.scan_angle_rank, lasreader2->point.scan_angle_rank);
-            difference = true;
-          }
-          if (lasreader1->point.user_data != lasreader2->point.user_data)
-          {
-            if (different_points < shutup) fprintf(stderr, "  user_data: %d %d\n", lasreader1->point.user_data, lasreader2->point.user_data);
-            difference = true;
-          }
-          if (lasreader1->point.point_source_ID != lasreader2->point.point_source_ID)
-          {
-            if (different_points < shutup) fprintf(stderr, "  point_source_ID: %d %d\n", lasreader1->point.point_source_ID, lasreader2->point.point_source_ID);
-            difference = true;
-          }
-          if (difference) if (different_points < shutup) fprintf(stderr, "point %u of %u is different\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints);
         }
-        if (lasreader1->point.have_gps_time || lasreader2->point.have_gps_time)
+        if (!quiet && (*different_scaled_offset_coordinates < 9)) fprintf(stderr, "  z: %d %d scaled offset z %g %g\n", lasreader1->point.get_Z(), lasreader2->point.get_Z(), lasreader1->get_z(), lasreader2->get_z());
+        (*different_scaled_offset_coordinates)++;
+      }
+    }
+    else
+    {
+      if (lasreader1->point.get_X() != lasreader2->point.get_X())
+      {
+        if (verbose) fprintf(stderr, "  x: %d %d\n", lasreader1->point.get_X(), lasreader2->point.get_X());
+        difference = true;
+      }
+      if (lasreader1->point.get_Y() != lasreader2->point.get_Y())
+      {
+        if (verbose) fprintf(stderr, "  y: %d %d\n", lasreader1->point.get_Y(), lasreader2->point.get_Y());
+        difference = true;
+      }
+      if (lasreader1->point.get_Z() != lasreader2->point.get_Z())
+      {
+        if (verbose) fprintf(stderr, "  z: %d %d\n", lasreader1->point.get_Z(), lasreader2->point.get_Z());
+        difference = true;
+      }
+    }
+    if (lasreader1->point.intensity != lasreader2->point.intensity)
+    {
+      if (verbose) fprintf(stderr, "  intensity: %d %d\n", lasreader1->point.intensity, lasreader2->point.intensity);
+      difference = true;
+    }
+    if (lasreader1->point.return_number != lasreader2->point.return_number)
+    {
+      if (verbose) fprintf(stderr, "  return_number: %d %d\n", lasreader1->point.return_number, lasreader2->point.return_number);
+      difference = true;
+    }
+    if (lasreader1->point.number_of_returns != lasreader2->point.number_of_returns)
+    {
+      if (verbose) fprintf(stderr, "  number_of_returns: %d %d\n", lasreader1->point.number_of_returns, lasreader2->point.number_of_returns);
+      difference = true;
+    }
+    if (lasreader1->point.scan_direction_flag != lasreader2->point.scan_direction_flag)
+    {
+      if (verbose) fprintf(stderr, "  scan_direction_flag: %d %d\n", lasreader1->point.scan_direction_flag, lasreader2->point.scan_direction_flag);
+      difference = true;
+    }
+    if (lasreader1->point.edge_of_flight_line != lasreader2->point.edge_of_flight_line)
+    {
+      if (verbose) fprintf(stderr, "  edge_of_flight_line: %d %d\n", lasreader1->point.edge_of_flight_line, lasreader2->point.edge_of_flight_line);
+      difference = true;
+    }
+    if (lasreader1->point.get_classification() != lasreader2->point.get_classification())
+    {
+      if (verbose) fprintf(stderr, "  classification: %d %d\n", lasreader1->point.get_classification(), lasreader2->point.get_classification());
+      difference = true;
+    }
+    if (lasreader1->point.get_synthetic_flag() != lasreader2->point.get_synthetic_flag())
+    {
+      if (verbose) fprintf(stderr, "  synthetic_flag: %d %d\n", lasreader1->point.get_synthetic_flag(), lasreader2->point.get_synthetic_flag());
+      difference = true;
+    }
+    if (lasreader1->point.get_keypoint_flag() != lasreader2->point.get_keypoint_flag())
+    {
+      if (verbose) fprintf(stderr, "  keypoint_flag: %d %d\n", lasreader1->point.get_keypoint_flag(), lasreader2->point.get_keypoint_flag());
+      difference = true;
+    }
+    if (lasreader1->point.get_withheld_flag() != lasreader2->point.get_withheld_flag())
+    {
+      if (verbose) fprintf(stderr, "  withheld_flag: %d %d\n", lasreader1->point.get_withheld_flag(), lasreader2->point.get_withheld_flag());
+      difference = true;
+    }
+    if (lasreader1->point.scan_angle_rank != lasreader2->point.scan_angle_rank)
+    {
+      if (verbose) fprintf(stderr, "  scan_angle_rank: %d %d\n", lasreader1->point.scan_angle_rank, lasreader2->point.scan_angle_rank);
+      difference = true;
+    }
+    if (lasreader1->point.user_data != lasreader2->point.user_data)
+    {
+      if (verbose) fprintf(stderr, "  user_data: %d %d\n", lasreader1->point.user_data, lasreader2->point.user_data);
+      difference = true;
+    }
+    if (lasreader1->point.point_source_ID != lasreader2->point.point_source_ID)
+    {
+      if (verbose) fprintf(stderr, "  point_source_ID: %d %d\n", lasreader1->point.point_source_ID, lasreader2->point.point_source_ID);
+      difference = true;
+    }
+    if (difference) if (verbose) fprintf(stderr, "point %u of %u is different\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints);
+  }
+  if (lasreader1->point.have_gps_time || lasreader2->point.have_gps_time)
+  {
+    if (lasreader1->point.gps_time != lasreader2->point.gps_time)
+    {
+      if (verbose) fprintf(stderr, "gps time of point %u of %u is different: %f != %f\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.gps_time, lasreader2->point.gps_time);
+      difference = true;
+    }
+  }
+  if (lasreader1->point.have_rgb || lasreader2->point.have_rgb)
+  {
+    if (lasreader1->point.have_nir || lasreader2->point.have_nir)
+    {
+      if (memcmp((const void*)&(lasreader1->point.rgb), (const void*)&(lasreader2->point.rgb), sizeof(short[4])))
+      {
+        if (verbose) fprintf(stderr, "RGBI of point %u of %u is different: (%d %d %d %d) != (%d %d %d %d)\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.rgb[0], lasreader1->point.rgb[1], lasreader1->point.rgb[2], lasreader1->point.rgb[3], lasreader2->point.rgb[0], lasreader2->point.rgb[1], lasreader2->point.rgb[2], lasreader2->point.rgb[3]);
+        difference = true;
+      }
+    }
+    else
+    {
+      if (memcmp((const void*)&(lasreader1->point.rgb), (const void*)&(lasreader2->point.rgb), sizeof(short[3])))
+      {
+        if (verbose) fprintf(stderr, "RGB of point %u of %u is different: (%d %d %d) != (%d %d %d)\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.rgb[0], lasreader1->point.rgb[1], lasreader1->point.rgb[2], lasreader2->point.rgb[0], lasreader2->point.rgb[1], lasreader2->point.rgb[2]);
+        difference = true;
+      }
+    }
+  }
+  if (lasreader1->point.have_wavepacket || lasreader2->point.have_wavepacket)
+  {
+    if (memcmp((const void*)&(lasreader1->point.wavepacket), (const void*)&(lasreader2->point.wavepacket), sizeof(LASwavepacket)))
+    {
+      if (verbose) fprintf(stderr, "wavepacket of point %u of %u is different: (%d %d %d %g %g %g %g) != (%d %d %d %g %g %g %g)\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.wavepacket.getIndex(), (I32)lasreader1->point.wavepacket.getOffset(), lasreader1->point.wavepacket.getSize(), lasreader1->point.wavepacket.getLocation(), lasreader1->point.wavepacket.getXt(), lasreader1->point.wavepacket.getYt(), lasreader1->point.wavepacket.getZt(), lasreader2->point.wavepacket.getIndex(), (I32)lasreader2->point.wavepacket.getOffset(), lasreader2->point.wavepacket.getSize(), lasreader2->point.wavepacket.getLocation(), lasreader2->point.wavepacket.getXt(), lasreader2->point.wavepacket.getYt(), lasreader2->point.wavepacket.getZt());
+      difference = true;
+    }
+  }
+  if (lasreader1->point.extra_bytes_number)
+  {
+    if (memcmp((const void*)lasreader1->point.extra_bytes, (const void*)lasreader2->point.extra_bytes, lasreader1->point.extra_bytes_number))
+    {
+      if (verbose)
+      {
+        if (lasreader1->point.extra_bytes_number == 1)
+        {
+          fprintf(stderr, "%d extra_byte of point %u of %u are different: %d != %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader2->point.extra_bytes[0]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 2)
         {
-          if (lasreader1->point.gps_time != lasreader2->point.gps_time)
-          {
-            if (different_points < shutup) fprintf(stderr, "gps time of point %u of %u is different: %f != %f\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.gps_time, lasreader2->point.gps_time);
-            difference = true;
-          }
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d != %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1]);
         }
-        if (lasreader1->point.have_rgb || lasreader2->point.have_rgb)
+        else if (lasreader1->point.extra_bytes_number == 3)
         {
-          if (lasreader1->point.have_nir || lasreader2->point.have_nir)
-          {
-            if (memcmp((const void*)&(lasreader1->point.rgb), (const void*)&(lasreader2->point.rgb), sizeof(short[4])))
-            {
-              if (different_points < shutup) fprintf(stderr, "RGBI of point %u of %u is different: (%d %d %d %d) != (%d %d %d %d)\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.rgb[0], lasreader1->point.rgb[1], lasreader1->point.rgb[2], lasreader1->point.rgb[3], lasreader2->point.rgb[0], lasreader2->point.rgb[1], lasreader2->point.rgb[2], lasreader2->point.rgb[3]);
-              difference = true;
-            }
-          }
-          else
-          {
-            if (memcmp((const void*)&(lasreader1->point.rgb), (const void*)&(lasreader2->point.rgb), sizeof(short[3])))
-            {
-              if (different_points < shutup) fprintf(stderr, "RGB of point %u of %u is different: (%d %d %d) != (%d %d %d)\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.rgb[0], lasreader1->point.rgb[1], lasreader1->point.rgb[2], lasreader2->point.rgb[0], lasreader2->point.rgb[1], lasreader2->point.rgb[2]);
-              difference = true;
-            }
-          }
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d != %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2]);
         }
-        if (lasreader1->point.have_wavepacket || lasreader2->point.have_wavepacket)
+        else if (lasreader1->point.extra_bytes_number == 4)
         {
-          if (memcmp((const void*)&(lasreader1->point.wavepacket), (const void*)&(lasreader2->point.wavepacket), sizeof(LASwavepacket)))
-          {
-            if (different_points < shutup) fprintf(stderr, "wavepacket of point %u of %u is different: (%d %d %d %g %g %g %g) != (%d %d %d %g %g %g %g)\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.wavepacket.getIndex(), (I32)lasreader1->point.wavepacket.getOffset(), lasreader1->point.wavepacket.getSize(), lasreader1->point.wavepacket.getLocation(), lasreader1->point.wavepacket.getXt(), lasreader1->point.wavepacket.getYt(), lasreader1->point.wavepacket.getZt(), lasreader2->point.wavepacket.getIndex(), (I32)lasreader2->point.wavepacket.getOffset(), lasreader2->point.wavepacket.getSize(), lasreader2->point.wavepacket.getLocation(), lasreader2->point.wavepacket.getXt(), lasreader2->point.wavepacket.getYt(), lasreader2->point.wavepacket.getZt());
-            difference = true;
-          }
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d != %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3]);
         }
-        if (lasreader1->point.extra_bytes_number)
+        else if (lasreader1->point.extra_bytes_number == 5)
         {
-          if (memcmp((const void*)lasreader1->point.extra_bytes, (const void*)lasreader2->point.extra_bytes, lasreader1->point.extra_bytes_number))
-          {
-            if (different_points < shutup)
-            {
-              if (lasreader1->point.extra_bytes_number == 1)
-              {
-                fprintf(stderr, "%d extra_byte of point %u of %u are different: %d != %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader2->point.extra_bytes[0]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 2)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d != %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 3)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d != %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 4)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d != %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 5)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d != %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 6)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d != %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 7)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d != %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 8)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 9)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 10)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 11)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 12)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 13)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 14)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 15)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 16)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 17)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader1->point.extra_bytes[16], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15], lasreader2->point.extra_bytes[16]);
-              }
-              else
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d ... != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d ...\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader1->point.extra_bytes[16], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15], lasreader2->point.extra_bytes[16]);
-              }
-            }
-            difference = true;
-          }
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d != %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4]);
         }
-        else if (lasreader2->point.extra_bytes_number)
+        else if (lasreader1->point.extra_bytes_number == 6)
         {
-          if (memcmp((const void*)lasreader1->point.extra_bytes, (const void*)lasreader2->point.extra_bytes, lasreader2->point.extra_bytes_number))
-          {
-            if (different_points < shutup)
-            {
-              if (lasreader1->point.extra_bytes_number == 1)
-              {
-                fprintf(stderr, "%d extra_byte of point %u of %u are different: %d != %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader2->point.extra_bytes[0]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 2)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d != %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 3)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d != %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 4)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d != %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 5)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d != %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 6)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d != %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 7)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d != %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6]);
-              }
-              else
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7]);
-              }
-            }
-            difference = true;
-          }
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d != %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5]);
         }
-        if (lasreader1->point.extended_point_type || lasreader2->point.extended_point_type )
+        else if (lasreader1->point.extra_bytes_number == 7)
         {
-          if (lasreader1->point.extended_scan_angle != lasreader2->point.extended_scan_angle)
-          {
-            if (different_points < shutup) fprintf(stderr, "  extended_scan_angle: %d %d (point index %u)\n", lasreader1->point.extended_scan_angle, lasreader2->point.extended_scan_angle, (U32)(lasreader1->p_idx-1));
-            difference = true;
-          }
-          if (lasreader1->point.extended_scanner_channel != lasreader2->point.extended_scanner_channel)
-          {
-            if (different_points < shutup) fprintf(stderr, "  extended_scanner_channel: %d %d\n", lasreader1->point.extended_scanner_channel, lasreader2->point.extended_scanner_channel);
-            difference = true;
-          }
-          if (lasreader1->point.extended_classification_flags != lasreader2->point.extended_classification_flags)
-          {
-            if (different_points < shutup) fprintf(stderr, "  extended_classification_flags: %d %d\n", lasreader1->point.extended_classification_flags, lasreader2->point.extended_classification_flags);
-            difference = true;
-          }
-          if (lasreader1->point.extended_classification != lasreader2->point.extended_classification)
-          {
-            if (different_points < shutup) fprintf(stderr, "  extended_classification: %d %d\n", lasreader1->point.extended_classification, lasreader2->point.extended_classification);
-            difference = true;
-          }
-          if (lasreader1->point.extended_return_number != lasreader2->point.extended_return_number)
-          {
-            if (different_points < shutup) fprintf(stderr, "  extended_return_number: %d %d\n", lasreader1->point.extended_return_number, lasreader2->point.extended_return_number);
-            difference = true;
-          }
-          if (lasreader1->point.extended_number_of_returns != lasreader2->point.extended_number_of_returns)
-          {
-            if (different_points < shutup) fprintf(stderr, "  extended_number_of_returns: %d %d\n", lasreader1->point.extended_number_of_returns, lasreader2->point.extended_number_of_returns);
-            difference = true;
-          }
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d != %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 8)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 9)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8]);
         }
+        else if (lasreader1->point.extra_bytes_number == 10)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 11)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 12)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 13)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 14)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 15)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 16)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 17)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader1->point.extra_bytes[16], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15], lasreader2->point.extra_bytes[16]);
+        }
+        else
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d ... != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d ...\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader1->point.extra_bytes[16], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15], lasreader2->point.extra_bytes[16]);
+        }
+      }
+      difference = true;
+    }
+  }
+  else if (lasreader2->point.extra_bytes_number)
+  {
+    if (memcmp((const void*)lasreader1->point.extra_bytes, (const void*)lasreader2->point.extra_bytes, lasreader2->point.extra_bytes_number))
+    {
+      if (verbose)
+      {
+        if (lasreader1->point.extra_bytes_number == 1)
+        {
+          fprintf(stderr, "%d extra_byte of point %u of %u are different: %d != %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader2->point.extra_bytes[0]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 2)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d != %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 3)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d != %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 4)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d != %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 5)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d != %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 6)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d != %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 7)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d != %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6]);
+        }
+        else
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7]);
+        }
+      }
+      difference = true;
+    }
+  }
+  if (lasreader1->point.extended_point_type || lasreader2->point.extended_point_type )
+  {
+    if (lasreader1->point.extended_scan_angle != lasreader2->point.extended_scan_angle)
+    {
+      if (verbose) fprintf(stderr, "  extended_scan_angle: %d %d (point index %u)\n", lasreader1->point.extended_scan_angle, lasreader2->point.extended_scan_angle, (U32)(lasreader1->p_idx-1));
+      difference = true;
+    }
+    if (lasreader1->point.extended_scanner_channel != lasreader2->point.extended_scanner_channel)
+    {
+      if (verbose) fprintf(stderr, "  extended_scanner_channel: %d %d\n", lasreader1->point.extended_scanner_channel, lasreader2->point.extended_scanner_channel);
+      difference = true;
+    }
+    if (lasreader1->point.extended_classification_flags != lasreader2->point.extended_classification_flags)
+    {
+      if (verbose) fprintf(stderr, "  extended_classification_flags: %d %d\n", lasreader1->point.extended_classification_flags, lasreader2->point.extended_classification_flags);
+      difference = true;
+    }
+    if (lasreader1->point.extended_classification != lasreader2->point.extended_classification)
+    {
+      if (verbose) fprintf(stderr, "  extended_classification: %d %d\n", lasreader1->point.extended_classification, lasreader2->point.extended_classification);
+      difference = true;
+    }
+    if (lasreader1->point.extended_return_number != lasreader2->point.extended_return_number)
+    {
+      if (verbose) fprintf(stderr, "  extended_return_number: %d %d\n", lasreader1->point.extended_return_number, lasreader2->point.extended_return_number);
+      difference = true;
+    }
+    if (lasreader1->point.extended_number_of_returns != lasreader2->point.extended_number_of_returns)
+    {
+      if (verbose) fprintf(stderr, "  extended_number_of_returns: %d %d\n", lasreader1->point.extended_number_of_returns, lasreader2->point.extended_number_of_returns);
+      difference = true;
+    }
+  }
+  return difference;
+};
+
+// with '-threads' the points of large LAS and LAZ files are compared in segments of
+// whole chunks. every thread opens both files once more, seeks to the start of the
+// next unclaimed segment, and compares it quietly. it remembers the indices of the
+// points that could still make it into the report, which is afterwards written in
+// order by re-reading only those points.
+
+#define LASDIFF_SEGMENT_POINTS 1000000
+
+struct LASdiffSegment
+{
+  I64 start;
+  I64 end;
+  I64 checked;            // less than 'end' if one of the files ran out of points
+  int different_points;
+  int different_scaled_offset_coordinates;
+  double max_diff[3];
+  std::vector<I64> events; // points that were different or had different scaled coordinates
+};
+
+static bool can_check_in_segments(const CHAR* file_name, const LASreader* lasreader)
+{
+  if (file_name == 0) return false;
+  if (typeid(*lasreader) != typeid(LASreaderLAS)) return false;
+  if (lasreader->get_filter() || lasreader->get_transform() || lasreader->get_inside()) return false;
+  return true;
+}
+
+// an uncompressed file that was cut short holds fewer points than its header says. those
+// are left for the sequential loop that reports them exactly as without threads.
+
+static I64 stored_points(LASreader* lasreader)
+{
+  if (lasreader->header.laszip || (lasreader->header.point_data_record_length == 0)) return lasreader->npoints;
+  ByteStreamIn* stream = ((LASreaderLAS*)lasreader)->get_stream();
+  I64 position = stream->tell();
+  if (!stream->seekEnd(0)) return 0;
+  I64 size = stream->tell();
+  stream->seek(position);
+  if (size <= (I64)lasreader->header.offset_to_point_data) return 0;
+  return MIN2(lasreader->npoints, (size - (I64)lasreader->header.offset_to_point_data) / lasreader->header.point_data_record_length);
+}
+
+static LASreader* open_for_segments(const CHAR* file_name)
+{
+  LASreadOpener lasreadopener;
+  lasreadopener.set_file_name(file_name);
+  return lasreadopener.open();
+}
+
+static void check_segments(LASreader* lasreader1, LASreader* lasreader2, std::vector<LASdiffSegment>* segments, std::atomic<size_t>* next_segment)
+{
+  size_t s;
+  while ((s = (*next_segment)++) < segments->size())
+  {
+    LASdiffSegment& segment = (*segments)[s];
+    segment.checked = segment.start;
+    if (lasreader1 == 0 || lasreader2 == 0) continue;
+    if (!lasreader1->seek(segment.start) || !lasreader2->seek(segment.start)) continue;
+    while (segment.checked < segment.end)
+    {
+      if (!lasreader1->read_point() || !lasreader2->read_point()) break;
+      int scaled_offset_coordinates_before = segment.different_scaled_offset_coordinates;
+      bool difference = check_point(lasreader1, lasreader2, true, 0, &segment.different_scaled_offset_coordinates, segment.max_diff);
+      bool scaled_offset_changed = (scaled_offset_coordinates_before != segment.different_scaled_offset_coordinates);
+      // a point can only be reported while the count that it adds to is below its limit
+      // in this segment (and then only when earlier segments had few differences)
+      if ((difference && (segment.different_points < shutup)) || (scaled_offset_changed && (scaled_offset_coordinates_before < 9)))
+      {
+        segment.events.push_back(segment.checked);
+      }
+      if (difference) segment.different_points++;
+      segment.checked++;
+    }
+  }
+}
+
+static int check_points(const CHAR* file_name1, LASreader* lasreader1, const CHAR* file_name2, LASreader* lasreader2, LASwriter* laswriter, I32 random_seeks, U32 num_threads)
+{
+  int seeking = random_seeks;
+
+  int different_points = 0;
+  double max_diff[3] = {0.0, 0.0, 0.0};
+
+  different_scaled_offset_coordinates = 0;
+
+  // maybe compare most of the points in segments on several threads
+
+  I64 npoints = 0;
+  if ((num_threads > 1) && (laswriter == 0) && (random_seeks == 0) && can_check_in_segments(file_name1, lasreader1) && can_check_in_segments(file_name2, lasreader2))
+  {
+    npoints = MIN2(stored_points(lasreader1), stored_points(lasreader2));
+  }
+  if (npoints > 2*LASDIFF_SEGMENT_POINTS)
+  {
+    // segments are whole chunks of the first file so that no decompressor starts in the middle of a chunk
+    I64 segment_points = LASDIFF_SEGMENT_POINTS;
+    if (lasreader1->header.laszip && (lasreader1->header.laszip->chunk_size != U32_MAX))
+    {
+      I64 chunk_size = lasreader1->header.laszip->chunk_size;
+      segment_points = MAX2(1, segment_points / chunk_size) * chunk_size;
+    }
+
+    // the very last point is left for the loop below that also detects when one file has more points
+
+    std::vector<LASdiffSegment> segments;
+    for (I64 start = 0; start < npoints - 1; start += segment_points)
+    {
+      LASdiffSegment segment;
+      segment.start = start;
+      segment.end = MIN2(start + segment_points, npoints - 1);
+      segment.checked = start;
+      segment.different_points = 0;
+      segment.different_scaled_offset_coordinates = 0;
+      segment.max_diff[0] = segment.max_diff[1] = segment.max_diff[2] = 0.0;
+      segments.push_back(segment);
+    }
+
+    // every thread reads both files once more. their header warnings were already reported.
+
+    std::vector<LASreader*> lasreaders;
+    LAS_MESSAGE_TYPE message_log_level = get_message_log_level();
+    if (message_log_level < LAS_ERROR) set_message_log_level(LAS_ERROR);
+    for (U32 t = 0; (t < num_threads) && (t < segments.size()); t++)
+    {
+      lasreaders.push_back(open_for_segments(file_name1));
+      lasreaders.push_back(open_for_segments(file_name2));
+    }
+    set_message_log_level(message_log_level);
+
+    std::atomic<size_t> next_segment(0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < lasreaders.size(); t += 2)
+    {
+      threads.push_back(std::thread(check_segments, lasreaders[t], lasreaders[t+1], &segments, &next_segment));
+    }
+    for (size_t t = 0; t < threads.size(); t++)
+    {
+      threads[t].join();
+    }
+    for (size_t t = 0; t < lasreaders.size(); t++)
+    {
+      if (lasreaders[t])
+      {
+        lasreaders[t]->close();
+        delete lasreaders[t];
+      }
+    }
+
+    // report the differences in order by re-reading the points that can still be reported
+
+    I64 resume = 0;
+    for (size_t s = 0; s < segments.size(); s++)
+    {
+      LASdiffSegment& segment = segments[s];
+      int reported_points = 0;
+      int reported_scaled_offset_coordinates = 0;
+      for (size_t e = 0; e < segment.events.size(); e++)
+      {
+        if ((different_points >= shutup) && (!scaled_offset_difference || (different_scaled_offset_coordinates >= 9))) break;
+        lasreader1->seek(segment.events[e]);
+        lasreader2->seek(segment.events[e]);
+        lasreader1->read_point();
+        lasreader2->read_point();
+        int different_scaled_offset_coordinates_before = different_scaled_offset_coordinates;
+        if (check_point(lasreader1, lasreader2, false, different_points, &different_scaled_offset_coordinates, max_diff))
+        {
+          different_points++;
+          if (different_points == shutup) fprintf(stderr, "already %d points are different ... shutting up.\n", shutup);
+          reported_points++;
+        }
+        reported_scaled_offset_coordinates += (different_scaled_offset_coordinates - different_scaled_offset_coordinates_before);
+      }
+      different_points += (segment.different_points - reported_points);
+      different_scaled_offset_coordinates += (segment.different_scaled_offset_coordinates - reported_scaled_offset_coordinates);
+      if (segment.max_diff[0] > max_diff[0]) max_diff[0] = segment.max_diff[0];
+      if (segment.max_diff[1] > max_diff[1]) max_diff[1] = segment.max_diff[1];
+      if (segment.max_diff[2] > max_diff[2]) max_diff[2] = segment.max_diff[2];
+      resume = segment.checked;
+      if (segment.checked < segment.end) break;
+    }
+
+    // continue with the remaining points one by one
+
+    if (lasreader1->p_idx != resume)
+    {
+      lasreader1->seek(resume);
+      lasreader2->seek(resume);
+    }
+  }
+
+  while (true)
+  {
+    bool difference = false;
+    if (seeking)
+    {
+      if (lasreader1->p_idx%100000 == 25000)
+      {
+        I64 s = ((I64)rand()*rand())%lasreader1->npoints;
+        fprintf(stderr, "at p_idx %u seeking to %u\n", (U32)lasreader1->p_idx, (U32)s);
+        lasreader1->seek(s);
+        lasreader2->seek(s);
+        seeking--;
+      }
+    }
+    if (lasreader1->read_point())
+    {
+      if (lasreader2->read_point())
+      {
+        difference = check_point(lasreader1, lasreader2, false, different_points, &different_scaled_offset_coordinates, max_diff);
       }
       else
       {
@@ -828,7 +1029,7 @@ static int check_points(const CHAR* file_name1, LASreader* lasreader1, const CHA
   {
     if (different_scaled_offset_coordinates)
     {
-      fprintf(stderr, "scaled offset points are different (max diff: %g %g %g).\n", max_diff_x, max_diff_y, max_diff_z);
+      fprintf(stderr, "scaled offset points are different (max diff: %g %g %g).\n", max_diff[0], max_diff[1], max_diff[2]);
     }
     else
     {
@@ -860,6 +1061,7 @@ int main(int argc, char *argv[])
   lastool.init(argc, argv, "lasdiff");
   int i;
   int random_seeks = 0;
+  U32 num_threads = 1;
   const CHAR* wildcard1 = 0;
   const CHAR* wildcard2 = 0;
   double start_time = 0.0;
@@ -908,6 +1110,18 @@ int main(int argc, char *argv[])
       wildcard2 = argv[i+2];
       i+=2;
     }
+    else if (strcmp(argv[i],"-threads") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        laserror("'%s' needs 1 argument: number", argv[i]);
+      }
+      if (sscanf_las(argv[i+1], "%u", &num_threads) != 1 || num_threads == 0)
+      {
+        laserror("'%s' needs 1 argument: number but '%s' is no valid number", argv[i], argv[i+1]);
+      }
+      i++;
+    }
     else if (strcmp(argv[i],"-shutup") == 0)
     {
       i++;
@@ -993,7 +1207,7 @@ int main(int argc, char *argv[])
 
       // check points
 
-      int different_points = check_points(file_name1, lasreader1, file_name2, lasreader2, laswriter, random_seeks);
+      int different_points = check_points(file_name1, lasreader1, file_name2, lasreader2, laswriter, random_seeks, num_threads);
 
       // output final verdicts
 
@@ -1112,7 +1326,7 @@ int main(int argc, char *argv[])
 
       // check points
 
-      int different_points = check_points(file_name1, lasreader1, file_name2, lasreader2, laswriter, random_seeks);
+      int different_points = check_points(file_name1, lasreader1, file_name2, lasreader2, laswriter, random_seeks, num_threads);
 
       // output final verdicts
 
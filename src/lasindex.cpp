@@ -88,10 +88,6 @@ static F64 taketime()
 extern int lasindex_gui(int argc, char *argv[], LASreadOpener* lasreadopener);
 #endif
 
-#ifdef COMPILE_WITH_MULTI_CORE
-extern void lasindex_multi_core(int argc, char *argv[], LASreadOpener* lasreadopener, int cores, BOOL cpu64);
-#endif
-
 int main(int argc, char *argv[])
 {
   LasTool_lasindex lastool;
@@ -224,13 +220,9 @@ int main(int argc, char *argv[])
     }
     else
     {
-      lasindex_multi_core(argc, argv, &lasreadopener, lastool.cores, lastool.cpu64);
+      lastool.multi_core(&lasreadopener);
     }
   }
-  if (lastool.cpu64)
-  {
-    lasindex_multi_core(argc, argv, &lasreadopener, 1, TRUE);
-  }
 #endif
 
   // check input
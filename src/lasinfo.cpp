@@ -30,6 +30,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- with '-nmm' decompress only the LAZ layers that are checked or binned
     10 June 2021 -- new option '-delete_empty' for deleting LAS files with zero points
     11 November 2020 -- new option '-set_vlr_record_id 2 4711'
     11 November 2020 -- new option '-set_vlr_user_id 1 "hello martin"'
@@ -189,11 +190,6 @@ static bool valid_resolution(F64 coordinate, F64 offset, F64 scale_factor) {
 extern void lasinfo_gui(int argc, char* argv[], LASreadOpener* lasreadopener);
 #endif
 
-#ifdef COMPILE_WITH_MULTI_CORE
-extern void lasinfo_multi_core(
-    int argc, char* argv[], LASreadOpener* lasreadopener, LAShistogram* lashistogram, LASwriteOpener* laswriteopener, int cores, BOOL cpu64);
-#endif
-
 class LasTool_lasinfo : public LasTool {
  private:
   bool do_scale_header = false;
@@ -752,12 +748,9 @@ class LasTool_lasinfo : public LasTool {
       } else if (lasreadopener.is_merged()) {
         LASMessage(LAS_WARNING, "input files merged on-the-fly. ignoring '-cores %d' ...", cores);
       } else {
-        lasinfo_multi_core(argc, argv, &lasreadopener, &lashistogram, &laswriteopener, cores, cpu64);
+        multi_core(&lasreadopener, &laswriteopener);
       }
     }
-    if (cpu64) {
-      lasinfo_multi_core(argc, argv, &lasreadopener, &lashistogram, &laswriteopener, 1, TRUE);
-    }
 #endif
 
     // check input
@@ -770,6 +763,18 @@ class LasTool_lasinfo : public LasTool {
 
     U32 decompress_selective = LASZIP_DECOMPRESS_SELECTIVE_ALL;
 
+    // without min and max and without reporting the points outside only the layers that are checked or binned are needed
+
+    if (no_min_max && !report_outside) {
+      decompress_selective = LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY;
+      if (check_outside || !no_warnings || repair_bb) {
+        decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_Z;
+      }
+      if (lashistogram.active()) {
+        decompress_selective |= lashistogram.get_decompress_selective();
+      }
+    }
+
     if (suppress_z) {
       decompress_selective &= ~LASZIP_DECOMPRESS_SELECTIVE_Z;
     }
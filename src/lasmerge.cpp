@@ -73,10 +73,6 @@ static double taketime()
 extern int lasmerge_gui(int argc, char *argv[], LASreadOpener* lasreadopener);
 #endif
 
-#ifdef COMPILE_WITH_MULTI_CORE
-extern void lasmerge_multi_core(int argc, char *argv[], GeoProjectionConverter* geoprojectionconverter, LASreadOpener* lasreadopener, LASwriteOpener* laswriteopener, BOOL cpu64);
-#endif
-
 int main(int argc, char *argv[])
 {
   LasTool_lasmerge lastool;
@@ -159,13 +155,6 @@ int main(int argc, char *argv[])
   // read all the input files merged
   lasreadopener.set_merged(TRUE);
 
-#ifdef COMPILE_WITH_MULTI_CORE
-  if (lastool.cpu64)
-  {
-    lasmerge_multi_core(argc, argv, &geoprojectionconverter, &lasreadopener, &laswriteopener, TRUE);
-  }
-#endif
-
   // maybe we want to keep the lastiling
 
   if (keep_lastiling)
@@ -44,6 +44,8 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- '-stream' also reports quantiles and a histogram of the values
+    18 October 2026 -- '-stream' computes the statistics for all points with bounded memory
      1 May 2017 -- 3rd example for selective decompression for new LAS 1.4 points
     30 November 2010 -- created spotting few paper cups at Starbuck's Offenbach
 
@@ -55,6 +57,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <map>
+#include <vector>
+
 #include "lasreader.hpp"
 #include "laszip_decompress_selective_v3.hpp"
 #include "laswriter.hpp"
@@ -139,6 +144,300 @@ static void quicksort_for_doubles(double* a, int i, int j)
   if (i<in_j) quicksort_for_doubles(a, i, in_j);
 }
 
+// with '-stream' the distinct values of an integer attribute are marked in a bitmap
+// that the upper 16 bits of the value split into pages of 65536 bits. a page is only
+// allocated once a value falls into it. the number of values and the marked bits are
+// all that is needed for the exact histogram of the spacing between sorted values.
+// each page also counts the values that fall into its 64 cells of 1024 values. this
+// sketch gives the quantiles and the histogram of the values, which are approximate
+// only where a cell holds several distinct values. a page takes 8.5 KB so that an
+// attribute needs at most 544 MB when its values span the entire 32-bit range.
+
+#define LAS_PRECISION_PAGE_WORDS 1024
+#define LAS_PRECISION_PAGE_CELLS 64
+
+class LASdistinctValues
+{
+public:
+  void add(const I32 value)
+  {
+    U32 key = ((U32)value) ^ 0x80000000;
+    U64* page = pages[key >> 16];
+    if (page == 0)
+    {
+      page = (U64*)calloc(LAS_PRECISION_PAGE_WORDS + LAS_PRECISION_PAGE_CELLS, sizeof(U64));
+      if (page == 0)
+      {
+        laserror("cannot allocate page of distinct values");
+      }
+      pages[key >> 16] = page;
+    }
+    page[(key >> 6) & 1023] |= (((U64)1) << (key & 63));
+    page[LAS_PRECISION_PAGE_WORDS + ((key >> 10) & 63)]++;
+    if (number == 0)
+    {
+      min = max = value;
+    }
+    else if (value < min)
+    {
+      min = value;
+    }
+    else if (value > max)
+    {
+      max = value;
+    }
+    number++;
+  };
+  U64 get_number() const { return number; };
+  I32 get_min() const { return min; };
+  I32 get_max() const { return max; };
+  // calls f(value, count) for the distinct values in sorted order. the count of a cell
+  // is shared evenly by its distinct values so that the counts add up to the number.
+  template <typename F>
+  void for_each_value(F f) const
+  {
+    for (U32 p = 0; p < 65536; p++)
+    {
+      const U64* page = pages[p];
+      if (page == 0) continue;
+      for (U32 c = 0; c < LAS_PRECISION_PAGE_CELLS; c++)
+      {
+        U64 count = page[LAS_PRECISION_PAGE_WORDS + c];
+        if (count == 0) continue;
+        U32 w;
+        U64 word;
+        U64 distinct = 0;
+        for (w = 16*c; w < 16*(c+1); w++)
+        {
+          for (word = page[w]; word; word &= (word - 1)) distinct++;
+        }
+        U64 share = count / distinct;
+        U64 remainder = count % distinct;
+        for (w = 16*c; w < 16*(c+1); w++)
+        {
+          U32 key = (p << 16) | (w << 6);
+          for (word = page[w]; word; word >>= 1, key++)
+          {
+            if ((word & 1) == 0) continue;
+            f((I32)(key ^ 0x80000000), share + (remainder ? 1 : 0));
+            if (remainder) remainder--;
+          }
+        }
+      }
+    }
+  };
+  // the spacing between consecutive values in sorted order (including the zero spacing of duplicates)
+  U64 spacing(std::map<U32,U64>& histogram) const
+  {
+    U64 distinct = 0;
+    U32 last = 0;
+    histogram.clear();
+    for (U32 p = 0; p < 65536; p++)
+    {
+      if (pages[p] == 0) continue;
+      for (U32 w = 0; w < 1024; w++)
+      {
+        U64 word = pages[p][w];
+        U32 key = (p << 16) | (w << 6);
+        while (word)
+        {
+          if ((word & 0xFF) == 0)
+          {
+            word >>= 8;
+            key += 8;
+            continue;
+          }
+          if (word & 1)
+          {
+            if (distinct) histogram[key - last]++;
+            last = key;
+            distinct++;
+          }
+          word >>= 1;
+          key++;
+        }
+      }
+    }
+    if (number > distinct) histogram[0] += (number - distinct);
+    return distinct;
+  };
+  LASdistinctValues()
+  {
+    pages = (U64**)calloc(65536, sizeof(U64*));
+    number = 0;
+    min = 0;
+    max = 0;
+  };
+  ~LASdistinctValues()
+  {
+    for (U32 p = 0; p < 65536; p++)
+    {
+      if (pages[p]) free(pages[p]);
+    }
+    free(pages);
+  };
+private:
+  U64** pages;
+  U64 number;
+  I32 min;
+  I32 max;
+};
+
+// with '-stream' the GPS times are sorted in blocks of '-number' values. the spacing
+// across two blocks is counted when the later block starts after the earlier ended,
+// so the histogram is exact for points stored in time order. the number of distinct
+// spacings is bounded and any further ones are only counted.
+
+#define LAS_PRECISION_MAX_SPACINGS 1000000
+
+class LASspacingBlocks
+{
+public:
+  BOOL init(const U32 size)
+  {
+    values = (F64*)malloc(sizeof(F64)*size);
+    this->size = size;
+    return (values != 0);
+  };
+  void add(const F64 value)
+  {
+    values[count] = value;
+    count++;
+    if (count == size) sort_block();
+  };
+  void sort_block()
+  {
+    if (count == 0) return;
+    quicksort_for_doubles(values, 0, count-1);
+    if (have_last && (values[0] >= last)) tally(values[0] - last);
+    for (U32 i = 1; i < count; i++)
+    {
+      tally(values[i] - values[i-1]);
+    }
+    last = values[count-1];
+    have_last = TRUE;
+    count = 0;
+  };
+  std::map<F64,U64> histogram;
+  U64 untallied;
+  LASspacingBlocks()
+  {
+    values = 0;
+    size = 0;
+    count = 0;
+    have_last = FALSE;
+    last = 0.0;
+    untallied = 0;
+  };
+  ~LASspacingBlocks()
+  {
+    if (values) free(values);
+  };
+private:
+  void tally(const F64 spacing)
+  {
+    std::map<F64,U64>::iterator it = histogram.find(spacing);
+    if (it != histogram.end())
+    {
+      it->second++;
+    }
+    else if (histogram.size() < LAS_PRECISION_MAX_SPACINGS)
+    {
+      histogram[spacing] = 1;
+    }
+    else
+    {
+      untallied++;
+    }
+  };
+  F64* values;
+  U32 size;
+  U32 count;
+  BOOL have_last;
+  F64 last;
+};
+
+static void report_spacing(const CHAR* name, const LASdistinctValues& values, const F64 scale_factor, const bool report_diff, const bool report_diff_diff, const U32 report_lines)
+{
+  std::map<U32,U64> histogram;
+  std::map<U32,U64>::const_iterator it;
+  U64 distinct = values.spacing(histogram);
+  if (report_diff)
+  {
+    fprintf(stdout, "%s differences (%llu distinct of %llu values)\n", name, distinct, values.get_number());
+    U32 count_lines = 0;
+    for (it = histogram.begin(); (it != histogram.end()) && (count_lines < report_lines); it++, count_lines++)
+    {
+      if (scale_factor)
+        fprintf(stdout, " %10u : %10llu   %g\n", it->first, it->second, scale_factor*it->first);
+      else
+        fprintf(stdout, "  %10u : %10llu\n", it->first, it->second);
+    }
+  }
+  if (report_diff_diff)
+  {
+    fprintf(stdout, "%s differences of differences\n", name);
+    std::map<U32,U64> diff_diff;
+    for (it = histogram.begin(); it != histogram.end(); it++)
+    {
+      std::map<U32,U64>::const_iterator next = it;
+      if (++next == histogram.end()) break;
+      diff_diff[next->first - it->first]++;
+    }
+    for (it = diff_diff.begin(); it != diff_diff.end(); it++)
+    {
+      fprintf(stdout, "  %10u : %10llu\n", it->first, it->second);
+    }
+  }
+}
+
+static void report_values(const CHAR* name, const LASdistinctValues& values, const F64 scale_factor, const F64 offset, const U32 report_lines)
+{
+  if (values.get_number() == 0) return;
+  const U32 num_quantiles = 9;
+  const F64 quantiles[num_quantiles] = { 0.0, 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99, 1.0 };
+  U64 ranks[num_quantiles];
+  I32 results[num_quantiles];
+  U32 q;
+  for (q = 0; q < num_quantiles; q++)
+  {
+    ranks[q] = (U64)(quantiles[q]*values.get_number());
+    if (ranks[q] == values.get_number()) ranks[q]--;
+  }
+  // the value range is split into at most 'report_lines' bins of the same width
+  U64 range = (U64)((I64)values.get_max() - (I64)values.get_min()) + 1;
+  U32 num_bins = (report_lines ? report_lines : 1);
+  if (num_bins > range) num_bins = (U32)range;
+  U64 width = (range + num_bins - 1) / num_bins;
+  num_bins = (U32)((range + width - 1) / width);
+  std::vector<U64> bins(num_bins, 0);
+  U64 seen = 0;
+  q = 0;
+  values.for_each_value([&](I32 value, U64 count)
+  {
+    while ((q < num_quantiles) && (ranks[q] < seen + count)) results[q++] = value;
+    seen += count;
+    bins[(U64)((I64)value - (I64)values.get_min()) / width] += count;
+  });
+  fprintf(stdout, "%s value quantiles (min %d max %d)\n", name, values.get_min(), values.get_max());
+  for (q = 0; q < num_quantiles; q++)
+  {
+    if (scale_factor)
+      fprintf(stdout, "  %5.1f%% : %10d   %.10g\n", 100.0*quantiles[q], results[q], scale_factor*results[q] + offset);
+    else
+      fprintf(stdout, "  %5.1f%% : %10d\n", 100.0*quantiles[q], results[q]);
+  }
+  fprintf(stdout, "%s value histogram (bins of %llu)\n", name, width);
+  for (U32 b = 0; b < num_bins; b++)
+  {
+    I32 from = (I32)((I64)values.get_min() + (I64)(b*width));
+    if (scale_factor)
+      fprintf(stdout, "  %10d : %10llu   %.10g\n", from, bins[b], scale_factor*from + offset);
+    else
+      fprintf(stdout, "  %10d : %10llu\n", from, bins[b]);
+  }
+}
+
 class LasTool_lasprecision : public LasTool
 {
 private:
@@ -148,6 +447,7 @@ public:
     fprintf(stderr, "usage:\n");
     fprintf(stderr, "lasprecision -i in.las\n");
     fprintf(stderr, "lasprecision -i in.las -number 1000000\n");
+    fprintf(stderr, "lasprecision -i in.laz -stream -gps\n");
     fprintf(stderr, "lasprecision -i in.las -all -gps -lines 50\n");
     fprintf(stderr, "lasprecision -i in.las -no_x -no_y -no_z -rgb\n");
     fprintf(stderr, "lasprecision -i in.las -diff_diff\n");
@@ -166,10 +466,6 @@ static double taketime()
 extern int lasprecision_gui(int argc, char *argv[], LASreadOpener* lasreadopener);
 #endif
 
-#ifdef COMPILE_WITH_MULTI_CORE
-extern void lasprecision_multi_core(int argc, char* argv[], GeoProjectionConverter* geoprojectionconverter, LASreadOpener* lasreadopener, LASwriteOpener* laswriteopener, int cores, BOOL cpu64);
-#endif
-
 int main(int argc, char *argv[])
 {
   LasTool_lasprecision lastool;
@@ -183,6 +479,7 @@ int main(int argc, char *argv[])
   bool report_gps = false;
   bool report_rgb = false;
   bool output = false;
+  bool stream = false;
   U32 report_lines = 20;
   U32 array_max = 5000000;
   bool projection_was_set = false;
@@ -273,6 +570,10 @@ int main(int argc, char *argv[])
     {
       array_max = U32_MAX;
     }
+    else if (strcmp(argv[i],"-stream") == 0)
+    {
+      stream = true;
+    }
     else if ((argv[i][0] != '-') && (lasreadopener.get_file_name_number() == 0))
     {
       lasreadopener.add_file_name(argv[i]);
@@ -311,7 +612,7 @@ int main(int argc, char *argv[])
     }
     else
     {
-      lasprecision_multi_core(argc, argv, &geoprojectionconverter, &lasreadopener, &laswriteopener, lastool.cores, lastool.cpu64);
+      lastool.multi_core(&lasreadopener, &laswriteopener);
     }
   }
 #endif
@@ -369,9 +670,110 @@ int main(int argc, char *argv[])
       laserror("could not open lasreader");
     }
 
+    // run precision statistics across all points with bounded memory
+
+    if (!output && stream)
+    {
+      fprintf(stdout, "original scale factors: %g %g %g\n", lasreader->header.x_scale_factor, lasreader->header.y_scale_factor, lasreader->header.z_scale_factor);
+
+      bool have_gps = (report_gps && lasreader->point.have_gps_time);
+      bool have_rgb = (report_rgb && lasreader->point.have_rgb);
+
+      LASdistinctValues* values_x = (report_x ? new LASdistinctValues() : 0);
+      LASdistinctValues* values_y = (report_y ? new LASdistinctValues() : 0);
+      LASdistinctValues* values_z = (report_z ? new LASdistinctValues() : 0);
+      LASdistinctValues* values_r = (have_rgb ? new LASdistinctValues() : 0);
+      LASdistinctValues* values_g = (have_rgb ? new LASdistinctValues() : 0);
+      LASdistinctValues* values_b = (have_rgb ? new LASdistinctValues() : 0);
+      LASspacingBlocks* blocks_gps = 0;
+      if (have_gps)
+      {
+        blocks_gps = new LASspacingBlocks();
+        U32 block_size = (array_max == U32_MAX ? 5000000 : array_max);
+        if (!blocks_gps->init(block_size))
+        {
+          laserror("cannot allocate block of %u GPS times", block_size);
+        }
+      }
+
+      LASMessage(LAS_INFO, "streaming all %lld points", lasreader->npoints);
+
+      while (lasreader->read_point())
+      {
+        if (values_x) values_x->add(lasreader->point.get_X());
+        if (values_y) values_y->add(lasreader->point.get_Y());
+        if (values_z) values_z->add(lasreader->point.get_Z());
+        if (blocks_gps) blocks_gps->add(lasreader->point.gps_time);
+        if (have_rgb)
+        {
+          values_r->add(lasreader->point.rgb[0]);
+          values_g->add(lasreader->point.rgb[1]);
+          values_b->add(lasreader->point.rgb[2]);
+        }
+      }
+
+      if (values_x) report_spacing("X", *values_x, lasreader->header.x_scale_factor, report_diff, report_diff_diff, report_lines);
+      if (values_x) report_values("X", *values_x, lasreader->header.x_scale_factor, lasreader->header.x_offset, report_lines);
+      if (values_y) report_spacing("Y", *values_y, lasreader->header.y_scale_factor, report_diff, report_diff_diff, report_lines);
+      if (values_y) report_values("Y", *values_y, lasreader->header.y_scale_factor, lasreader->header.y_offset, report_lines);
+      if (values_z) report_spacing("Z", *values_z, lasreader->header.z_scale_factor, report_diff, report_diff_diff, report_lines);
+      if (values_z) report_values("Z", *values_z, lasreader->header.z_scale_factor, lasreader->header.z_offset, report_lines);
+
+      if (blocks_gps)
+      {
+        blocks_gps->sort_block();
+        std::map<F64,U64>::const_iterator it;
+        if (report_diff)
+        {
+          fprintf(stdout, "GPS time differences \n");
+          for (it = blocks_gps->histogram.begin(); it != blocks_gps->histogram.end(); it++)
+          {
+            fprintf(stdout, "  %.10g : %10llu\n", it->first, it->second);
+          }
+        }
+        if (report_diff_diff)
+        {
+          fprintf(stdout, "GPS time  differences of differences\n");
+          std::map<F64,U64> diff_diff;
+          for (it = blocks_gps->histogram.begin(); it != blocks_gps->histogram.end(); it++)
+          {
+            std::map<F64,U64>::const_iterator next = it;
+            if (++next == blocks_gps->histogram.end()) break;
+            diff_diff[next->first - it->first]++;
+          }
+          for (it = diff_diff.begin(); it != diff_diff.end(); it++)
+          {
+            fprintf(stdout, "  %.10g : %10llu\n", it->first, it->second);
+          }
+        }
+        if (blocks_gps->untallied)
+        {
+          LASMessage(LAS_WARNING, "%llu GPS time differences beyond the first %u distinct ones were not tallied", blocks_gps->untallied, LAS_PRECISION_MAX_SPACINGS);
+        }
+      }
+
+      if (have_rgb)
+      {
+        report_spacing("R", *values_r, 0.0, report_diff, report_diff_diff, U32_MAX);
+        report_values("R", *values_r, 0.0, 0.0, report_lines);
+        report_spacing("G", *values_g, 0.0, report_diff, report_diff_diff, U32_MAX);
+        report_values("G", *values_g, 0.0, 0.0, report_lines);
+        report_spacing("B", *values_b, 0.0, report_diff, report_diff_diff, U32_MAX);
+        report_values("B", *values_b, 0.0, 0.0, report_lines);
+      }
+
+      if (values_x) delete values_x;
+      if (values_y) delete values_y;
+      if (values_z) delete values_z;
+      if (values_r) delete values_r;
+      if (values_g) delete values_g;
+      if (values_b) delete values_b;
+      if (blocks_gps) delete blocks_gps;
+    }
+
     // run presicion statistics across the first array_max points
 
-    if (!output)
+    else if (!output)
     {
       fprintf(stdout, "original scale factors: %g %g %g\n", lasreader->header.x_scale_factor, lasreader->header.y_scale_factor, lasreader->header.z_scale_factor);
 
@@ -0,0 +1,364 @@
+/*
+===============================================================================
+
+  FILE:  lastool.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2009-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+#include "lastool.hpp"
+
+#ifdef COMPILE_WITH_MULTI_CORE
+
+#include "lasreader.hpp"
+#include "laswriter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <errno.h>
+#include <mutex>
+#include <thread>
+
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+// one input file that is processed by its own worker process
+struct LASmultiCoreJob
+{
+    U32 index;
+    I64 size;
+    int exit_code;
+};
+
+// serializes creating the pipes and starting the workers so that no worker inherits
+// the pipe of another one (which would keep that pipe open until both have finished)
+static std::mutex multi_core_spawn_mutex;
+// keeps the messages of different workers from being interleaved
+static std::mutex multi_core_output_mutex;
+
+static I64 multi_core_file_size(const char* file_name)
+{
+#ifdef _WIN32
+    struct _stat64 file_stat;
+    if (_stat64(file_name, &file_stat) != 0) return 0;
+#else
+    struct stat file_stat;
+    if (stat(file_name, &file_stat) != 0) return 0;
+#endif
+    return (I64)file_stat.st_size;
+}
+
+#ifdef _WIN32
+
+// quotes an argument for the command line of CreateProcess() the way the runtime splits it again
+static void multi_core_append_quoted(std::string& command_line, const std::string& arg)
+{
+    if (!command_line.empty()) command_line += ' ';
+    if (!arg.empty() && (arg.find_first_of(" \t\"") == std::string::npos))
+    {
+        command_line += arg;
+        return;
+    }
+    command_line += '"';
+    size_t backslashes = 0;
+    for (size_t i = 0; i < arg.size(); i++)
+    {
+        if (arg[i] == '\\')
+        {
+            backslashes++;
+            continue;
+        }
+        if (arg[i] == '"')
+        {
+            command_line.append(2 * backslashes + 1, '\\');
+        }
+        else
+        {
+            command_line.append(backslashes, '\\');
+        }
+        backslashes = 0;
+        command_line += arg[i];
+    }
+    command_line.append(2 * backslashes, '\\');
+    command_line += '"';
+}
+
+// runs the worker, collects what it writes to stderr, and returns its exit code
+static int multi_core_run(const std::string& executable, const std::vector<std::string>& args, std::string& messages)
+{
+    std::string command_line;
+    multi_core_append_quoted(command_line, executable);
+    for (size_t i = 0; i < args.size(); i++)
+    {
+        multi_core_append_quoted(command_line, args[i]);
+    }
+    HANDLE pipe_read = NULL;
+    HANDLE pipe_write = NULL;
+    PROCESS_INFORMATION process;
+    {
+        std::lock_guard<std::mutex> lock(multi_core_spawn_mutex);
+        SECURITY_ATTRIBUTES security;
+        security.nLength = sizeof(SECURITY_ATTRIBUTES);
+        security.bInheritHandle = TRUE;
+        security.lpSecurityDescriptor = NULL;
+        if (!CreatePipe(&pipe_read, &pipe_write, &security, 0)) return -1;
+        SetHandleInformation(pipe_read, HANDLE_FLAG_INHERIT, 0);
+        STARTUPINFOA startup;
+        ZeroMemory(&startup, sizeof(startup));
+        startup.cb = sizeof(startup);
+        startup.dwFlags = STARTF_USESTDHANDLES;
+        startup.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+        startup.hStdOutput = GetStdHandle(STD_OUTPUT_HANDLE);
+        startup.hStdError = pipe_write;
+        ZeroMemory(&process, sizeof(process));
+        BOOL created = CreateProcessA(NULL, &command_line[0], NULL, NULL, TRUE, 0, NULL, NULL, &startup, &process);
+        CloseHandle(pipe_write);
+        if (!created)
+        {
+            CloseHandle(pipe_read);
+            return -1;
+        }
+    }
+    char buffer[4096];
+    DWORD bytes;
+    while (ReadFile(pipe_read, buffer, sizeof(buffer), &bytes, NULL) && (bytes > 0))
+    {
+        messages.append(buffer, bytes);
+    }
+    CloseHandle(pipe_read);
+    WaitForSingleObject(process.hProcess, INFINITE);
+    DWORD exit_code = (DWORD)-1;
+    GetExitCodeProcess(process.hProcess, &exit_code);
+    CloseHandle(process.hProcess);
+    CloseHandle(process.hThread);
+    return (int)exit_code;
+}
+
+static std::string multi_core_executable(const char* argv0)
+{
+    char path[MAX_PATH];
+    DWORD length = GetModuleFileNameA(NULL, path, MAX_PATH);
+    if ((length > 0) && (length < MAX_PATH)) return std::string(path, length);
+    return std::string(argv0);
+}
+
+#else
+
+// runs the worker, collects what it writes to stderr, and returns its exit code
+static int multi_core_run(const std::string& executable, const std::vector<std::string>& args, std::string& messages)
+{
+    std::vector<char*> spawn_argv;
+    spawn_argv.push_back((char*)executable.c_str());
+    for (size_t i = 0; i < args.size(); i++)
+    {
+        spawn_argv.push_back((char*)args[i].c_str());
+    }
+    spawn_argv.push_back(0);
+    int pipe_fds[2];
+    pid_t pid;
+    {
+        std::lock_guard<std::mutex> lock(multi_core_spawn_mutex);
+        if (pipe(pipe_fds) != 0) return -1;
+        fcntl(pipe_fds[0], F_SETFD, FD_CLOEXEC);
+        fcntl(pipe_fds[1], F_SETFD, FD_CLOEXEC);
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, pipe_fds[1], 2);
+        int error;
+        if (executable.find('/') != std::string::npos)
+            error = posix_spawn(&pid, executable.c_str(), &actions, 0, spawn_argv.data(), environ);
+        else
+            error = posix_spawnp(&pid, executable.c_str(), &actions, 0, spawn_argv.data(), environ);
+        posix_spawn_file_actions_destroy(&actions);
+        close(pipe_fds[1]);
+        if (error != 0)
+        {
+            close(pipe_fds[0]);
+            return -1;
+        }
+    }
+    char buffer[4096];
+    ssize_t bytes;
+    while (((bytes = read(pipe_fds[0], buffer, sizeof(buffer))) > 0) || ((bytes < 0) && (errno == EINTR)))
+    {
+        if (bytes > 0) messages.append(buffer, (size_t)bytes);
+    }
+    close(pipe_fds[0]);
+    int status;
+    while (waitpid(pid, &status, 0) < 0)
+    {
+        if (errno != EINTR) return -1;
+    }
+    if (WIFEXITED(status)) return WEXITSTATUS(status);
+    return -1;
+}
+
+static std::string multi_core_executable(const char* argv0)
+{
+#ifdef __linux__
+    char path[4096];
+    ssize_t length = readlink("/proc/self/exe", path, sizeof(path));
+    if ((length > 0) && (length < (ssize_t)sizeof(path))) return std::string(path, (size_t)length);
+#endif
+    return std::string(argv0);
+}
+
+#endif
+
+void LasTool::multi_core(LASreadOpener* lasreadopener, const LASwriteOpener* laswriteopener)
+{
+    // only independent input files can be processed by independent workers
+    if (laswriteopener && laswriteopener->is_piped())
+    {
+        LASMessage(LAS_WARNING, "output piped. ignoring '-cores %d' ...", cores);
+        return;
+    }
+    if (laswriteopener && laswriteopener->get_file_name())
+    {
+        LASMessage(LAS_WARNING, "single output file '%s'. use '-odir' or '-odix' instead. ignoring '-cores %d' ...", laswriteopener->get_file_name(), cores);
+        return;
+    }
+    if (lasreadopener->are_files_flightlines())
+    {
+        LASMessage(LAS_WARNING, "files are numbered as flightlines. ignoring '-cores %d' ...", cores);
+        return;
+    }
+
+    U32 number = lasreadopener->get_file_name_number();
+
+    // the command line for the workers is the original one without the input files and without '-cores'
+    std::vector<std::string> worker_args;
+    for (size_t i = 1; i < args.size(); i++)
+    {
+        if ((args[i] == "-cores") || (args[i] == "-lof"))
+        {
+            i++;
+        }
+        else if (args[i] == "-i")
+        {
+            while (((i + 1) < args.size()) && (args[i + 1][0] != '-') && (args[i + 1][0] != '\0')) i++;
+        }
+        else if (args[i] == "-cpu64")
+        {
+        }
+        else
+        {
+            // a file name given without '-i'
+            U32 f = number;
+            if (args[i][0] != '-')
+            {
+                for (f = 0; f < number; f++)
+                {
+                    if (args[i] == lasreadopener->get_file_name(f)) break;
+                }
+            }
+            if (f == number) worker_args.push_back(args[i]);
+        }
+    }
+    worker_args.push_back("-i");
+    worker_args.push_back("");
+
+    // the largest files start first so that no worker is left with a big file at the end
+    std::vector<LASmultiCoreJob> jobs(number);
+    for (U32 f = 0; f < number; f++)
+    {
+        jobs[f].index = f;
+        jobs[f].size = multi_core_file_size(lasreadopener->get_file_name(f));
+        jobs[f].exit_code = 0;
+    }
+    std::stable_sort(jobs.begin(), jobs.end(), [](const LASmultiCoreJob& a, const LASmultiCoreJob& b) { return a.size > b.size; });
+
+    std::string executable = multi_core_executable(args[0].c_str());
+    U32 num_workers = MIN2((U32)cores, number);
+    LASMessage(LAS_VERBOSE, "processing %u files with %u workers of '%s' ...", number, num_workers, executable.c_str());
+
+    std::atomic<U32> next_job(0);
+    std::vector<std::thread> workers;
+    for (U32 w = 0; w < num_workers; w++)
+    {
+        workers.push_back(std::thread([&]() {
+            std::vector<std::string> job_args = worker_args;
+            U32 j;
+            while ((j = next_job++) < number)
+            {
+                const char* file_name = lasreadopener->get_file_name(jobs[j].index);
+                job_args.back() = file_name;
+                std::string messages;
+                jobs[j].exit_code = multi_core_run(executable, job_args, messages);
+                std::lock_guard<std::mutex> lock(multi_core_output_mutex);
+                if (!messages.empty())
+                {
+                    fwrite(messages.data(), 1, messages.size(), stderr);
+                    fflush(stderr);
+                }
+                LASMessage(LAS_VERBOSE, "file '%s' done with exit code %d", file_name, jobs[j].exit_code);
+            }
+        }));
+    }
+    for (U32 w = 0; w < num_workers; w++)
+    {
+        workers[w].join();
+    }
+
+    // report the files whose workers failed and exit like the worst of them did
+    U32 failed = 0;
+    int worst = 0;
+    for (U32 j = 0; j < number; j++)
+    {
+        if ((jobs[j].exit_code < 0) || (jobs[j].exit_code > 2))
+        {
+            LASMessage(LAS_ERROR, "processing '%s' failed with exit code %d", lasreadopener->get_file_name(jobs[j].index), jobs[j].exit_code);
+            failed++;
+        }
+        else if (jobs[j].exit_code > worst)
+        {
+            worst = jobs[j].exit_code;
+        }
+    }
+    if (failed)
+    {
+        LASMessage(LAS_ERROR, "%u of %u files failed", failed, number);
+    }
+    else if (worst == 2)
+    {
+        LASMessage(LAS_SERIOUS_WARNING, "some of the %u files had serious warnings", number);
+    }
+    else if (worst == 1)
+    {
+        LASMessage(LAS_WARNING, "some of the %u files had warnings", number);
+    }
+    else
+    {
+        LASMessage(LAS_VERBOSE, "all %u files done", number);
+    }
+    byebye();
+}
+
+#endif
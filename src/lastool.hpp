@@ -20,6 +20,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 - multi_core() runs one worker process per input file for '-cores'
     01 Mai 2024 - initial
 
 ===============================================================================
@@ -34,6 +35,12 @@
 #include <cstdio>
 #include <cstring>
 #include <string>
+#ifdef COMPILE_WITH_MULTI_CORE
+#include <vector>
+
+class LASreadOpener;
+class LASwriteOpener;
+#endif
 
 class LasTool
 {
@@ -52,6 +59,8 @@ class LasTool
 #ifdef COMPILE_WITH_MULTI_CORE
     I32 cores = 1;
     BOOL cpu64 = FALSE;
+    // the command line before parsing blanks out the arguments it has used
+    std::vector<std::string> args;
 #endif
     std::string name;
     void init(int argc, char** argv, std::string name)
@@ -59,8 +68,21 @@ class LasTool
         this->argc = argc;
         this->argv = argv;
         this->name = name;
+#ifdef COMPILE_WITH_MULTI_CORE
+        args.assign(argv, argv + argc);
+#endif
     }
 
+#ifdef COMPILE_WITH_MULTI_CORE
+    /// <summary>
+    /// runs this tool once for every input file with up to 'cores' worker processes at a time.
+    /// the workers get the original command line with their input file instead of all input
+    /// files and the largest files are started first. exits afterwards unless the files cannot
+    /// be processed independently.
+    /// </summary>
+    void multi_core(LASreadOpener* lasreadopener, const LASwriteOpener* laswriteopener = 0);
+#endif
+
     virtual std::string sBlast()
     {
         return (blast ? " BLAST" : "");
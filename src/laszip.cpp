@@ -111,10 +111,6 @@ static double taketime()
 extern int laszip_gui(int argc, char *argv[], LASreadOpener* lasreadopener);
 #endif
 
-#ifdef COMPILE_WITH_MULTI_CORE
-extern void laszip_multi_core(int argc, char *argv[], GeoProjectionConverter* geoprojectionconverter, LASreadOpener* lasreadopener, LASwriteOpener* laswriteopener, int cores, BOOL cpu64);
-#endif
-
 int main(int argc, char *argv[])
 {
   LasTool_laszip lastool;
@@ -300,13 +296,9 @@ int main(int argc, char *argv[])
     }
     else
     {
-      laszip_multi_core(argc, argv, &geoprojectionconverter, &lasreadopener, &laswriteopener, lastool.cores, lastool.cpu64);
+      lastool.multi_core(&lasreadopener, &laswriteopener);
     }
   }
-  if (lastool.cpu64)
-  {
-    laszip_multi_core(argc, argv, &geoprojectionconverter, &lasreadopener, &laswriteopener, 1, TRUE);
-  }
 #endif
 
   // check input
@@ -31,6 +31,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- '-cores 4' parses a single input on 4 threads
     21 November 2017 -- allow adding up to 32 (from 10) additional attributes
      7 April 2017 -- new option to '-set_point_type 6' for new LAS 1.4 point types
     17 January 2016 -- pre-scaling and pre-offsetting of "extra bytes" attributes
@@ -87,6 +88,7 @@ public:
     fprintf(stderr, "txt2las -skip 5 -parse xyz -i lidar.rar -set_file_creation 28 2011 -o lidar.las\n");
     fprintf(stderr, "txt2las -parse xyzsst -verbose -set_scale 0.001 0.001 0.001 -i lidar.txt\n");
     fprintf(stderr, "txt2las -parse xsysz -set_scale 0.1 0.1 0.01 -i lidar.txt.gz -sp83 OH_N -feet\n");
+    fprintf(stderr, "txt2las -parse xyzi -i huge_scan.pts -ipts -ithreads 8 -o huge_scan.laz\n");
     fprintf(stderr, "las2las -parse tsxyzRGB -i lidar.txt -set_version 1.2 -scale_intensity 65535 -o lidar.las\n");
     fprintf(stderr, "txt2las -h\n");
     fprintf(stderr, "---------------------------------------------\n");
@@ -135,10 +137,6 @@ extern "C" FILE * fopen_compressed(const char* filename, const char* mode, bool*
 extern int txt2las_gui(int argc, char* argv[], LASreadOpener* lasreadopener);
 #endif
 
-#ifdef COMPILE_WITH_MULTI_CORE
-extern void txt2las_multi_core(int argc, char* argv[], GeoProjectionConverter* geoprojectionconverter, LASreadOpener* lasreadopener, LASwriteOpener* laswriteopener, I32 cores, BOOL cpu64);
-#endif
-
 int main(int argc, char* argv[])
 {
   LasTool_txt2las lastool;
@@ -471,13 +469,11 @@ int main(int argc, char* argv[])
 #ifdef COMPILE_WITH_MULTI_CORE
   if (lastool.cores > 1)
   {
-    if (lasreadopener.get_use_stdin())
+    if (lasreadopener.get_use_stdin() || (lasreadopener.get_file_name_number() < 2))
     {
-      LASMessage(LAS_WARNING, "using stdin. ignoring '-cores %d' ...", lastool.cores);
-    }
-    else if (lasreadopener.get_file_name_number() < 2)
-    {
-      LASMessage(LAS_WARNING, "only %u input files. ignoring '-cores %d' ...", lasreadopener.get_file_name_number(), lastool.cores);
+      // parse the lines of the single input on multiple threads instead
+      LASMessage(LAS_VERBOSE, "only one input. parsing it with '-ithreads %d' ...", lastool.cores);
+      lasreadopener.set_decompress_threads(lastool.cores);
     }
     else if (lasreadopener.is_merged())
     {
@@ -485,13 +481,9 @@ int main(int argc, char* argv[])
     }
     else
     {
-      txt2las_multi_core(argc, argv, &geoprojectionconverter, &lasreadopener, &laswriteopener, lastool.cores, lastool.cpu64);
+      lastool.multi_core(&lasreadopener, &laswriteopener);
     }
   }
-  if (lastool.cpu64)
-  {
-    txt2las_multi_core(argc, argv, &geoprojectionconverter, &lasreadopener, &laswriteopener, 1, TRUE);
-  }
 #endif
 
   // make sure we have input